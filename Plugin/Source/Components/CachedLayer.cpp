@@ -0,0 +1,30 @@
+#include "CachedLayer.h"
+
+namespace
+{
+    bool cachingEnabled = true;
+}
+
+void CachedLayer::setCachingEnabled(bool shouldCache)
+{
+    cachingEnabled = shouldCache;
+}
+
+bool CachedLayer::isCachingEnabled()
+{
+    return cachingEnabled;
+}
+
+juce::Image& CachedLayer::prepare(juce::Rectangle<int> area, float scale, juce::int64 key)
+{
+    const int w = juce::jmax(1, juce::roundToInt(static_cast<float>(area.getWidth()) * scale));
+    const int h = juce::jmax(1, juce::roundToInt(static_cast<float>(area.getHeight()) * scale));
+    if (image_.isValid() && image_.getWidth() == w && image_.getHeight() == h)
+        image_.clear(image_.getBounds());   // same pixel size (key change): reuse the allocation
+    else
+        image_ = juce::Image(juce::Image::ARGB, w, h, true);
+    area_ = area;
+    scale_ = scale;
+    key_ = key;
+    return image_;
+}
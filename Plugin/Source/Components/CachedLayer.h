@@ -0,0 +1,52 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/** Static artwork (panels, gradients, outlines, grids, labels) rendered once into an image and blitted on every
+ *  paint. The image is rebuilt only when the layer's area, the display scale (DPI change) or the caller's key changes;
+ *  owners also call invalidate() on look-and-feel changes. Dynamic content (meters, needles, waveforms) is painted
+ *  on top by the owner as before.
+ *
+ *  Message thread only. setCachingEnabled(false) renders straight into the component every paint instead, so the
+ *  paint-time overlay can compare cached against uncached drawing in the same session. */
+class CachedLayer
+{
+public:
+    /** Draw the layer covering area (component coordinates). render(g) paints in the same component coordinates;
+     *  it runs only when the cached image is missing or stale. key: anything else the artwork depends on
+     *  (a mode, a quantised parameter); same key and geometry means the cached pixels are reused. */
+    template <typename RenderFn>
+    void draw(juce::Graphics& g, juce::Rectangle<int> area, juce::int64 key, RenderFn&& render)
+    {
+        if (area.isEmpty())
+            return;
+        if (!isCachingEnabled())
+        {
+            image_ = {};
+            render(g);
+            return;
+        }
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (!image_.isValid() || area != area_ || scale != scale_ || key != key_)
+        {
+            juce::Graphics ig(prepare(area, scale, key));
+            ig.addTransform(juce::AffineTransform::translation(static_cast<float>(-area.getX()), static_cast<float>(-area.getY()))
+                                .scaled(scale));
+            render(ig);
+        }
+        g.drawImage(image_, area.toFloat());
+    }
+
+    void invalidate() { image_ = {}; }
+
+    static void setCachingEnabled(bool shouldCache);
+    static bool isCachingEnabled();
+
+private:
+    juce::Image& prepare(juce::Rectangle<int> area, float scale, juce::int64 key);
+
+    juce::Image image_;
+    juce::Rectangle<int> area_;
+    float scale_ = 0.0f;
+    juce::int64 key_ = 0;
+};
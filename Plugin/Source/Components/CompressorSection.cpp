@@ -1,19 +1,31 @@
 #include "CompressorSection.h"
 #include "../PluginProcessor.h"
+#include "PaintProfiler.h"
 
 //==============================================================================
-CompressorSection::GainReductionMeterComponent::GainReductionMeterComponent(OmbicCompressorProcessor& p)
-    : processor(p) {}
+CompressorSection::GainReductionMeterComponent::GainReductionMeterComponent(OmbicCompressorProcessor&) {}
 
-void CompressorSection::GainReductionMeterComponent::paint(juce::Graphics& g)
+void CompressorSection::GainReductionMeterComponent::tick(float grDb)
 {
-    float grDb = processor.gainReductionDb.load();
     if (grDb > smoothedGrDb_)
         smoothedGrDb_ += kGrAttackCoeff * (grDb - smoothedGrDb_);
     else
         smoothedGrDb_ += kGrReleaseCoeff * (grDb - smoothedGrDb_);
     if (smoothedGrDb_ > grHoldDb_) { grHoldDb_ = smoothedGrDb_; grHoldTicks_ = kGrHoldTicks; }
     else { if (grHoldTicks_ > 0) --grHoldTicks_; if (grHoldTicks_ <= 0) grHoldDb_ += kGrReleaseCoeff * (smoothedGrDb_ - grHoldDb_); }
+    if (isShowing()
+        && (RenderScheduler::exceeds(smoothedGrDb_, paintedGrDb_, RenderScheduler::kMeterThresholdDb)
+            || RenderScheduler::exceeds(grHoldDb_, paintedHoldDb_, RenderScheduler::kMeterThresholdDb)))
+    {
+        paintedGrDb_ = smoothedGrDb_;
+        paintedHoldDb_ = grHoldDb_;
+        repaint();
+    }
+}
+
+void CompressorSection::GainReductionMeterComponent::paint(juce::Graphics& g)
+{
+    OMBIC_PAINT_SCOPE(*this);
     const float grFullScaleDb = 40.0f;
     float norm = juce::jlimit(0.0f, 1.0f, smoothedGrDb_ / grFullScaleDb);
     auto fullBounds = getLocalBounds().toFloat();
@@ -101,6 +113,26 @@ CompressorSection::CompressorSection(OmbicCompressorProcessor& processor)
     };
     addAndMakeVisible(compressLimitToggle_);
 
+    curveProfileCombo_.setTooltip("Measured unit this engine plays. Switching crossfades over 50 ms; saved with the session.");
+    curveProfileCombo_.onChange = [this]() {
+        const int index = curveProfileCombo_.getSelectedId() - 1;
+        if (juce::isPositiveAndBelow(index, static_cast<int>(curveProfileIds_.size())))
+            proc.selectCurveProfile(curveProfileIds_[static_cast<size_t>(index)]);  // on failure the next update shows the active one again
+    };
+    addChildComponent(curveProfileCombo_);
+
+    morphPartnerCombo_.setTextWhenNothingSelected("Morph to...");
+    morphPartnerCombo_.setTooltip("Profile the MORPH knob blends this engine towards. Saved with the session.");
+    morphPartnerCombo_.onChange = [this]() {
+        const int index = morphPartnerCombo_.getSelectedId() - 1;
+        if (!juce::isPositiveAndBelow(index, static_cast<int>(morphPartnerIds_.size())))
+            return;
+        using Mode = emulation::MVPChain::Mode;
+        const Mode engine = (curveProfileMode_ == 1) ? Mode::FET : (curveProfileMode_ == 3) ? Mode::VCA : Mode::Opto;
+        proc.selectMorphProfile(engine, morphPartnerIds_[static_cast<size_t>(index)]);
+    };
+    addChildComponent(morphPartnerCombo_);
+
     const juce::BorderSize<int> labelPadding(4, 0, 0, 0);
     const juce::Colour textCol = OmbicLookAndFeel::pluginText();
     const juce::Colour labelCol = OmbicLookAndFeel::pluginMuted();
@@ -185,6 +217,21 @@ CompressorSection::CompressorSection(OmbicCompressorProcessor& processor)
     speedLabel.setFont(labelFont);
     addAndMakeVisible(speedLabel);
 
+    characterSlider.setName("compressor");
+    characterSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+    characterSlider.setRotaryParameters(juce::Slider::RotaryParameters{ -2.356f, 2.356f, true });
+    characterSlider.setColour(juce::Slider::rotarySliderFillColourId, OmbicLookAndFeel::ombicBlue());
+    characterSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 52, 18);
+    characterSlider.setColour(juce::Slider::textBoxTextColourId, textCol);
+    characterSlider.setVelocityBasedMode(false);
+    characterSlider.setTooltip("Character: blends this engine's measured curves towards the partner profile (0 = own curves).");
+    addChildComponent(characterSlider);
+    characterLabel.setText("MORPH", juce::dontSendNotification);
+    characterLabel.setBorderSize(labelPadding);
+    characterLabel.setColour(juce::Label::textColourId, labelCol);
+    characterLabel.setFont(labelFont);
+    addChildComponent(characterLabel);
+
     addAndMakeVisible(grMeter);
     grReadoutLabel.setText("0.0 dB", juce::dontSendNotification);
     grReadoutLabel.setTooltip("Gain reduction in dB (bar above). Colour: teal <3 dB, yellow 3–6 dB, red >6 dB. Fast response and hold.");
@@ -198,9 +245,10 @@ CompressorSection::~CompressorSection()
     setLookAndFeel(nullptr);
 }
 
-void CompressorSection::updateGrReadout()
+void CompressorSection::renderTick(const RenderScheduler::Frame& frame)
 {
-    float grDb = proc.gainReductionDb.load();
+    const float grDb = frame.meters[emulation::MeterBus::GainReduction];
+    grMeter.tick(grDb);
     if (grDb > smoothedGrDb_)
         smoothedGrDb_ += kGrAttackCoeff * (grDb - smoothedGrDb_);
     else
@@ -232,6 +280,8 @@ void CompressorSection::setModeControlsVisible(int mode)
     releaseLabel.setVisible(isFet);
     speedSlider.setVisible(isPwm);
     speedLabel.setVisible(isPwm);
+    characterSlider.setVisible(!isPwm && characterAvailable_);
+    characterLabel.setVisible(!isPwm && characterAvailable_);
     compressLimitToggle_.setVisible(isOpto);
     fetCharacterLabel.setVisible(isFet);
     fetCharacterCombo.setVisible(false);  // kept for attachment; UI uses pills in FET mode
@@ -273,9 +323,62 @@ void CompressorSection::updateFetCharacterPillStates()
     fetCharacterPillLN_.setToggleState(index == 2, juce::dontSendNotification);
 }
 
+void CompressorSection::updateCurveProfileControls()
+{
+    int modeIndex = 0;
+    if (auto* raw = proc.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramCompressorMode))
+        modeIndex = juce::jlimit(0, 3, static_cast<int>(raw->load() * 3.0f + 0.5f));
+    // The lists take the processor's chain lock (held through curve loading), so only read them when something changed
+    const int serial = proc.getProfileSelectionSerial();
+    if (modeIndex == curveProfileMode_ && serial == curveProfileSerial_)
+        return;
+    if (curveProfileCombo_.isPopupActive() || morphPartnerCombo_.isPopupActive())
+        return;  // try again once the menu is closed
+    curveProfileMode_ = modeIndex;
+    curveProfileSerial_ = serial;
+    curveProfileIds_.clear();
+    morphPartnerIds_.clear();
+    curveProfileCombo_.clear(juce::dontSendNotification);
+    morphPartnerCombo_.clear(juce::dontSendNotification);
+
+    const bool hadCharacter = characterAvailable_;
+    characterAvailable_ = false;
+    if (modeIndex != 2)  // PWM has no selectable profile
+    {
+        using Mode = emulation::MVPChain::Mode;
+        const Mode engine = (modeIndex == 1) ? Mode::FET : (modeIndex == 3) ? Mode::VCA : Mode::Opto;
+        const auto active = proc.getActiveCurveProfile(engine);
+        const auto partner = proc.getMorphProfile(engine);
+        for (const auto& profile : proc.getCurveProfiles())
+        {
+            if (profile.mode == engine)
+            {
+                curveProfileIds_.push_back(profile.id);
+                curveProfileCombo_.addItem(profile.name, static_cast<int>(curveProfileIds_.size()));
+                if (profile.id == active)
+                    curveProfileCombo_.setSelectedId(static_cast<int>(curveProfileIds_.size()), juce::dontSendNotification);
+            }
+            if (profile.id != active)   // any engine's unit can be a partner; the morph reads it in its own units
+            {
+                morphPartnerIds_.push_back(profile.id);
+                morphPartnerCombo_.addItem(profile.name, static_cast<int>(morphPartnerIds_.size()));
+                if (profile.id == partner)
+                    morphPartnerCombo_.setSelectedId(static_cast<int>(morphPartnerIds_.size()), juce::dontSendNotification);
+            }
+        }
+        characterAvailable_ = partner.isNotEmpty();
+    }
+    curveProfileCombo_.setVisible(!curveProfileIds_.empty());
+    morphPartnerCombo_.setVisible(!morphPartnerIds_.empty());
+    if (characterAvailable_ != hadCharacter)
+        resized();  // show or hide the MORPH knob
+}
+
 bool CompressorSection::isInteracting() const
 {
     return modeCombo.isMouseButtonDown() || compressLimitCombo.isMouseButtonDown()
+        || curveProfileCombo_.isMouseButtonDown() || morphPartnerCombo_.isMouseButtonDown()
+        || characterSlider.isMouseButtonDown()
         || compressLimitToggle_.isMouseButtonDown()
         || fetCharacterCombo.isMouseButtonDown()
         || fetCharacterPillOff_.isMouseButtonDown() || fetCharacterPillRevA_.isMouseButtonDown() || fetCharacterPillLN_.isMouseButtonDown()
@@ -291,6 +394,7 @@ void CompressorSection::setHighlight(bool on)
 
 void CompressorSection::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     auto b = getLocalBounds().toFloat();
     // Spec §4: module card — pluginSurface, 2px pluginBorder, 16px radius
     g.setColour(OmbicLookAndFeel::pluginSurface());
@@ -319,6 +423,10 @@ void CompressorSection::resized()
     const bool compact = (r.getHeight() < 110);
     const int headerH = compact ? 22 : 36;  // §6 Module card header 36px
     r.removeFromTop(headerH);
+    const int profileW = compact ? 96 : 130;
+    const int profileH = compact ? 18 : 26;
+    curveProfileCombo_.setBounds(r.getRight() - 8 - profileW, (headerH - profileH) / 2, profileW, profileH);  // header, right of the title
+    morphPartnerCombo_.setBounds(curveProfileCombo_.getX() - 6 - profileW, curveProfileCombo_.getY(), profileW, profileH);
     const int bodyPad = compact ? 8 : 14;  // §6 body padding 14px
     r.reduce(bodyPad, 0);
     r.removeFromBottom(bodyPad);
@@ -345,7 +453,8 @@ void CompressorSection::resized()
     };
     const int knobSizeOpto = compact ? 52 : 80;   // §6 Opto (single) 80px diameter
     int knobSizeFet = compact ? 46 : 60;         // §6 FET (each) 60px diameter
-    const int numKnobs = pwmVisible ? 3 : (fetVisible ? 4 : (vcaVisible ? 2 : 1));
+    const bool characterVisible = characterSlider.isVisible();
+    const int numKnobs = (pwmVisible ? 3 : (fetVisible ? 4 : (vcaVisible ? 2 : 1))) + (characterVisible ? 1 : 0);
     if (fetVisible || pwmVisible || vcaVisible)
     {
         int availableW = r.getWidth();
@@ -372,6 +481,8 @@ void CompressorSection::resized()
         placeKnob(ratioSlider, ratioLabel, knobSizeFet);
         placeKnob(attackSlider, attackLabel, knobSizeFet);
         placeKnob(releaseSlider, releaseLabel, knobSizeFet);
+        if (characterVisible)
+            placeKnob(characterSlider, characterLabel, knobSizeFet);
         const int pillW = compact ? 44 : 56;
         const int pillH = compact ? 20 : 26;
         const int pillGap = compact ? 6 : 8;
@@ -386,14 +497,19 @@ void CompressorSection::resized()
     {
         placeKnob(thresholdSlider, thresholdLabel, knobSizeFet);
         placeKnob(ratioSlider, ratioLabel, knobSizeFet);
+        if (characterVisible)
+            placeKnob(characterSlider, characterLabel, knobSizeFet);
     }
     else
     {
         int optoAreaW = r.getWidth() - (x - r.getX());
-        int threshX = x + (optoAreaW - knobSizeOpto) / 2;
+        const int morphW = characterVisible ? gap + knobSizeFet : 0;
+        int threshX = x + (optoAreaW - knobSizeOpto - morphW) / 2;
         thresholdLabel.setBounds(threshX, r.getY(), knobSizeOpto + gap, labelH);
         thresholdSlider.setBounds(threshX, r.getY() + labelH, knobSizeOpto, knobSizeOpto);
         x = threshX + knobSizeOpto + gap;
+        if (characterVisible)
+            placeKnob(characterSlider, characterLabel, knobSizeFet);
     }
 
     int knobH = (fetVisible || pwmVisible || vcaVisible) ? knobSizeFet : knobSizeOpto;
@@ -2,10 +2,12 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
 class OmbicCompressorProcessor;
 
 /** Compressor controls + mode selector + GR meter. */
-class CompressorSection : public juce::Component
+class CompressorSection : public juce::Component,
+                          public RenderScheduler::Client
 {
 public:
     explicit CompressorSection(OmbicCompressorProcessor& processor);
@@ -21,6 +23,7 @@ public:
     juce::Slider& getAttackSlider() { return attackSlider; }
     juce::Slider& getReleaseSlider() { return releaseSlider; }
     juce::Slider& getSpeedSlider() { return speedSlider; }
+    juce::Slider& getCharacterSlider() { return characterSlider; }
     juce::Component* getGainReductionMeter() { return &grMeter; }
 
     /** mode: 0=Opto, 1=FET, 2=PWM, 3=VCA. Controls which controls are visible (Compress/Limit vs Ratio/Attack/Release vs Ratio/Speed vs Threshold+Ratio only for VCA). */
@@ -30,12 +33,15 @@ public:
 
     /** When false, hide GR meter and readout (e.g. v2 uses main view + output for GR). */
     void setShowGrMeter(bool show);
-    /** Call from editor timer to refresh GR readout from processor. */
-    void updateGrReadout();
+    /** GR readout and meter from the scheduler's frame (max GR since the previous tick). */
+    void renderTick(const RenderScheduler::Frame& frame) override;
     /** Call from editor timer to sync Compress/Limit toggle state from param. */
     void updateCompressLimitButtonStates();
     /** Call from editor timer to sync FET character pill states from param (when in FET mode). */
     void updateFetCharacterPillStates();
+    /** Call from editor timer: lists the current engine's curve profiles (FET, Opto or VCA) and its possible Character
+     *  partners in the header selectors, and shows the Character knob while the engine has a partner. Hidden for PWM. */
+    void updateCurveProfileControls();
     /** True if user is dragging any control in this section. */
     bool isInteracting() const;
     void setHighlight(bool on);
@@ -55,11 +61,19 @@ private:
     juce::TextButton fetCharacterPillRevA_;
     juce::TextButton fetCharacterPillLN_;
     juce::ToggleButton compressLimitToggle_;
+    juce::ComboBox curveProfileCombo_;
+    juce::ComboBox morphPartnerCombo_;
+    std::vector<juce::String> curveProfileIds_;    // item id - 1 → profile id, for curveProfileMode_
+    std::vector<juce::String> morphPartnerIds_;    // item id - 1 → profile id, for curveProfileMode_
+    int curveProfileMode_ = -1;       // mode and processor serial the selectors were last filled for
+    int curveProfileSerial_ = -1;
+    bool characterAvailable_ = false; // the engine of curveProfileMode_ has a Character partner
     juce::Slider thresholdSlider;
     juce::Slider ratioSlider;
     juce::Slider attackSlider;
     juce::Slider releaseSlider;
     juce::Slider speedSlider;
+    juce::Slider characterSlider;
     juce::Label modeLabel;
     juce::Label compressLimitLabel;
     juce::Label thresholdLabel;
@@ -67,6 +81,7 @@ private:
     juce::Label attackLabel;
     juce::Label releaseLabel;
     juce::Label speedLabel;
+    juce::Label characterLabel;
     juce::Label grReadoutLabel;
     float smoothedGrDb_ = 0.0f;
     float grHoldDb_ = 0.0f;
@@ -80,9 +95,11 @@ private:
     public:
         GainReductionMeterComponent(OmbicCompressorProcessor& p);
         void paint(juce::Graphics& g) override;
+        /** Ballistics for one tick; repaints only if the bar or hold line moved. */
+        void tick(float grDb);
     private:
-        OmbicCompressorProcessor& processor;
         float smoothedGrDb_ = 0.0f;
+        float paintedGrDb_ = -1.0f, paintedHoldDb_ = -1.0f;
         float grHoldDb_ = 0.0f;
         int grHoldTicks_ = 0;
         static constexpr float kGrAttackCoeff = 0.77f;
@@ -1,5 +1,6 @@
 #include "MainViewAsTubeComponent.h"
 #include "../PluginProcessor.h"
+#include "PaintProfiler.h"
 
 namespace
 {
@@ -24,14 +25,33 @@ MainViewAsTubeComponent::MainViewAsTubeComponent(OmbicCompressorProcessor& proce
     outReadout_.setJustificationType(juce::Justification::centred);
     outReadout_.setFont(OmbicLookAndFeel::getOmbicFontForPainting(9.5f, true));
     addAndMakeVisible(outReadout_);
-    startTimerHz(45);
 }
 
-void MainViewAsTubeComponent::timerCallback()
+std::array<float, 4> MainViewAsTubeComponent::readNeonParams() const
 {
-    float inPeak = proc_.inputPeakDb.load();
-    float outPeak = proc_.outputPeakDb.load();
-    float grDb = proc_.gainReductionDb.load();
+    auto& apvts = proc_.getValueTreeState();
+    std::array<float, 4> p{ 0.45f, 0.5f, 0.5f, 1.0f };
+    const char* ids[] = { OmbicCompressorProcessor::paramNeonDrive, OmbicCompressorProcessor::paramNeonIntensity,
+                          OmbicCompressorProcessor::paramNeonTone, OmbicCompressorProcessor::paramNeonMix };
+    for (size_t i = 0; i < p.size(); ++i)
+        if (auto* r = apvts.getRawParameterValue(ids[i]))
+            p[i] = r->load();
+    return p;
+}
+
+juce::Rectangle<float> MainViewAsTubeComponent::getFilamentTube() const
+{
+    auto plotArea = getLocalBounds().toFloat().reduced(8.0f, 6.0f);
+    const float tubeH = 42.0f;
+    return { plotArea.getX() + 4.0f, plotArea.getCentreY() - tubeH * 0.5f, plotArea.getWidth() - 8.0f, tubeH };
+}
+
+void MainViewAsTubeComponent::renderTick(const RenderScheduler::Frame& frame)
+{
+    const auto& meters = frame.meters;
+    float inPeak = meters[emulation::MeterBus::InputPeak];
+    float outPeak = meters[emulation::MeterBus::OutputPeak];
+    float grDb = meters[emulation::MeterBus::GainReduction];
     if (inPeak > peakInDb_) peakInDb_ += kPeakAttackCoeff * (inPeak - peakInDb_);
     else peakInDb_ += kPeakReleaseCoeff * (inPeak - peakInDb_);
     if (outPeak > peakOutDb_) peakOutDb_ += kPeakAttackCoeff * (outPeak - peakOutDb_);
@@ -53,18 +73,21 @@ void MainViewAsTubeComponent::timerCallback()
     outReadout_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicTeal());
 
     filamentPhase_ += 0.06f;
-    repaint();
+    transferCurve_.renderTick(frame);
+    const auto neon = readNeonParams();
+    if (neon != paintedNeonParams_)
+    {
+        paintedNeonParams_ = neon;
+        repaint();
+    }
+    else
+    {
+        repaint(getFilamentTube().getSmallestIntegerContainer());
+    }
 }
 
-void MainViewAsTubeComponent::paintTubeGlow(juce::Graphics& g)
+void MainViewAsTubeComponent::paintTubeGlow(juce::Graphics& g, float drive, float intensity, float mix) const
 {
-    auto* driveP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonDrive);
-    auto* intensityP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonIntensity);
-    auto* mixP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonMix);
-    float drive = driveP ? driveP->load() : 0.45f;
-    float intensity = intensityP ? intensityP->load() : 0.5f;
-    float mix = mixP ? mixP->load() : 1.0f;
-
     float glowStrength = (drive * 0.5f + intensity * 0.6f + mix * 0.5f);
     float pinkAlpha = juce::jmin(1.0f, glowStrength * 0.85f);
     float redAlpha = juce::jmin(0.6f, glowStrength * 0.5f);
@@ -79,36 +102,29 @@ void MainViewAsTubeComponent::paintTubeGlow(juce::Graphics& g)
     g.fillRoundedRectangle(b.reduced(2.0f), 10.0f);
     g.setColour(red.withAlpha(redAlpha * 0.25f));
     g.fillRoundedRectangle(b.reduced(4.0f), 8.0f);
+
+    g.setColour(OmbicLookAndFeel::pluginBorder().withAlpha(0.5f));
+    g.drawRoundedRectangle(b.reduced(0.5f), 12.0f, 1.0f);
 }
 
 void MainViewAsTubeComponent::paintFilament(juce::Graphics& g)
 {
-    auto* driveP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonDrive);
-    auto* intensityP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonIntensity);
-    auto* toneP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonTone);
-    auto* mixP = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramNeonMix);
-    float drive = driveP ? driveP->load() : 0.45f;
-    float intensity = intensityP ? intensityP->load() : 0.5f;
-    float tone = toneP ? toneP->load() : 0.5f;
-    float mix = mixP ? mixP->load() : 1.0f;
+    const auto neon = readNeonParams();
+    const float drive = neon[0], intensity = neon[1], tone = neon[2], mix = neon[3];
 
-    auto plotArea = getLocalBounds().toFloat().reduced(8.0f, 6.0f);
-    const float tubeH = 42.0f;
-    const float tubeRadius = tubeH * 0.5f;
-    const float tubeY = plotArea.getCentreY() - tubeRadius;
-    const float tubeX = plotArea.getX() + 4.0f;
-    const float tubeW = plotArea.getWidth() - 8.0f;
-    const float yMid = plotArea.getCentreY();
+    const auto tube = getFilamentTube();
+    const float tubeX = tube.getX();
+    const float tubeW = tube.getWidth();
+    const float yMid = tube.getCentreY();
     const float amp = 14.0f;  // §6 Filament amplitude ±14px
 
     juce::Path filamentPath;
-    std::vector<float> waveformSamples;
     bool hasRealSignal = false;
+    bool filled = false;
     float peak = 0.0f;
-    if (proc_.getScopeWaveformSamples(waveformSamples) && waveformSamples.size() > 1)
+    if (strip_.read(proc_.getScopeWaveform()))
     {
-        for (size_t i = 0; i < waveformSamples.size(); ++i)
-            peak = juce::jmax(peak, std::abs(waveformSamples[i]));
+        peak = strip_.peak();
         hasRealSignal = (peak >= 1e-4f);
     }
 
@@ -116,21 +132,12 @@ void MainViewAsTubeComponent::paintFilament(juce::Graphics& g)
 
     if (hasRealSignal)
     {
-        const size_t n = waveformSamples.size();
+        // Min/max envelope per column, normalised by peak and shaped by the display drive
         const float displayGain = 1.0f + drive * 4.0f;
         const float displayNorm = std::tanh(displayGain);
-        for (size_t i = 0; i < n; ++i)
-        {
-            float s = waveformSamples[i] / (peak + 1e-9f);
-            float displayed = std::tanh(s * displayGain) / displayNorm;
-            float t = static_cast<float>(i) / static_cast<float>(n - 1);
-            float x = tubeX + t * tubeW;
-            float yPos = yMid - displayed * amp;
-            if (i == 0)
-                filamentPath.startNewSubPath(x, yPos);
-            else
-                filamentPath.lineTo(x, yPos);
-        }
+        const float norm = 1.0f / (peak + 1e-9f);
+        filamentPath = strip_.buildPath(tubeX, tubeW, [=](float v) { return yMid - std::tanh(v * norm * displayGain) / displayNorm * amp; });
+        filled = true;
     }
     else
     {
@@ -159,10 +166,8 @@ void MainViewAsTubeComponent::paintFilament(juce::Graphics& g)
     float glowStroke = 16.0f + 36.0f * intensity;
     float lineStroke = 0.4f + 4.0f * intensity;
 
-    juce::Path tubeClip;
-    tubeClip.addRoundedRectangle(tubeX, tubeY, tubeW, tubeH, tubeRadius);
     g.saveState();
-    g.reduceClipRegion(tubeClip);
+    g.reduceClipRegion(filamentClip_);
 
     if (glowOpacity > 0.001f)
     {
@@ -172,6 +177,8 @@ void MainViewAsTubeComponent::paintFilament(juce::Graphics& g)
     if (lineOpacity > 0.001f)
     {
         g.setColour(neonPink.withAlpha(lineOpacity));
+        if (filled)
+            g.fillPath(filamentPath);   // min/max envelope band
         g.strokePath(filamentPath, juce::PathStrokeType(lineStroke));
     }
     g.restoreState();
@@ -179,15 +186,18 @@ void MainViewAsTubeComponent::paintFilament(juce::Graphics& g)
 
 void MainViewAsTubeComponent::paint(juce::Graphics& g)
 {
-    paintTubeGlow(g);
-
-    auto b = getLocalBounds().toFloat();
-    g.setColour(OmbicLookAndFeel::pluginBorder().withAlpha(0.5f));
-    g.drawRoundedRectangle(b.reduced(0.5f), 12.0f, 1.0f);
+    OMBIC_PAINT_SCOPE(*this);
+    const auto neon = readNeonParams();
+    const float drive = neon[0], intensity = neon[1], mix = neon[3];
+    // Glow only depends on drive, intensity and mix: key on them at 1/1024 resolution (well below a colour step)
+    auto q = [](float v) { return static_cast<juce::int64>(juce::jlimit(0, 0xfffff, juce::roundToInt(v * 1024.0f))); };
+    const juce::int64 key = q(drive) | (q(intensity) << 20) | (q(mix) << 40);
+    background_.draw(g, getLocalBounds(), key, [this, drive, intensity, mix](juce::Graphics& lg) { paintTubeGlow(lg, drive, intensity, mix); });
 }
 
 void MainViewAsTubeComponent::paintOverChildren(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     paintFilament(g);
 }
 
@@ -196,6 +206,11 @@ void MainViewAsTubeComponent::resized()
     auto r = getLocalBounds();
     if (r.isEmpty()) return;
 
+    const auto tube = getFilamentTube();
+    filamentClip_.clear();
+    filamentClip_.addRoundedRectangle(tube, tube.getHeight() * 0.5f);
+    proc_.getScopeWaveform().setNumColumns(juce::roundToInt(tube.getWidth()));   // one min/max column per pixel
+
     const int readoutRowTotalH = kReadoutH + kReadoutRowPadding;
     const int curveH = juce::jmin(90, r.getHeight() - readoutRowTotalH);  // §6 Transfer curve ~90px of main view
     transferCurve_.setBounds(r.getX(), r.getY(), r.getWidth(), curveH);
@@ -2,27 +2,38 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
 #include "TransferCurveComponent.h"
+#include "CachedLayer.h"
+#include "ScopeStrip.h"
 
 class OmbicCompressorProcessor;
 
-/** v2: Main view *is* the tube. Draws saturation-driven background glow, transfer curve, In/GR/Out readouts, and filament (waveform). */
+/** v2: Main view *is* the tube. Draws saturation-driven background glow, transfer curve, In/GR/Out readouts, and filament (waveform).
+ *  Per tick only the filament strip is repainted (it animates); the glow repaints when the Neon controls change.
+ *  The glow and border are a cached layer keyed by the glow-driving params, so filament repaints only blit it. */
 class MainViewAsTubeComponent : public juce::Component,
-                                private juce::Timer
+                                public RenderScheduler::Client
 {
 public:
     explicit MainViewAsTubeComponent(OmbicCompressorProcessor& processor);
     void resized() override;
     void paint(juce::Graphics& g) override;
     void paintOverChildren(juce::Graphics& g) override;
+    void lookAndFeelChanged() override { background_.invalidate(); }
+    void renderTick(const RenderScheduler::Frame& frame) override;
 
 private:
-    void timerCallback() override;
-    void paintTubeGlow(juce::Graphics& g);
+    void paintTubeGlow(juce::Graphics& g, float drive, float intensity, float mix) const;
     void paintFilament(juce::Graphics& g);
+    juce::Rectangle<float> getFilamentTube() const;
+    std::array<float, 4> readNeonParams() const;   // drive, intensity, tone, mix (raw)
 
     OmbicCompressorProcessor& proc_;
     OmbicLookAndFeel ombicLf_;
+    CachedLayer background_;
+    juce::Path filamentClip_;   // tube pill, rebuilt on resize
+    ScopeStrip strip_;          // latest output min/max columns
     TransferCurveComponent transferCurve_;
     juce::Label inReadout_;
     juce::Label grReadout_;
@@ -36,6 +47,7 @@ private:
     static constexpr float kGrAttackCoeff = 0.77f;
     static constexpr float kGrReleaseCoeff = 0.071f;
     float filamentPhase_ = 0.0f;
+    std::array<float, 4> paintedNeonParams_{ -1.0f, -1.0f, -1.0f, -1.0f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainViewAsTubeComponent)
 };
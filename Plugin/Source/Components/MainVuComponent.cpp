@@ -1,5 +1,6 @@
 #include "MainVuComponent.h"
 #include "../PluginProcessor.h"
+#include "PaintProfiler.h"
 
 namespace
 {
@@ -36,6 +37,20 @@ MainVuComponent::MainVuComponent(OmbicCompressorProcessor& processor)
     };
     addAndMakeVisible(simpleButton_);
 
+    truePeakButton_.setButtonText("TP");
+    truePeakButton_.setName("main_vu_true_peak");
+    truePeakButton_.setClickingTogglesState(false);
+    truePeakButton_.onClick = [this]() { proc_.setTruePeakMetering(!proc_.isTruePeakMetering()); };
+    truePeakButton_.setTooltip("True peak: 4x oversampled (BS.1770) In/Out peaks, shows inter-sample overs above 0 dBTP.");
+    addAndMakeVisible(truePeakButton_);
+
+    loudnessButton_.setButtonText("LU");
+    loudnessButton_.setName("main_vu_loudness");
+    loudnessButton_.setClickingTogglesState(false);
+    loudnessButton_.onClick = [this]() { showLoudness_ = !showLoudness_; loudnessButton_.setToggleState(showLoudness_, juce::dontSendNotification); };
+    loudnessButton_.setTooltip("Show In/Out as BS.1770 short-term loudness (LUFS, 3 s); momentary in the tooltip.");
+    addAndMakeVisible(loudnessButton_);
+
     addAndMakeVisible(transferCurve_);
     inReadout_.setJustificationType(juce::Justification::centred);
     inReadout_.setFont(OmbicLookAndFeel::getOmbicFontForPainting(9.5f, true));
@@ -50,7 +65,6 @@ MainVuComponent::MainVuComponent(OmbicCompressorProcessor& processor)
     grReadout_.setTooltip("Gain reduction: how much the compressor is reducing level. Updates quickly with the signal.");
     outReadout_.setTooltip("Output peak level (fast response).");
 
-    startTimerHz(kMeterHz);
     updateFromParameter();
 }
 
@@ -66,17 +80,19 @@ void MainVuComponent::updateFromParameter()
     bool fancy = isFancy();
     fancyButton_.setToggleState(fancy, juce::dontSendNotification);
     simpleButton_.setToggleState(!fancy, juce::dontSendNotification);
+    truePeakButton_.setToggleState(proc_.isTruePeakMetering(), juce::dontSendNotification);
     transferCurve_.setVisible(fancy);
     inReadout_.setVisible(fancy);
     grReadout_.setVisible(fancy);
     outReadout_.setVisible(fancy);
 }
 
-void MainVuComponent::timerCallback()
+void MainVuComponent::renderTick(const RenderScheduler::Frame& frame)
 {
-    float inPeak = proc_.inputPeakDb.load();
-    float outPeak = proc_.outputPeakDb.load();
-    float grDb = proc_.gainReductionDb.load();
+    const auto& meters = frame.meters;
+    float inPeak = meters[emulation::MeterBus::InputPeak];
+    float outPeak = meters[emulation::MeterBus::OutputPeak];
+    float grDb = meters[emulation::MeterBus::GainReduction];
 
     if (inPeak > peakInDb_) peakInDb_ += kPeakAttackCoeff * (inPeak - peakInDb_);
     else peakInDb_ += kPeakReleaseCoeff * (inPeak - peakInDb_);
@@ -85,8 +101,24 @@ void MainVuComponent::timerCallback()
     if (grDb > smoothedGrDb_) smoothedGrDb_ += kGrAttackCoeff * (grDb - smoothedGrDb_);
     else smoothedGrDb_ += kGrReleaseCoeff * (grDb - smoothedGrDb_);
 
-    inReadout_.setText((peakInDb_ <= -60.0f ? juce::String("-60") : juce::String(static_cast<int>(peakInDb_))) + " dB", juce::dontSendNotification);
-    inReadout_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicBlue());
+    // True peak: one decimal and a TP suffix; anything over 0 dBTP turns red
+    const bool truePeak = proc_.isTruePeakMetering();
+    auto peakText = [truePeak](float db) {
+        if (db <= -60.0f) return juce::String("-60") + (truePeak ? " TP" : " dB");
+        return truePeak ? juce::String(db, 1) + " TP" : juce::String(static_cast<int>(db)) + " dB";
+    };
+    auto lufsText = [](float lufs) { return lufs <= -70.0f ? juce::String("-inf LUFS") : juce::String(lufs, 1) + " LUFS"; };
+    if (showLoudness_)
+    {
+        inReadout_.setText(lufsText(proc_.inputShortTermLufs.load()), juce::dontSendNotification);
+        inReadout_.setTooltip("Input short-term loudness. Momentary: " + lufsText(proc_.inputMomentaryLufs.load()));
+    }
+    else
+    {
+        inReadout_.setText(peakText(peakInDb_), juce::dontSendNotification);
+        inReadout_.setTooltip("Input peak level (fast response).");
+    }
+    inReadout_.setColour(juce::Label::textColourId, !showLoudness_ && truePeak && peakInDb_ > 0.0f ? OmbicLookAndFeel::ombicRed() : OmbicLookAndFeel::ombicBlue());
     grReadout_.setText(juce::String(smoothedGrDb_, 1) + " dB", juce::dontSendNotification);
     float absGr = std::abs(smoothedGrDb_);
     if (absGr < 3.0f)
@@ -95,11 +127,31 @@ void MainVuComponent::timerCallback()
         grReadout_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicYellow());
     else
         grReadout_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicRed());
-    outReadout_.setText((peakOutDb_ <= -60.0f ? juce::String("-60") : juce::String(static_cast<int>(peakOutDb_))) + " dB", juce::dontSendNotification);
-    outReadout_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicTeal());
+    if (showLoudness_)
+    {
+        outReadout_.setText(lufsText(proc_.outputShortTermLufs.load()), juce::dontSendNotification);
+        outReadout_.setTooltip("Output short-term loudness. Momentary: " + lufsText(proc_.outputMomentaryLufs.load()));
+    }
+    else
+    {
+        outReadout_.setText(peakText(peakOutDb_), juce::dontSendNotification);
+        outReadout_.setTooltip("Output peak level (fast response).");
+    }
+    outReadout_.setColour(juce::Label::textColourId, !showLoudness_ && truePeak && peakOutDb_ > 0.0f ? OmbicLookAndFeel::ombicRed() : OmbicLookAndFeel::ombicTeal());
 
     updateFromParameter();
-    repaint();
+    const bool fancy = isFancy();
+    if (fancy)
+        transferCurve_.renderTick(frame);
+    if (fancy != paintedFancy_
+        || (!fancy && (RenderScheduler::exceeds(peakInDb_, paintedInDb_, RenderScheduler::kMeterThresholdDb)
+                       || RenderScheduler::exceeds(peakOutDb_, paintedOutDb_, RenderScheduler::kMeterThresholdDb))))
+    {
+        paintedFancy_ = fancy;
+        paintedInDb_ = peakInDb_;
+        paintedOutDb_ = peakOutDb_;
+        repaint();
+    }
 }
 
 void MainVuComponent::resized()
@@ -113,6 +165,8 @@ void MainVuComponent::resized()
     fancyButton_.setBounds(header.removeFromLeft(btnW).reduced(2));
     header.removeFromLeft(gap);
     simpleButton_.setBounds(header.removeFromLeft(btnW).reduced(2));
+    truePeakButton_.setBounds(header.removeFromRight(44).reduced(2));
+    loudnessButton_.setBounds(header.removeFromRight(44).reduced(2));
 
     r.reduce(kDisplayPad, kDisplayPad);
     if (r.getHeight() <= 0) return;
@@ -133,7 +187,26 @@ void MainVuComponent::resized()
     outReadout_.setBounds(rx, ry, kReadoutLabelW, kReadoutH);
 }
 
-void MainVuComponent::paint(juce::Graphics& g)
+MainVuComponent::ArcGeometry MainVuComponent::getArcGeometry() const
+{
+    ArcGeometry a;
+    auto displayArea = getLocalBounds();
+    displayArea.removeFromTop(kToggleH + kDisplayPad);
+    displayArea.removeFromBottom(kDisplayPad);
+    displayArea.reduce(kDisplayPad, 0);
+    if (displayArea.getHeight() <= 0 || displayArea.getWidth() <= 0)
+        return a;
+    // Same arc design as before, rotated 90° so arc is vertical (bottom = 0, top = full, like output section)
+    auto arcR = displayArea.toFloat();
+    a.cx = arcR.getCentreX();
+    a.cy = arcR.getCentreY();
+    a.radius = juce::jmin(arcR.getHeight(), arcR.getWidth() * 2.0f) * 0.45f;
+    a.arcX = a.cx + a.radius * 0.5f;  // arc on the right half so it runs vertically
+    a.valid = true;
+    return a;
+}
+
+void MainVuComponent::paintBackground(juce::Graphics& g, bool fancy) const
 {
     auto b = getLocalBounds().toFloat();
     g.setColour(OmbicLookAndFeel::pluginSurface());
@@ -145,47 +218,42 @@ void MainVuComponent::paint(juce::Graphics& g)
     g.setColour(OmbicLookAndFeel::pluginRaised());
     g.fillRoundedRectangle(header.toFloat().reduced(1.0f), 8.0f);
 
-    if (!isFancy())
-    {
-        auto displayArea = getLocalBounds();
-        displayArea.removeFromTop(kToggleH + kDisplayPad);
-        displayArea.removeFromBottom(kDisplayPad);
-        displayArea.reduce(kDisplayPad, 0);
-        if (displayArea.getHeight() > 0 && displayArea.getWidth() > 0)
-        {
-            // Same arc design as before, rotated 90° so arc is vertical (bottom = 0, top = full, like output section)
-            auto arcR = displayArea.toFloat();
-            const float cx = arcR.getCentreX();
-            const float cy = arcR.getCentreY();
-            const float radius = juce::jmin(arcR.getHeight(), arcR.getWidth() * 2.0f) * 0.45f;
-            const float arcX = cx + radius * 0.5f;  // arc on the right half so it runs vertically
-            const float arcW = 8.0f;
-            const float startAngle = juce::MathConstants<float>::halfPi;   // bottom
-            const float endAngle = juce::MathConstants<float>::halfPi * 3.0f; // top
-            const float sweep = juce::MathConstants<float>::pi;
-
-            juce::Path arcTrack;
-            arcTrack.addArc(arcX - radius, cy - radius, radius * 2.0f, radius * 2.0f, startAngle, endAngle, true);
-            g.setColour(OmbicLookAndFeel::pluginBorder());
-            g.strokePath(arcTrack, juce::PathStrokeType(arcW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-
-            auto dbToNorm = [](float db) { return juce::jlimit(0.0f, 1.0f, (db + 60.0f) / 60.0f); };
-            float inNorm = dbToNorm(peakInDb_);
-            float outNorm = dbToNorm(peakOutDb_);
-
-            juce::Path inArc;
-            inArc.addArc(arcX - radius, cy - radius, radius * 2.0f, radius * 2.0f, startAngle, startAngle + sweep * inNorm, true);
-            g.setColour(OmbicLookAndFeel::ombicBlue());
-            g.strokePath(inArc, juce::PathStrokeType(arcW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-
-            juce::Path outArc;
-            outArc.addArc(arcX - radius, cy - radius, radius * 2.0f, radius * 2.0f, startAngle, startAngle + sweep * outNorm, true);
-            g.setColour(OmbicLookAndFeel::ombicTeal());
-            g.strokePath(outArc, juce::PathStrokeType(arcW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-
-            g.setFont(OmbicLookAndFeel::getOmbicFontForPainting(8.0f, true));
-            g.setColour(OmbicLookAndFeel::pluginMuted());
-            g.drawText("In / Out", static_cast<int>(cx - 40), static_cast<int>(cy + radius * 0.5f + 4), 80, 12, juce::Justification::centred);
-        }
-    }
+    const auto a = getArcGeometry();
+    if (fancy || !a.valid)
+        return;
+    juce::Path arcTrack;
+    arcTrack.addArc(a.arcX - a.radius, a.cy - a.radius, a.radius * 2.0f, a.radius * 2.0f, kArcStart, kArcStart + kArcSweep, true);
+    g.setColour(OmbicLookAndFeel::pluginBorder());
+    g.strokePath(arcTrack, juce::PathStrokeType(kArcW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+}
+
+void MainVuComponent::paint(juce::Graphics& g)
+{
+    OMBIC_PAINT_SCOPE(*this);
+    const bool fancy = isFancy();
+    // Panel, header strip and (Simple) the arc track are cached; only the In/Out arcs are drawn per frame
+    background_.draw(g, getLocalBounds(), fancy ? 1 : 0, [this, fancy](juce::Graphics& lg) { paintBackground(lg, fancy); });
+
+    const auto a = getArcGeometry();
+    if (fancy || !a.valid)
+        return;
+
+    auto dbToNorm = [](float db) { return juce::jlimit(0.0f, 1.0f, (db + 60.0f) / 60.0f); };
+    float inNorm = dbToNorm(peakInDb_);
+    float outNorm = dbToNorm(peakOutDb_);
+
+    juce::Path inArc;
+    inArc.addArc(a.arcX - a.radius, a.cy - a.radius, a.radius * 2.0f, a.radius * 2.0f, kArcStart, kArcStart + kArcSweep * inNorm, true);
+    g.setColour(OmbicLookAndFeel::ombicBlue());
+    g.strokePath(inArc, juce::PathStrokeType(kArcW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+
+    juce::Path outArc;
+    outArc.addArc(a.arcX - a.radius, a.cy - a.radius, a.radius * 2.0f, a.radius * 2.0f, kArcStart, kArcStart + kArcSweep * outNorm, true);
+    g.setColour(OmbicLookAndFeel::ombicTeal());
+    g.strokePath(outArc, juce::PathStrokeType(kArcW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+
+    // Label stays above the arcs (they can cross it), so it is drawn per frame rather than cached under them
+    g.setFont(OmbicLookAndFeel::getOmbicFontForPainting(8.0f, true));
+    g.setColour(OmbicLookAndFeel::pluginMuted());
+    g.drawText("In / Out", static_cast<int>(a.cx - 40), static_cast<int>(a.cy + a.radius * 0.5f + 4), 80, 12, juce::Justification::centred);
 }
@@ -2,7 +2,9 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
 #include "TransferCurveComponent.h"
+#include "CachedLayer.h"
 
 class OmbicCompressorProcessor;
 
@@ -10,12 +12,15 @@ class OmbicCompressorProcessor;
  *  Toggle via "Fancy" / "Simple" buttons; state stored in paramMainVuDisplay (0 = Fancy, 1 = Simple).
  */
 class MainVuComponent : public juce::Component,
-                        private juce::Timer
+                        public RenderScheduler::Client
 {
 public:
     explicit MainVuComponent(OmbicCompressorProcessor& processor);
     void resized() override;
     void paint(juce::Graphics& g) override;
+    void lookAndFeelChanged() override { background_.invalidate(); }
+    /** Ballistics + readouts; the arc (Simple) repaints only when a needle moves, the curve handles its own dot. */
+    void renderTick(const RenderScheduler::Frame& frame) override;
 
     /** Call from editor or timer to sync toggle and visibility from APVTS. */
     void updateFromParameter();
@@ -24,13 +29,27 @@ public:
     juce::TextButton& getSimpleButton() { return simpleButton_; }
 
 private:
-    void timerCallback() override;
+    /** Simple-mode arc: circle centre (arcX, cy) and radius; cx is the display centre (label). */
+    struct ArcGeometry
+    {
+        float cx = 0.0f, cy = 0.0f, arcX = 0.0f, radius = 0.0f;
+        bool valid = false;
+    };
+    static constexpr float kArcW = 8.0f;
+    static constexpr float kArcStart = juce::MathConstants<float>::halfPi;   // bottom
+    static constexpr float kArcSweep = juce::MathConstants<float>::pi;       // to top
+    ArcGeometry getArcGeometry() const;
+    void paintBackground(juce::Graphics& g, bool fancy) const;
 
     OmbicCompressorProcessor& proc_;
     OmbicLookAndFeel ombicLf_;
+    CachedLayer background_;
 
     juce::TextButton fancyButton_;
     juce::TextButton simpleButton_;
+    juce::TextButton truePeakButton_;   // In/Out readouts: sample peak vs BS.1770 true peak (processor-wide)
+    juce::TextButton loudnessButton_;   // In/Out readouts: short-term LUFS instead of peak
+    bool showLoudness_ = false;
     TransferCurveComponent transferCurve_;
     juce::Label inReadout_;
     juce::Label grReadout_;
@@ -39,7 +58,8 @@ private:
     float peakInDb_ = -60.0f;
     float peakOutDb_ = -60.0f;
     float smoothedGrDb_ = 0.0f;
-    static constexpr int kMeterHz = 45;
+    float paintedInDb_ = -100.0f, paintedOutDb_ = -100.0f;   // arc needles as last painted
+    bool paintedFancy_ = true;
     static constexpr float kPeakAttackCoeff = 0.99f;
     static constexpr float kPeakReleaseCoeff = 0.054f;
     static constexpr float kGrAttackCoeff = 0.77f;
@@ -1,5 +1,6 @@
 #include "MeterStrip.h"
 #include "../PluginProcessor.h"
+#include "PaintProfiler.h"
 
 static float levelToNorm(float db)
 {
@@ -19,29 +20,61 @@ MeterStrip::MeterStrip(OmbicCompressorProcessor& processor)
 {
     peakButton_.setButtonText("Peak");
     peakButton_.setClickingTogglesState(false);
-    peakButton_.onClick = [this]() { showPeak_ = true; peakButton_.setToggleState(true, juce::dontSendNotification); vuButton_.setToggleState(false, juce::dontSendNotification); };
+    peakButton_.onClick = [this]() { setDisplayMode(true, false); };
     vuButton_.setButtonText("VU");
     vuButton_.setClickingTogglesState(false);
-    vuButton_.onClick = [this]() { showPeak_ = false; vuButton_.setToggleState(true, juce::dontSendNotification); peakButton_.setToggleState(false, juce::dontSendNotification); };
+    vuButton_.onClick = [this]() { setDisplayMode(false, false); };
     peakButton_.setToggleState(true, juce::dontSendNotification);
     peakButton_.setTooltip("Show peak level (fast response, L/R stereo, 2 s hold).");
     vuButton_.setTooltip("Show average level (VU-style, ~300 ms).");
+    lufsButton_.setButtonText("LUFS");
+    lufsButton_.setClickingTogglesState(false);
+    lufsButton_.onClick = [this]() { setDisplayMode(false, true); };
+    lufsButton_.setTooltip("Show BS.1770 loudness: bar = momentary (400 ms), readout = short-term (3 s) LUFS.");
+    truePeakButton_.setButtonText("TP");
+    truePeakButton_.setClickingTogglesState(false);
+    truePeakButton_.onClick = [this]() { proc.setTruePeakMetering(!proc.isTruePeakMetering()); };
+    truePeakButton_.setTooltip("True peak: 4x oversampled (BS.1770) peaks; overs above 0 dBTP read red.");
     addAndMakeVisible(peakButton_);
     addAndMakeVisible(vuButton_);
-    startTimerHz(kMeterHz);
+    addAndMakeVisible(truePeakButton_);
+    addAndMakeVisible(lufsButton_);
 }
 
-void MeterStrip::timerCallback()
+void MeterStrip::setDisplayMode(bool peak, bool lufs)
 {
-    float inPeakRaw = proc.inputPeakDb.load();
-    float outPeakRaw = proc.outputPeakDb.load();
-    float inL = proc.inputPeakDbL.load();
-    float inR = proc.inputPeakDbR.load();
-    float outL = proc.outputPeakDbL.load();
-    float outR = proc.outputPeakDbR.load();
-    float inRmsRaw = proc.inputLevelDb.load();
-    float outRmsRaw = proc.outputLevelDb.load();
-    float grDb = proc.gainReductionDb.load();
+    showPeak_ = peak;
+    showLufs_ = !peak && lufs;
+    peakButton_.setToggleState(showPeak_, juce::dontSendNotification);
+    vuButton_.setToggleState(!showPeak_ && !showLufs_, juce::dontSendNotification);
+    lufsButton_.setToggleState(showLufs_, juce::dontSendNotification);
+    repaint();
+}
+
+std::array<float, MeterStrip::kNumDrawnValues> MeterStrip::drawnValues() const
+{
+    return { peakInDb_, peakOutDb_, peakInL_, peakInR_, peakOutL_, peakOutR_, avgInDb_, avgOutDb_,
+             momentaryInLufs_, shortTermInLufs_, momentaryOutLufs_, shortTermOutLufs_,
+             peakHoldInDb_, peakHoldOutDb_, smoothedGrDb_, grHoldDb_ };
+}
+
+void MeterStrip::renderTick(const RenderScheduler::Frame& frame)
+{
+    const auto& meters = frame.meters;
+    float inPeakRaw = meters[emulation::MeterBus::InputPeak];
+    float outPeakRaw = meters[emulation::MeterBus::OutputPeak];
+    float inL = meters[emulation::MeterBus::InputPeakL];
+    float inR = meters[emulation::MeterBus::InputPeakR];
+    float outL = meters[emulation::MeterBus::OutputPeakL];
+    float outR = meters[emulation::MeterBus::OutputPeakR];
+    float inRmsRaw = frame.inputRmsDb;
+    float outRmsRaw = frame.outputRmsDb;
+    float grDb = meters[emulation::MeterBus::GainReduction];
+    truePeakButton_.setToggleState(proc.isTruePeakMetering(), juce::dontSendNotification);
+    momentaryInLufs_ = proc.inputMomentaryLufs.load();
+    shortTermInLufs_ = proc.inputShortTermLufs.load();
+    momentaryOutLufs_ = proc.outputMomentaryLufs.load();
+    shortTermOutLufs_ = proc.outputShortTermLufs.load();
 
     updatePeakBallistics(inPeakRaw, peakInDb_, kPeakAttackCoeff, kPeakReleaseCoeff);
     updatePeakBallistics(outPeakRaw, peakOutDb_, kPeakAttackCoeff, kPeakReleaseCoeff);
@@ -64,7 +97,16 @@ void MeterStrip::timerCallback()
     if (smoothedGrDb_ > grHoldDb_) { grHoldDb_ = smoothedGrDb_; grHoldTicks_ = kGrHoldTicks; }
     else { if (grHoldTicks_ > 0) --grHoldTicks_; if (grHoldTicks_ <= 0) grHoldDb_ += kGrReleaseCoeff * (smoothedGrDb_ - grHoldDb_); }  // decay hold toward current
 
-    repaint();
+    const auto values = drawnValues();
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (RenderScheduler::exceeds(values[i], painted_[i], RenderScheduler::kMeterThresholdDb))
+        {
+            painted_ = values;
+            repaint();
+            break;
+        }
+    }
 }
 
 void MeterStrip::resized()
@@ -77,10 +119,15 @@ void MeterStrip::resized()
     peakButton_.setBounds(bottom.removeFromLeft(btnW).reduced(gap, 2));
     bottom.removeFromLeft(gap);
     vuButton_.setBounds(bottom.removeFromLeft(btnW).reduced(gap, 2));
+    bottom.removeFromLeft(gap);
+    truePeakButton_.setBounds(bottom.removeFromLeft(btnW).reduced(gap, 2));
+    bottom.removeFromLeft(gap);
+    lufsButton_.setBounds(bottom.removeFromLeft(btnW + 8).reduced(gap, 2));
 }
 
 void MeterStrip::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     float inDisplayDb = showPeak_ ? peakInDb_ : avgInDb_;
     float outDisplayDb = showPeak_ ? peakOutDb_ : avgOutDb_;
     float inNorm = levelToNorm(inDisplayDb);
@@ -135,10 +182,13 @@ void MeterStrip::paint(juce::Graphics& g)
         g.setFont(OmbicLookAndFeel::getOmbicFontForPainting(9.0f, false));
         g.setColour(OmbicLookAndFeel::ink());
         g.drawText(title, x - 2, static_cast<int>(box.getBottom()) + 2, meterW + 4, 12, juce::Justification::centred);
-        juce::String dbStr = (displayDb <= -60.0f) ? "-60" : juce::String(static_cast<int>(displayDb));
-        g.drawText(dbStr + " dB", x - 2, static_cast<int>(box.getBottom()) + 14, meterW + 4, 12, juce::Justification::centred);
+        // Loudness readouts are absolute (BS.1770 floor -70), so they read LUFS, not LU
+        const float floorDb = showLufs_ ? -70.0f : -60.0f;
+        juce::String dbStr = (displayDb <= floorDb) ? (showLufs_ ? "-inf" : "-60") : juce::String(static_cast<int>(displayDb));
+        g.drawText(dbStr + (showLufs_ ? " LUFS" : " dB"), x - 2, static_cast<int>(box.getBottom()) + 14, meterW + 4, 12, juce::Justification::centred);
         x += meterW + gap;
     };
+    const bool truePeak = proc.isTruePeakMetering();
     auto drawLevelMeterStereo = [&](float normL, float normR, float holdDb, const juce::Colour& fillColour,
                                     const juce::String& title, float displayDb) {
         auto box = b.withX(static_cast<float>(x)).withWidth(static_cast<float>(meterW))
@@ -172,12 +222,16 @@ void MeterStrip::paint(juce::Graphics& g)
         g.setColour(OmbicLookAndFeel::ink());
         g.drawText(title, x - 2, static_cast<int>(box.getBottom()) + 2, meterW + 4, 12, juce::Justification::centred);
         juce::String dbStr = (displayDb <= -60.0f) ? "-60" : juce::String(static_cast<int>(displayDb));
-        g.drawText(dbStr + " dB", x - 2, static_cast<int>(box.getBottom()) + 14, meterW + 4, 12, juce::Justification::centred);
+        if (truePeak && displayDb > 0.0f)
+            g.setColour(OmbicLookAndFeel::ombicRed());  // inter-sample over
+        g.drawText(dbStr + (truePeak ? " TP" : " dB"), x - 2, static_cast<int>(box.getBottom()) + 14, meterW + 4, 12, juce::Justification::centred);
         x += meterW + gap;
     };
 
     if (showPeak_)
         drawLevelMeterStereo(levelToNorm(peakInL_), levelToNorm(peakInR_), peakHoldInDb_, OmbicLookAndFeel::ombicBlue(), "In", inDisplayDb);
+    else if (showLufs_)
+        drawLevelMeterMono(levelToNorm(momentaryInLufs_), OmbicLookAndFeel::ombicBlue(), "In", shortTermInLufs_);
     else
         drawLevelMeterMono(inNorm, OmbicLookAndFeel::ombicBlue(), "In", inDisplayDb);
 
@@ -207,6 +261,8 @@ void MeterStrip::paint(juce::Graphics& g)
 
     if (showPeak_)
         drawLevelMeterStereo(levelToNorm(peakOutL_), levelToNorm(peakOutR_), peakHoldOutDb_, OmbicLookAndFeel::ombicTeal(), "Out", outDisplayDb);
+    else if (showLufs_)
+        drawLevelMeterMono(levelToNorm(momentaryOutLufs_), OmbicLookAndFeel::ombicTeal(), "Out", shortTermOutLufs_);
     else
         drawLevelMeterMono(outNorm, OmbicLookAndFeel::ombicTeal(), "Out", outDisplayDb);
 }
@@ -2,25 +2,35 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
+#include <array>
 
 class OmbicCompressorProcessor;
 
-/** Horizontal strip: input level, gain reduction, output level. Dual ballistics (peak + VU average), peak hold, GR fast attack. */
+/** Horizontal strip: input level, gain reduction, output level. Dual ballistics (peak + VU average), peak hold, GR fast attack.
+ *  Driven by the editor's RenderScheduler; repaints only when a drawn value moves. */
 class MeterStrip : public juce::Component,
-                   private juce::Timer
+                   public RenderScheduler::Client
 {
 public:
     explicit MeterStrip(OmbicCompressorProcessor& processor);
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void renderTick(const RenderScheduler::Frame& frame) override;
 
 private:
-    void timerCallback() override;
+    static constexpr int kNumDrawnValues = 16;
+    std::array<float, kNumDrawnValues> drawnValues() const;
+    std::array<float, kNumDrawnValues> painted_{};
 
     OmbicCompressorProcessor& proc;
     juce::TextButton peakButton_;
     juce::TextButton vuButton_;
+    juce::TextButton truePeakButton_;  // peak mode: sample peak vs BS.1770 true peak (processor-wide)
+    juce::TextButton lufsButton_;
     bool showPeak_ = true;  // true = peak, false = VU (average)
+    bool showLufs_ = false; // when !showPeak_: loudness (momentary bar, short-term readout) instead of VU
+    void setDisplayMode(bool peak, bool lufs);
 
     // Level: peak (fast attack / slow release) + average (VU ~300 ms)
     float peakInDb_ = -60.0f;
@@ -29,6 +39,9 @@ private:
     float peakOutL_ = -60.0f, peakOutR_ = -60.0f;
     float avgInDb_ = -60.0f;
     float avgOutDb_ = -60.0f;
+    // Loudness (LUFS) from the processor; already windowed (400 ms / 3 s), shown without extra ballistics
+    float momentaryInLufs_ = -70.0f, shortTermInLufs_ = -70.0f;
+    float momentaryOutLufs_ = -70.0f, shortTermOutLufs_ = -70.0f;
     // Peak hold: 2 s at 45 Hz
     float peakHoldInDb_ = -60.0f;
     float peakHoldOutDb_ = -60.0f;
@@ -39,7 +52,6 @@ private:
     float grHoldDb_ = 0.0f;
     int grHoldTicks_ = 0;
 
-    static constexpr int kMeterHz = 45;
     static constexpr float kPeakAttackCoeff = 0.99f;   // ~5 ms
     static constexpr float kPeakReleaseCoeff = 0.054f;  // ~400 ms
     static constexpr float kVuCoeff = 0.071f;          // ~300 ms VU
@@ -1,8 +1,61 @@
 #include "OmbicLookAndFeel.h"
 #include "OmbicAssets.h"
+#include "CachedLayer.h"
+#include "PaintProfiler.h"
+#include <algorithm>
+#include <array>
+#include <list>
+#include <tuple>
+
+/** Message thread only (paint). */
+class OmbicLookAndFeel::KnobSpriteCache
+{
+public:
+    using Key = std::tuple<int, int, float, float, float, juce::uint32>;
+    static constexpr size_t kBudgetBytes = 16 * 1024 * 1024;
 
-juce::Typeface::Ptr OmbicLookAndFeel::s_trashBold;
-juce::Typeface::Ptr OmbicLookAndFeel::s_trashRegular;
+    /** Sprite for one value step of a knob style, rendered by render(image) on first use. */
+    template <typename RenderFn>
+    const juce::Image& get(const Key& key, int frame, int pixelWidth, int pixelHeight, RenderFn&& render)
+    {
+        auto it = std::find_if(sets_.begin(), sets_.end(), [&key](const SpriteSet& s) { return s.key == key; });
+        if (it == sets_.end())
+            sets_.emplace_front().key = key;
+        else if (it != sets_.begin())
+            sets_.splice(sets_.begin(), sets_, it);   // most recently used first
+
+        auto& set = sets_.front();
+        auto& sprite = set.frames[static_cast<size_t>(frame)];
+        if (!sprite.isValid())
+        {
+            sprite = juce::Image(juce::Image::ARGB, pixelWidth, pixelHeight, true);
+            render(sprite);
+            const auto bytes = static_cast<size_t>(pixelWidth) * static_cast<size_t>(pixelHeight) * 4;
+            set.bytes += bytes;
+            totalBytes_ += bytes;
+            // Never drops the set in use, so the returned reference stays valid
+            while (totalBytes_ > kBudgetBytes && sets_.size() > 1)
+            {
+                totalBytes_ -= sets_.back().bytes;
+                sets_.pop_back();
+            }
+        }
+        return sprite;
+    }
+
+private:
+    struct SpriteSet
+    {
+        Key key;
+        std::array<juce::Image, kKnobFrames> frames;
+        size_t bytes = 0;
+    };
+    std::list<SpriteSet> sets_;
+    size_t totalBytes_ = 0;
+};
+
+OmbicLookAndFeel::TypefaceSlot OmbicLookAndFeel::s_trashBold;
+OmbicLookAndFeel::TypefaceSlot OmbicLookAndFeel::s_trashRegular;
 
 OmbicLookAndFeel::OmbicLookAndFeel()
 {
@@ -14,6 +67,8 @@ OmbicLookAndFeel::OmbicLookAndFeel()
     setColour(juce::Slider::rotarySliderFillColourId, ombicBlue());
 }
 
+OmbicLookAndFeel::~OmbicLookAndFeel() = default;
+
 juce::File OmbicLookAndFeel::findStyleFolder()
 {
     juce::String dataPath = juce::SystemStats::getEnvironmentVariable("OMBIC_COMPRESSOR_DATA_PATH", {});
@@ -71,11 +126,14 @@ juce::File OmbicLookAndFeel::findFontFolder()
 
 juce::Typeface::Ptr OmbicLookAndFeel::loadTrashTypeface(bool bold)
 {
-    juce::Typeface::Ptr& cached = bold ? s_trashBold : s_trashRegular;
-    if (cached != nullptr)
-        return cached;
-
-    // 1) Try embedded fonts (only present if Plugin/fonts/Trash-*.ttf existed at build time)
+    // Resolved once per process, found or not: later editors never decode or probe the filesystem again
+    auto& slot = bold ? s_trashBold : s_trashRegular;
+    if (slot.resolved)
+        return slot.typeface;
+    slot.resolved = true;
+    juce::Typeface::Ptr& cached = slot.typeface;
+
+    // 1) Try embedded fonts (Plugin/fonts/ or style/ Trash-*.ttf at build time)
     int size = 0;
     const char* data = OmbicAssets::getNamedResource(bold ? "Trash_Bold_ttf" : "Trash_Regular_ttf", size);
     if (data != nullptr && size > 0)
@@ -103,6 +161,18 @@ juce::Typeface::Ptr OmbicLookAndFeel::loadTrashTypeface(bool bold)
     return cached;
 }
 
+juce::Image OmbicLookAndFeel::getLogoImage()
+{
+    // Decoded once per process (juce::ImageCache would drop it a few seconds after the last editor closes)
+    static const juce::Image logo = []
+    {
+        int size = 0;
+        const char* data = OmbicAssets::getNamedResource("Ombic_Alpha_png", size);
+        return (data != nullptr && size > 0) ? juce::ImageFileFormat::loadFrom(data, static_cast<size_t>(size)) : juce::Image();
+    }();
+    return logo;
+}
+
 juce::Font OmbicLookAndFeel::getOmbicFontForPainting(float height, bool bold)
 {
     juce::Typeface::Ptr tf = loadTrashTypeface(bold);
@@ -359,36 +429,60 @@ void OmbicLookAndFeel::drawLinearSlider(juce::Graphics& g, int x, int y, int wid
 void OmbicLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
                                         float sliderPos, float rotaryStartAngle, float rotaryEndAngle,
                                         juce::Slider& slider)
+{
+    OMBIC_PAINT_SCOPE(slider);
+    const juce::Colour accent = slider.findColour(juce::Slider::rotarySliderFillColourId);
+
+    if (!CachedLayer::isCachingEnabled())
+    {
+        juce::Graphics::ScopedSaveState save(g);
+        g.setOrigin(x, y);
+        drawKnob(g, static_cast<float>(width), static_cast<float>(height), sliderPos, rotaryStartAngle, rotaryEndAngle,
+                 accent);
+        return;
+    }
+
+    // One blit per repaint: the value is snapped to kKnobFrames steps (under 2 degrees of a 240 degree sweep) and
+    // each step is rendered into its sprite the first time it is shown.
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int frame = juce::jlimit(0, kKnobFrames - 1, juce::roundToInt(sliderPos * static_cast<float>(kKnobFrames - 1)));
+    const auto& sprite = knobSprites_->get({ width, height, rotaryStartAngle, rotaryEndAngle, scale, accent.getARGB() }, frame,
+                                           juce::jmax(1, juce::roundToInt(width * scale)),
+                                           juce::jmax(1, juce::roundToInt(height * scale)),
+                                           [&](juce::Image& image) {
+                                               juce::Graphics sg(image);
+                                               sg.addTransform(juce::AffineTransform::scale(scale));
+                                               drawKnob(sg, static_cast<float>(width), static_cast<float>(height),
+                                                        static_cast<float>(frame) / static_cast<float>(kKnobFrames - 1),
+                                                        rotaryStartAngle, rotaryEndAngle, accent);
+                                           });
+    g.drawImage(sprite, juce::Rectangle<int>(x, y, width, height).toFloat());
+}
+
+void OmbicLookAndFeel::drawKnob(juce::Graphics& g, float width, float height, float sliderPos,
+                                float startAngle, float endAngle, juce::Colour accent)
 {
     // GUIDE §2: Use slider's rotary angles (setRotaryParameters(-2.356f, 2.356f, true) = 240° sweep).
     // JUCE: 0 = 12 o'clock, positive = clockwise.
-    auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat();
-    auto centre = bounds.getCentre();
-    auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f - 4.0f;
+    const juce::Point<float> centre(width * 0.5f, height * 0.5f);
+    auto radius = juce::jmin(width, height) / 2.0f - 4.0f;
     auto lineW = (radius > 30.0f) ? 5.0f : 4.0f;
     auto arcRadius = radius - lineW * 0.5f;
 
-    auto toAngle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
-
-    juce::Colour accent = slider.findColour(juce::Slider::rotarySliderFillColourId);
+    auto toAngle = startAngle + sliderPos * (endAngle - startAngle);
 
     juce::Path trackArc;
-    trackArc.addCentredArc(centre.x, centre.y, arcRadius, arcRadius,
-                           0.0f, rotaryStartAngle, rotaryEndAngle, true);
+    trackArc.addCentredArc(centre.x, centre.y, arcRadius, arcRadius, 0.0f, startAngle, endAngle, true);
     g.setColour(knobTrack());
     g.strokePath(trackArc, juce::PathStrokeType(lineW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
 
     if (sliderPos > 0.005f)
     {
-        juce::Path glowArc;
-        glowArc.addCentredArc(centre.x, centre.y, arcRadius, arcRadius,
-                              0.0f, rotaryStartAngle, toAngle, true);
-        g.setColour(accent.withAlpha(0.15f));
-        g.strokePath(glowArc, juce::PathStrokeType(lineW + 6.0f, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-
         juce::Path valueArc;
         valueArc.addCentredArc(centre.x, centre.y, arcRadius, arcRadius,
-                              0.0f, rotaryStartAngle, toAngle, true);
+                              0.0f, startAngle, toAngle, true);
+        g.setColour(accent.withAlpha(0.15f));
+        g.strokePath(valueArc, juce::PathStrokeType(lineW + 6.0f, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
         g.setColour(accent);
         g.strokePath(valueArc, juce::PathStrokeType(lineW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
     }
@@ -7,10 +7,14 @@ class OmbicLookAndFeel : public juce::LookAndFeel_V4
 {
 public:
     OmbicLookAndFeel();
+    ~OmbicLookAndFeel() override;
 
     /** Font for custom paint: Trash from embedded fonts/ or style/ when available. */
     static juce::Font getOmbicFontForPainting(float height, bool bold);
 
+    /** Logo watermark (embedded Ombic_Alpha.png), decoded on first use and shared by every editor. */
+    static juce::Image getLogoImage();
+
     // Brand accents
     static juce::Colour ombicRed()    { return juce::Colour(0xFFff001f); }
     static juce::Colour ombicBlue()   { return juce::Colour(0xFF076dc3); }
@@ -61,13 +65,29 @@ public:
     int getSliderThumbRadius(juce::Slider&) override { return 8; }
 
 private:
+    /** Whole knob (track, value arc + glow, body, pointer) in a width x height box at the origin. */
+    static void drawKnob(juce::Graphics& g, float width, float height, float sliderPos,
+                         float startAngle, float endAngle, juce::Colour accent);
+
+    // Knob sprites: per (width, height, sweep, physical scale, accent ARGB), kKnobFrames value steps, each rendered
+    // on first use. One cache for every OmbicLookAndFeel in the process (each section has its own), bounded in
+    // bytes: sizes no longer shown (after a resize or a display scale change) are dropped least recently used first.
+    static constexpr int kKnobFrames = 128;
+    class KnobSpriteCache;
+    juce::SharedResourcePointer<KnobSpriteCache> knobSprites_;
+
     static juce::File findStyleFolder();
     /** Directory containing Trash-Bold.ttf / Trash-Regular.ttf (e.g. Plugin/fonts/, OMBIC_FONT_PATH). */
     static juce::File findFontFolder();
     static juce::Typeface::Ptr loadTrashTypeface(bool bold);
 
-    static juce::Typeface::Ptr s_trashBold;
-    static juce::Typeface::Ptr s_trashRegular;
+    struct TypefaceSlot
+    {
+        juce::Typeface::Ptr typeface;
+        bool resolved = false;   // looked up already (typeface may still be null: system font fallback)
+    };
+    static TypefaceSlot s_trashBold;
+    static TypefaceSlot s_trashRegular;
 
     juce::Font getOmbicFont(float height, float weight = 700.0f);
 };
@@ -1,23 +1,35 @@
 #include "OutputSection.h"
 #include "../PluginProcessor.h"
+#include "PaintProfiler.h"
 
 static float levelToNorm(float db)
 {
     return juce::jlimit(0.0f, 1.0f, (db + 60.0f) / 60.0f);
 }
 
-OutputSection::LevelMeterComponent::LevelMeterComponent(OmbicCompressorProcessor& p, bool isInput)
-    : proc_(&p), isInput_(isInput) {}
+OutputSection::LevelMeterComponent::LevelMeterComponent(bool isInput)
+    : isInput_(isInput) {}
 
-void OutputSection::LevelMeterComponent::paint(juce::Graphics& g)
+void OutputSection::LevelMeterComponent::tick(float rawDb)
 {
-    float rawDb = isInput_ ? proc_->inputPeakDb.load() : proc_->outputPeakDb.load();
     if (rawDb > peakDb_)
         peakDb_ += kPeakAttackCoeff * (rawDb - peakDb_);
     else
         peakDb_ += kPeakReleaseCoeff * (rawDb - peakDb_);
     if (peakDb_ >= peakHoldDb_) { peakHoldDb_ = peakDb_; peakHoldTicks_ = kPeakHoldTicks; }
     else { if (peakHoldTicks_ > 0) --peakHoldTicks_; if (peakHoldTicks_ <= 0) peakHoldDb_ += kPeakReleaseCoeff * (peakDb_ - peakHoldDb_); }
+    if (RenderScheduler::exceeds(peakDb_, paintedDb_, RenderScheduler::kMeterThresholdDb)
+        || RenderScheduler::exceeds(peakHoldDb_, paintedHoldDb_, RenderScheduler::kMeterThresholdDb))
+    {
+        paintedDb_ = peakDb_;
+        paintedHoldDb_ = peakHoldDb_;
+        repaint();
+    }
+}
+
+void OutputSection::LevelMeterComponent::paint(juce::Graphics& g)
+{
+    OMBIC_PAINT_SCOPE(*this);
     float norm = levelToNorm(peakDb_);
     auto b = getLocalBounds().toFloat();
     g.setColour(OmbicLookAndFeel::pluginBg());
@@ -41,8 +53,8 @@ void OutputSection::LevelMeterComponent::paint(juce::Graphics& g)
 
 OutputSection::OutputSection(OmbicCompressorProcessor& processor)
     : proc(processor)
-    , inMeter_(processor, true)
-    , outMeter_(processor, false)
+    , inMeter_(true)
+    , outMeter_(false)
 {
     setLookAndFeel(&ombicLf);
 
@@ -124,9 +136,11 @@ void OutputSection::setHighlight(bool on)
     if (highlighted_ != on) { highlighted_ = on; repaint(); }
 }
 
-void OutputSection::updateGrReadout()
+void OutputSection::renderTick(const RenderScheduler::Frame& frame)
 {
-    float grDb = proc.gainReductionDb.load();
+    inMeter_.tick(frame.meters[emulation::MeterBus::InputPeak]);
+    outMeter_.tick(frame.meters[emulation::MeterBus::OutputPeak]);
+    float grDb = frame.meters[emulation::MeterBus::GainReduction];
     if (grDb > smoothedGrDb_)
         smoothedGrDb_ += kGrAttackCoeff * (grDb - smoothedGrDb_);
     else
@@ -141,10 +155,14 @@ void OutputSection::updateGrReadout()
         grReadoutLabel_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicYellow());
     else
         grReadoutLabel_.setColour(juce::Label::textColourId, OmbicLookAndFeel::ombicRed());
+    const float autoDb = proc.autoGainDb.load();
+    autoGainButton.setTooltip("Loudness-matched makeup (input vs output short-term LUFS): currently "
+                              + juce::String(autoDb >= 0.0f ? "+" : "") + juce::String(autoDb, 1) + " dB");
 }
 
 void OutputSection::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     auto b = getLocalBounds().toFloat();
     g.setColour(OmbicLookAndFeel::pluginSurface());
     g.fillRoundedRectangle(b, 16.0f);
@@ -2,11 +2,13 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
 
 class OmbicCompressorProcessor;
 
 /** Output-stage gain (makeup). Spec §8: IN meter | Output knob | OUT meter, GR readout below. */
-class OutputSection : public juce::Component
+class OutputSection : public juce::Component,
+                      public RenderScheduler::Client
 {
 public:
     explicit OutputSection(OmbicCompressorProcessor& processor);
@@ -21,8 +23,8 @@ public:
     juce::Slider& getIronSlider() { return ironSlider; }
     juce::ToggleButton& getAutoGainButton() { return autoGainButton; }
 
-    /** Call from editor timer to refresh GR readout. */
-    void updateGrReadout();
+    /** IN/OUT meters and GR readout from the scheduler's frame. */
+    void renderTick(const RenderScheduler::Frame& frame) override;
 
 private:
     bool highlighted_ = false;
@@ -34,12 +36,14 @@ private:
     class LevelMeterComponent : public juce::Component
     {
     public:
-        LevelMeterComponent(OmbicCompressorProcessor& p, bool isInput);
+        explicit LevelMeterComponent(bool isInput);
         void paint(juce::Graphics& g) override;
+        /** Ballistics for one tick; repaints only if the bar or hold line moved. */
+        void tick(float rawDb);
     private:
-        OmbicCompressorProcessor* proc_;
         bool isInput_;
         float peakDb_ = -60.0f;
+        float paintedDb_ = -100.0f, paintedHoldDb_ = -100.0f;
         float peakHoldDb_ = -60.0f;
         int peakHoldTicks_ = 0;
         static constexpr float kPeakAttackCoeff = 0.99f;
@@ -0,0 +1,75 @@
+#include "PaintProfiler.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    /** Every live profiler; a handful at most (one per open editor). */
+    std::vector<PaintProfiler*>& profilers()
+    {
+        static std::vector<PaintProfiler*> all;
+        return all;
+    }
+}
+
+PaintProfiler::PaintProfiler(const juce::Component& owner)
+    : owner_(owner)
+{
+    profilers().push_back(this);
+}
+
+PaintProfiler::~PaintProfiler()
+{
+    auto& all = profilers();
+    all.erase(std::remove(all.begin(), all.end(), this), all.end());
+}
+
+PaintProfiler* PaintProfiler::find(const juce::Component& component) noexcept
+{
+    const auto& all = profilers();
+    for (auto* c = &component; c != nullptr; c = c->getParentComponent())
+        for (auto* p : all)
+            if (&p->owner_ == c)
+                return p;
+    return nullptr;
+}
+
+void PaintProfiler::endFrame() noexcept
+{
+    if (frameTicks_ <= 0)
+        return;
+    static const double nsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    ns_[static_cast<size_t>(written_ % kHistory)] = static_cast<double>(frameTicks_) * nsPerTick;
+    ++written_;
+    frameTicks_ = 0;
+}
+
+emulation::StageProfiler::Stats PaintProfiler::getStats() const noexcept
+{
+    emulation::StageProfiler::Stats st;
+    const int count = juce::jmin(written_, kHistory);
+    if (count == 0)
+        return st;
+
+    std::array<double, kHistory> ns = ns_;
+    auto begin = ns.begin(), end = ns.begin() + count;
+    const auto [mn, mx] = std::minmax_element(begin, end);
+    double sum = 0.0;
+    for (auto it = begin; it != end; ++it)
+        sum += *it;
+    st.blocks = count;
+    st.minNs = *mn;
+    st.maxNs = *mx;
+    st.avgNs = sum / count;
+    auto p99 = begin + juce::jmin(count - 1, (count * 99) / 100);
+    std::nth_element(begin, p99, end);
+    st.p99Ns = *p99;
+    return st;
+}
+
+void PaintProfiler::reset() noexcept
+{
+    frameTicks_ = 0;
+    ns_ = {};
+    written_ = 0;
+}
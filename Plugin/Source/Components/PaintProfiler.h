@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Emulation/StageProfiler.h"
+#include <array>
+
+/** GUI paint time per rendered frame, for the stage timing overlay. One per editor (its RenderScheduler owns it),
+ *  so two open editors never mix into one frame. paint() implementations open an OMBIC_PAINT_SCOPE(component),
+ *  which charges the time to the profiler of the editor that component sits in; the RenderScheduler closes the
+ *  frame once per tick, summing every paint since the previous tick into one entry of a rolling window. Frames where
+ *  nothing painted are not recorded.
+ *
+ *  Compiled in with OMBIC_STAGE_PROFILING, like the DSP stage timers; otherwise the macro is empty and nothing is
+ *  recorded. Message thread only. */
+class PaintProfiler
+{
+public:
+    static constexpr int kHistory = 256;   // frames per rolling window (~6 s at 45 Hz)
+
+    /** owner: the editor whose paints (its own and its children's) this profiler records. */
+    explicit PaintProfiler(const juce::Component& owner);
+    ~PaintProfiler();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const juce::Component& painted) noexcept
+            : profiler_(find(painted)), start_(juce::Time::getHighResolutionTicks()) {}
+        ~Scope() noexcept
+        {
+            if (profiler_ != nullptr)
+                profiler_->frameTicks_ += juce::Time::getHighResolutionTicks() - start_;
+        }
+
+    private:
+        PaintProfiler* profiler_;
+        juce::int64 start_;
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    /** RenderScheduler: close the current frame. */
+    void endFrame() noexcept;
+
+    /** min / avg / p99 / max paint time per frame over the window; blocks = frames. avgNsPerSample is unused. */
+    emulation::StageProfiler::Stats getStats() const noexcept;
+
+    void reset() noexcept;
+
+    /** Profiler of the editor that is, or contains, the component; nullptr outside a profiled editor. */
+    static PaintProfiler* find(const juce::Component& component) noexcept;
+
+private:
+    const juce::Component& owner_;
+    juce::int64 frameTicks_ = 0;   // paints since the last endFrame()
+    std::array<double, kHistory> ns_{};
+    int written_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(PaintProfiler)
+};
+
+#if OMBIC_STAGE_PROFILING
+ #define OMBIC_PAINT_SCOPE(component) const PaintProfiler::Scope JUCE_JOIN_MACRO(ombicPaintScope_, __LINE__)(component)
+#else
+ #define OMBIC_PAINT_SCOPE(component)
+#endif
@@ -0,0 +1,52 @@
+#include "RenderScheduler.h"
+#include "../PluginProcessor.h"
+#include <algorithm>
+
+RenderScheduler::RenderScheduler(juce::Component& owner, OmbicCompressorProcessor& processor)
+    : processor_(processor)
+    , meterReader_(processor.getMeterBus())
+    , paintProfiler_(owner)
+    , vblank_(&owner, [this] { vblank(); })
+{
+}
+
+void RenderScheduler::addClient(Client& client)
+{
+    if (std::find(clients_.begin(), clients_.end(), &client) == clients_.end())
+        clients_.push_back(&client);
+}
+
+void RenderScheduler::removeClient(Client& client)
+{
+    clients_.erase(std::remove(clients_.begin(), clients_.end(), &client), clients_.end());
+}
+
+void RenderScheduler::vblank()
+{
+    // Tick on the first vblank at (or just before) the next 45 Hz slot; a couple of ms of slack absorbs vblank jitter.
+    constexpr double periodMs = 1000.0 / kTickHz;
+    constexpr double slackMs = 2.0;
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (nowMs + slackMs < nextTickMs_)
+        return;
+    nextTickMs_ = (nowMs - nextTickMs_ > periodMs) ? nowMs + periodMs : nextTickMs_ + periodMs;
+
+#if OMBIC_STAGE_PROFILING
+    paintProfiler_.endFrame();   // everything painted since the previous tick is one frame
+#endif
+
+    Frame frame;
+    frame.meters = meterReader_.read();
+    frame.inputRmsDb = processor_.inputLevelDb.load();
+    frame.outputRmsDb = processor_.outputLevelDb.load();
+
+    if (onTick)
+        onTick(frame);
+    for (auto* client : clients_)
+    {
+        // Hidden views (e.g. the Tube/Arc view not selected) skip their ballistics and repaints entirely
+        if (auto* c = dynamic_cast<juce::Component*>(client); c != nullptr && !c->isShowing())
+            continue;
+        client->renderTick(frame);
+    }
+}
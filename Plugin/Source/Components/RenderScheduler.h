@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Emulation/MeterBus.h"
+#include "PaintProfiler.h"
+#include <functional>
+#include <vector>
+
+class OmbicCompressorProcessor;
+
+/** One per editor: drives every animated component from the display's vertical blank (juce::VBlankAttachment)
+ *  instead of per-component timers. Each tick polls the processor's meter bus once (per-value max since the previous
+ *  tick) and hands that frame to the registered clients, which update their ballistics and repaint only what moved
+ *  by more than their display threshold.
+ *
+ *  Ticks are paced to kTickHz on whichever vblank comes due, because meter ballistics and hold counts are tuned per
+ *  45 Hz tick; 60/120/144 Hz displays therefore show the same meter motion. No vblank (editor hidden or closed)
+ *  means no work at all. */
+class RenderScheduler
+{
+public:
+    static constexpr int kTickHz = 45;
+
+    struct Frame
+    {
+        emulation::MeterBus::Frame meters;   // per-value max since the previous tick
+        float inputRmsDb = -60.0f;
+        float outputRmsDb = -60.0f;
+    };
+
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        virtual void renderTick(const Frame& frame) = 0;
+    };
+
+    /** owner: the editor (its peer's vblank drives the ticks). Declare the scheduler after its clients so it is
+     *  destroyed first. */
+    RenderScheduler(juce::Component& owner, OmbicCompressorProcessor& processor);
+
+    void addClient(Client& client);
+    void removeClient(Client& client);
+
+    /** Editor-level per-tick work (layout, pills, visibility), run before the clients. */
+    std::function<void(const Frame&)> onTick;
+
+    /** Shared repaint test: true when a displayed value moved by more than threshold. */
+    static bool exceeds(float a, float b, float threshold) noexcept { return std::abs(a - b) > threshold; }
+
+    /** Meter values (dB) closer than this to what was last painted are not worth a repaint (well under a pixel on
+     *  every meter in the editor). */
+    static constexpr float kMeterThresholdDb = 0.1f;
+
+    /** This editor's paint time per tick (OMBIC_STAGE_PROFILING builds; empty otherwise). */
+    PaintProfiler& getPaintProfiler() noexcept { return paintProfiler_; }
+
+private:
+    void vblank();
+
+    OmbicCompressorProcessor& processor_;
+    emulation::MeterBus::Reader meterReader_;
+    std::vector<Client*> clients_;
+    PaintProfiler paintProfiler_;
+    double nextTickMs_ = 0.0;
+    juce::VBlankAttachment vblank_;   // last: may call back as soon as it exists
+
+    JUCE_DECLARE_NON_COPYABLE(RenderScheduler)
+};
@@ -1,12 +1,33 @@
 #include "SaturatorSection.h"
 #include "../PluginProcessor.h"
-#include <vector>
+#include "PaintProfiler.h"
 
 SaturatorSection::ScopeComponent::ScopeComponent(OmbicCompressorProcessor& processor, juce::Slider& drive, juce::Slider& intensity,
                                                    juce::Slider& tone, juce::Slider& mix)
     : proc_(&processor), driveSlider_(&drive), intensitySlider_(&intensity), toneSlider_(&tone), mixSlider_(&mix) {}
 
-void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
+juce::Rectangle<float> SaturatorSection::ScopeComponent::getTubeArea() const
+{
+    // Less compact: use more of the area (smaller padding, taller tube, more vertical range)
+    auto plotArea = getLocalBounds().toFloat().reduced(8.0f, 6.0f);
+    const float tubeH = 42.0f;
+    return { plotArea.getX() + 4.0f, plotArea.getCentreY() - tubeH * 0.5f, plotArea.getWidth() - 8.0f, tubeH };
+}
+
+void SaturatorSection::ScopeComponent::resized()
+{
+    const auto tube = getTubeArea();
+    tubeClipPath_.clear();
+    tubeClipPath_.addRoundedRectangle(tube, tube.getHeight() * 0.5f);
+    // One min/max column per pixel of the widest trace (the Listen plot area)
+    if (proc_)
+    {
+        const int columns = juce::roundToInt(getLocalBounds().toFloat().reduced(8.0f, 6.0f).getWidth());
+        proc_->getScopeSidechain().setNumColumns(columns);
+        proc_->getScopeWaveform().setNumColumns(columns);
+    }
+}
+void SaturatorSection::ScopeComponent::paintBackground(juce::Graphics& g, bool listening) const
 {
     auto b = getLocalBounds().toFloat();
     // NEON_BULB_GUI_SPEC: background #080a12, border 1px pluginBorder, 10px radius
@@ -15,37 +36,39 @@ void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
     g.setColour(OmbicLookAndFeel::pluginBorder());
     g.drawRoundedRectangle(b.reduced(0.5f), 10.0f, 1.0f);
 
-    auto plotArea = b.reduced(8.0f, 6.0f);
-
-    // When SC Listen is on, show real sidechain signal (teal); otherwise tube + filament (Option 5)
-    std::vector<float> sidechainSamples;
-    if (proc_ && proc_->isScListenActive() && proc_->getScopeSidechainSamples(sidechainSamples) && sidechainSamples.size() > 1)
+    if (listening)
     {
         g.setColour(OmbicLookAndFeel::ombicTeal().withAlpha(0.04f));
         g.fillRoundedRectangle(b.reduced(3.0f), 7.0f);
+        return;
+    }
+
+    // Tube outline: horizontal pill, stroke only (pluginBorder, ~0.6 alpha)
+    const auto tube = getTubeArea();
+    g.setColour(OmbicLookAndFeel::pluginBorder().withAlpha(0.6f));
+    g.drawRoundedRectangle(tube, tube.getHeight() * 0.5f, 1.5f);
+}
+
+void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
+{
+    OMBIC_PAINT_SCOPE(*this);
+    auto plotArea = getLocalBounds().toFloat().reduced(8.0f, 6.0f);
+
+    // When SC Listen is on, show real sidechain signal (teal); otherwise tube + filament (Option 5)
+    const bool listening = proc_ && proc_->isScListenActive() && strip_.read(proc_->getScopeSidechain());
+    background_.draw(g, getLocalBounds(), listening ? 1 : 0, [this, listening](juce::Graphics& lg) { paintBackground(lg, listening); });
 
-        juce::Path path;
-        const size_t n = sidechainSamples.size();
-        const float w = plotArea.getWidth();
+    if (listening)
+    {
         const float yMid = plotArea.getCentreY();
         const float amp = plotArea.getHeight() * 0.4f;
-        float peak = 1e-6f;
-        for (size_t i = 0; i < n; ++i)
-            peak = juce::jmax(peak, std::abs(sidechainSamples[i]));
+        const float peak = strip_.peak();
         const float scale = (peak > 1e-6f) ? (amp / peak) : amp;
-        for (size_t i = 0; i < n; ++i)
-        {
-            float t = static_cast<float>(i) / static_cast<float>(n - 1);
-            float x = plotArea.getX() + t * w;
-            float y = yMid - sidechainSamples[i] * scale;
-            if (i == 0)
-                path.startNewSubPath(x, y);
-            else
-                path.lineTo(x, y);
-        }
+        const auto path = strip_.buildPath(plotArea.getX(), plotArea.getWidth(), [=](float v) { return yMid - v * scale; });
         g.setColour(OmbicLookAndFeel::ombicTeal().withAlpha(0.2f));
         g.strokePath(path, juce::PathStrokeType(8.0f));
         g.setColour(OmbicLookAndFeel::ombicTeal().withAlpha(0.85f));
+        g.fillPath(path);
         g.strokePath(path, juce::PathStrokeType(2.0f));
         return;
     }
@@ -55,22 +78,12 @@ void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
     const float intensity = intensitySlider_ ? static_cast<float>(intensitySlider_->getValue()) : 0.5f;
     const float mix = mixSlider_ ? static_cast<float>(mixSlider_->getValue()) : 1.0f;
 
-    // Less compact: use more of the area (smaller padding, taller tube, more vertical range)
-    const float tubeH = 42.0f;
-    const float tubeRadius = tubeH * 0.5f;
-    const float tubeY = plotArea.getCentreY() - tubeRadius;
-    const float tubeX = plotArea.getX() + 4.0f;
-    const float tubeW = plotArea.getWidth() - 8.0f;
+    const auto tube = getTubeArea();
+    const float tubeX = tube.getX();
+    const float tubeW = tube.getWidth();
     const float yMid = plotArea.getCentreY();
     const float amp = 18.0f;
 
-    // Tube outline: horizontal pill, stroke only (pluginBorder, ~0.6 alpha)
-    g.setColour(OmbicLookAndFeel::pluginBorder().withAlpha(0.6f));
-    g.drawRoundedRectangle(tubeX, tubeY, tubeW, tubeH, tubeRadius, 1.5f);
-
-    juce::Path tubeClipPath;
-    tubeClipPath.addRoundedRectangle(tubeX, tubeY, tubeW, tubeH, tubeRadius);
-
     // Neon pink for filament (never use teal/blue here — this is the saturation display)
     const juce::Colour neonPink(0xFFe85590);
 
@@ -78,51 +91,24 @@ void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
     const float kSilenceThreshold = 1e-4f;
 
     juce::Path filamentPath;
-    std::vector<float> waveformSamples;
     bool hasRealSignal = false;
+    bool filled = false;
     float peak = 0.0f;
-    if (proc_ && proc_->getScopeWaveformSamples(waveformSamples) && waveformSamples.size() > 1)
+    if (proc_ && strip_.read(proc_->getScopeWaveform()))
     {
-        const size_t n = waveformSamples.size();
-        for (size_t i = 0; i < n; ++i)
-            peak = juce::jmax(peak, std::abs(waveformSamples[i]));
+        peak = strip_.peak();
         hasRealSignal = (peak >= kSilenceThreshold);
     }
 
     if (hasRealSignal)
     {
-        // Real waveform: normalize by peak, apply display drive, optional light smoothing to reduce noise jitter
-        const size_t n = waveformSamples.size();
+        // Real waveform envelope: normalize by peak, apply display drive, light smoothing across columns to reduce noise jitter
         const float displayGain = 1.0f + drive * 4.0f;
         const float displayNorm = std::tanh(displayGain);
-        const int smoothHalf = 1;  // 3-point running average to reduce noise jitter
-        for (size_t i = 0; i < n; ++i)
-        {
-            float s = waveformSamples[i] / (peak + 1e-9f);
-            if (smoothHalf > 0 && n > static_cast<size_t>(smoothHalf * 2))
-            {
-                float sum = 0.0f;
-                int count = 0;
-                for (int d = -smoothHalf; d <= smoothHalf; ++d)
-                {
-                    int j = static_cast<int>(i) + d;
-                    if (j >= 0 && j < static_cast<int>(n))
-                    {
-                        sum += waveformSamples[static_cast<size_t>(j)] / (peak + 1e-9f);
-                        ++count;
-                    }
-                }
-                s = count > 0 ? sum / static_cast<float>(count) : s;
-            }
-            float displayed = std::tanh(s * displayGain) / displayNorm;
-            float t = static_cast<float>(i) / static_cast<float>(n - 1);
-            float x = tubeX + t * tubeW;
-            float yPos = yMid - displayed * amp;
-            if (i == 0)
-                filamentPath.startNewSubPath(x, yPos);
-            else
-                filamentPath.lineTo(x, yPos);
-        }
+        const float norm = 1.0f / (peak + 1e-9f);
+        strip_.smooth();
+        filamentPath = strip_.buildPath(tubeX, tubeW, [=](float v) { return yMid - std::tanh(v * norm * displayGain) / displayNorm * amp; });
+        filled = true;
     }
     else
     {
@@ -151,7 +137,7 @@ void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
 
     // Confine waveform to the tube so it never spills outside the pill
     g.saveState();
-    g.reduceClipRegion(tubeClipPath);
+    g.reduceClipRegion(tubeClipPath_);
 
     if (glowOpacity > 0.001f)
     {
@@ -161,6 +147,8 @@ void SaturatorSection::ScopeComponent::paint(juce::Graphics& g)
     if (lineOpacity > 0.001f)
     {
         g.setColour(neonPink.withAlpha(lineOpacity));
+        if (filled)
+            g.fillPath(filamentPath);   // min/max envelope band
         g.strokePath(filamentPath, juce::PathStrokeType(lineStrokeWidth));
     }
 
@@ -345,7 +333,19 @@ void SaturatorSection::mouseExit(const juce::MouseEvent&)
     if (hovered_) { hovered_ = false; repaint(); }
 }
 
+void SaturatorSection::lookAndFeelChanged()
+{
+    background_.invalidate();
+}
+
 void SaturatorSection::paint(juce::Graphics& g)
+{
+    OMBIC_PAINT_SCOPE(*this);
+    // Panel, header gradient and title only change with size or scope visibility (title text)
+    background_.draw(g, getLocalBounds(), scopeVisible_ ? 1 : 0, [this](juce::Graphics& lg) { paintBackground(lg); });
+}
+
+void SaturatorSection::paintBackground(juce::Graphics& g) const
 {
     auto b = getLocalBounds().toFloat();
     g.setColour(OmbicLookAndFeel::pluginSurface());
@@ -365,12 +365,19 @@ void SaturatorSection::paint(juce::Graphics& g)
     g.drawText(scopeVisible_ ? "NEON BULB SATURATION" : "NEON", static_cast<int>(headerRect.getX()) + 12, static_cast<int>((headerH - 13.0f) * 0.5f), 220, 14, juce::Justification::left);
 }
 
+void SaturatorSection::renderTick(const RenderScheduler::Frame&)
+{
+    if (scopeVisible_ && scopeComponent_.isShowing())
+        scopeComponent_.repaint();
+}
+
 void SaturatorSection::setScopeVisible(bool visible)
 {
     if (scopeVisible_ == visible) return;
     scopeVisible_ = visible;
     scopeComponent_.setVisible(visible);
     resized();
+    repaint();
 }
 
 void SaturatorSection::resized()
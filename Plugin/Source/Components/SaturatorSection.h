@@ -2,17 +2,22 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
+#include "CachedLayer.h"
+#include "ScopeStrip.h"
 
 class OmbicCompressorProcessor;
 
 /** Neon bulb saturator controls: drive, intensity, tone, mix. */
-class SaturatorSection : public juce::Component
+class SaturatorSection : public juce::Component,
+                         public RenderScheduler::Client
 {
 public:
     explicit SaturatorSection(OmbicCompressorProcessor& processor);
     ~SaturatorSection() override;
     void resized() override;
     void paint(juce::Graphics& g) override;
+    void lookAndFeelChanged() override;
 
     void mouseEnter(const juce::MouseEvent&) override;
     void mouseExit(const juce::MouseEvent&) override;
@@ -36,6 +41,9 @@ public:
     bool isInteracting() const;
     void setHighlight(bool on);
 
+    /** Repaints the scope (live waveform) when it is on screen; the rest of the section is static. */
+    void renderTick(const RenderScheduler::Frame& frame) override;
+
 private:
     class ScopeComponent : public juce::Component
     {
@@ -43,7 +51,15 @@ private:
         ScopeComponent(OmbicCompressorProcessor& processor, juce::Slider& drive, juce::Slider& intensity,
                       juce::Slider& tone, juce::Slider& mix);
         void paint(juce::Graphics& g) override;
+        void resized() override;
+        void lookAndFeelChanged() override { background_.invalidate(); }
     private:
+        juce::Rectangle<float> getTubeArea() const;
+        void paintBackground(juce::Graphics& g, bool listening) const;
+
+        CachedLayer background_;   // panel + border, and the tube outline (tint when Listen is on)
+        ScopeStrip strip_;         // latest min/max columns (sidechain or output)
+        juce::Path tubeClipPath_;  // filament clip, rebuilt on resize
         OmbicCompressorProcessor* proc_ = nullptr;
         juce::Slider* driveSlider_ = nullptr;
         juce::Slider* intensitySlider_ = nullptr;
@@ -51,6 +67,9 @@ private:
         juce::Slider* mixSlider_ = nullptr;
     };
 
+    void paintBackground(juce::Graphics& g) const;
+
+    CachedLayer background_;
     bool hovered_ = false;
     bool highlighted_ = false;
     bool scopeVisible_ = true;
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Emulation/ScopeColumns.h"
+#include <array>
+
+/** Per-column min/max read from an emulation::ScopeColumns, drawn as one closed band: the max edge left to right,
+ *  then the min edge back. Filling the band shows the full sample envelope under every pixel; stroking it gives the
+ *  glow. Vertex count is 2 * columns (the scope's width) however large the audio block was. Message thread only. */
+class ScopeStrip
+{
+public:
+    /** Copy the latest columns; returns false if there are fewer than two (nothing to draw). */
+    bool read(const emulation::ScopeColumns& source)
+    {
+        count_ = source.read(mins_.data(), maxs_.data(), emulation::ScopeColumns::kMaxColumns);
+        return count_ > 1;
+    }
+
+    int size() const noexcept { return count_; }
+
+    /** Largest absolute value over all columns. */
+    float peak() const noexcept
+    {
+        float p = 0.0f;
+        for (int i = 0; i < count_; ++i)
+            p = juce::jmax(p, std::abs(mins_[static_cast<size_t>(i)]), std::abs(maxs_[static_cast<size_t>(i)]));
+        return p;
+    }
+
+    /** 3-point running average of each edge across neighbouring columns (steadies noise jitter). */
+    void smooth() noexcept
+    {
+        smoothEdge(mins_);
+        smoothEdge(maxs_);
+    }
+
+    /** Closed band spanning x .. x + width; toY maps a column value to a y coordinate. */
+    template <typename ToY>
+    juce::Path buildPath(float x, float width, ToY&& toY) const
+    {
+        juce::Path path;
+        if (count_ < 2)
+            return path;
+        path.preallocateSpace(4 * count_ + 4);
+        const float dx = width / static_cast<float>(count_ - 1);
+        path.startNewSubPath(x, toY(maxs_[0]));
+        for (int i = 1; i < count_; ++i)
+            path.lineTo(x + dx * static_cast<float>(i), toY(maxs_[static_cast<size_t>(i)]));
+        for (int i = count_; --i >= 0;)
+            path.lineTo(x + dx * static_cast<float>(i), toY(mins_[static_cast<size_t>(i)]));
+        path.closeSubPath();
+        return path;
+    }
+
+private:
+    using Edge = std::array<float, emulation::ScopeColumns::kMaxColumns>;
+
+    void smoothEdge(Edge& e) noexcept
+    {
+        if (count_ < 3)
+            return;
+        float prev = e[0];
+        for (int i = 1; i < count_ - 1; ++i)
+        {
+            const float cur = e[static_cast<size_t>(i)];
+            e[static_cast<size_t>(i)] = (prev + cur + e[static_cast<size_t>(i + 1)]) * (1.0f / 3.0f);
+            prev = cur;
+        }
+    }
+
+    Edge mins_{};
+    Edge maxs_{};
+    int count_ = 0;
+};
@@ -1,14 +1,70 @@
 #include "SidechainFilterSection.h"
 #include "../PluginProcessor.h"
 #include <cmath>
+#include "PaintProfiler.h"
 
 //==============================================================================
-SidechainFilterSection::FrequencyResponseDisplay::FrequencyResponseDisplay(OmbicCompressorProcessor&)
+SidechainFilterSection::FrequencyResponseDisplay::FrequencyResponseDisplay(OmbicCompressorProcessor& p)
+    : analyser_(p.getSpectrumAnalyser())
+    , spectrumConsumer_(analyser_)
 {
+    for (auto& b : bands_)
+    {
+        b.levelDb.fill(Analyser::kFloorDb);
+        b.peakDb.fill(Analyser::kFloorDb);
+    }
+    setTooltip("Spectra: teal = sidechain (what the detector hears), blue = input, grey = output. Line = HPF response.");
+}
+
+bool SidechainFilterSection::FrequencyResponseDisplay::updateSpectra()
+{
+    bool changed = false;
+    for (int s = 0; s < Analyser::NumSources; ++s)
+    {
+        const auto source = static_cast<Analyser::Source>(s);
+        if (analyser_.getVersion(source) == versions_[static_cast<size_t>(s)])
+            continue;
+        versions_[static_cast<size_t>(s)] = analyser_.getBands(source, bands_[static_cast<size_t>(s)]);
+        changed = true;
+    }
+    return changed;
+}
+
+void SidechainFilterSection::FrequencyResponseDisplay::paintSpectra(juce::Graphics& g, juce::Rectangle<float> area) const
+{
+    // Spectra use their own scale (-90..0 dBFS over the full height); bands are already log-spaced 20 Hz..20 kHz.
+    const float specDbMin = -90.0f;
+    auto bandPath = [&area, specDbMin](const std::array<float, Analyser::kNumBands>& db) {
+        juce::Path p;
+        for (int i = 0; i < Analyser::kNumBands; ++i)
+        {
+            const float x = area.getX() + area.getWidth() * static_cast<float>(i) / static_cast<float>(Analyser::kNumBands - 1);
+            const float t = juce::jlimit(0.0f, 1.0f, db[static_cast<size_t>(i)] / specDbMin);
+            const float y = area.getY() + t * area.getHeight();
+            if (i == 0) p.startNewSubPath(x, y);
+            else p.lineTo(x, y);
+        }
+        return p;
+    };
+
+    const auto& sc = bands_[Analyser::Sidechain];
+    juce::Path fill = bandPath(sc.levelDb);
+    fill.lineTo(area.getRight(), area.getBottom());
+    fill.lineTo(area.getX(), area.getBottom());
+    fill.closeSubPath();
+    g.setColour(OmbicLookAndFeel::ombicTeal().withAlpha(0.18f));
+    g.fillPath(fill);
+    g.setColour(OmbicLookAndFeel::ombicTeal().withAlpha(0.35f));
+    g.strokePath(bandPath(sc.peakDb), juce::PathStrokeType(0.8f));
+    g.setColour(OmbicLookAndFeel::ombicBlue().withAlpha(0.45f));
+    g.strokePath(bandPath(bands_[Analyser::Input].levelDb), juce::PathStrokeType(1.0f));
+    g.setColour(OmbicLookAndFeel::pluginMuted().withAlpha(0.55f));
+    g.strokePath(bandPath(bands_[Analyser::Output].levelDb), juce::PathStrokeType(1.0f));
 }
 
 void SidechainFilterSection::FrequencyResponseDisplay::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     auto b = getLocalBounds().toFloat();
     g.setColour(OmbicLookAndFeel::pluginBg());
     g.fillRoundedRectangle(b, 10.0f);
@@ -22,6 +78,7 @@ void SidechainFilterSection::FrequencyResponseDisplay::paint(juce::Graphics& g)
     const bool off = frequencyHz_ <= 20.0f;
 
     auto inner = b.reduced(4.0f);
+    paintSpectra(g, inner);
 
     juce::Path path;
     bool started = false;
@@ -127,8 +184,6 @@ SidechainFilterSection::SidechainFilterSection(OmbicCompressorProcessor& process
     listenWarningLabel_.setJustificationType(juce::Justification::centredLeft);
     listenWarningLabel_.setVisible(false);
     addAndMakeVisible(listenWarningLabel_);
-
-    startTimerHz(45);
 }
 
 SidechainFilterSection::~SidechainFilterSection()
@@ -138,6 +193,7 @@ SidechainFilterSection::~SidechainFilterSection()
 
 void SidechainFilterSection::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     auto b = getLocalBounds().toFloat();
     g.setColour(OmbicLookAndFeel::pluginSurface());
     g.fillRoundedRectangle(b, 16.0f);
@@ -189,11 +245,13 @@ void SidechainFilterSection::resized()
     listenWarningLabel_.setBounds(listenX + listenW + 4, listenY, r.getRight() - (listenX + listenW + 4), juce::jmin(listenH, warnH));
 }
 
-void SidechainFilterSection::timerCallback()
+void SidechainFilterSection::renderTick(const RenderScheduler::Frame&)
 {
+    float freqHz = lastDrawnHz_;
     if (auto* r = proc_.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramScFrequency))
     {
         float hz = r->load();
+        freqHz = hz;
         freqResponseDisplay_.setFrequencyHz(hz);
         if (hz <= 20.5f)
             frequencyValueLabel_.setText("OFF", juce::dontSendNotification);
@@ -206,5 +264,10 @@ void SidechainFilterSection::timerCallback()
         listenWarningLabel_.setVisible(listenOn);
         resized();
     }
-    freqResponseDisplay_.repaint();
+    const bool spectraChanged = freqResponseDisplay_.updateSpectra();
+    if (spectraChanged || std::abs(lastDrawnHz_ - freqHz) > 0.5f)
+    {
+        lastDrawnHz_ = freqHz;
+        freqResponseDisplay_.repaint();
+    }
 }
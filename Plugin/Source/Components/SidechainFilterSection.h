@@ -2,33 +2,45 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
+#include "../Emulation/SpectrumAnalyser.h"
 
 class OmbicCompressorProcessor;
 
-/** Sidechain filter module: HPF for detector, frequency response display, Listen button. */
+/** Sidechain filter module: HPF for detector, frequency response display over live spectra, Listen button. */
 class SidechainFilterSection : public juce::Component,
-                               private juce::Timer
+                               public RenderScheduler::Client
 {
 public:
     explicit SidechainFilterSection(OmbicCompressorProcessor& processor);
     ~SidechainFilterSection() override;
     void resized() override;
     void paint(juce::Graphics& g) override;
+    void renderTick(const RenderScheduler::Frame& frame) override;
 
     juce::Slider& getFrequencySlider() { return frequencySlider_; }
     juce::ToggleButton& getListenButton() { return listenButton_; }
 
 private:
-    void timerCallback() override;
-
+    /** HPF response drawn over the analyser's input, output and sidechain (detector) spectra. Holding the
+     *  Consumer keeps the analyser running while the editor is open; paint() only draws the published bands. */
     class FrequencyResponseDisplay : public juce::Component
     {
     public:
         FrequencyResponseDisplay(OmbicCompressorProcessor& p);
         void paint(juce::Graphics& g) override;
         void setFrequencyHz(float hz) { frequencyHz_ = hz; }
+        /** Copies new spectra from the analyser; returns true if any source changed. */
+        bool updateSpectra();
     private:
+        using Analyser = emulation::SpectrumAnalyser;
+        void paintSpectra(juce::Graphics& g, juce::Rectangle<float> area) const;
+
         float frequencyHz_ = 20.0f;
+        Analyser& analyser_;
+        Analyser::Consumer spectrumConsumer_;
+        std::array<Analyser::Bands, Analyser::NumSources> bands_;
+        std::array<std::uint32_t, Analyser::NumSources> versions_{};
     };
 
     OmbicCompressorProcessor& proc_;
@@ -39,6 +51,7 @@ private:
     juce::Label frequencyValueLabel_;
     juce::ToggleButton listenButton_;
     juce::Label listenWarningLabel_;  // "Output replaced by sidechain" when Listen on
+    float lastDrawnHz_ = -1.0f;       // repaint the display only when the HPF or a spectrum changed
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SidechainFilterSection)
 };
@@ -0,0 +1,79 @@
+#include "StageTimingOverlay.h"
+#include "CachedLayer.h"
+#include "RenderScheduler.h"
+
+StageTimingOverlay::StageTimingOverlay(const emulation::StageProfiler& profiler, const PaintProfiler& paintProfiler)
+    : profiler_(profiler)
+    , paintProfiler_(paintProfiler)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+void StageTimingOverlay::refresh(double sampleRate)
+{
+    sampleRate_ = sampleRate > 0.0 ? sampleRate : 48000.0;
+    for (int s = 0; s < kNumRows; ++s)
+        stats_[static_cast<size_t>(s)] = profiler_.getStats(static_cast<emulation::StageProfiler::Stage>(s));
+    paintStats_ = paintProfiler_.getStats();
+    repaint();
+}
+
+void StageTimingOverlay::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(OmbicLookAndFeel::pluginSurface().withAlpha(0.92f));
+    g.fillRoundedRectangle(bounds, 6.0f);
+    g.setColour(OmbicLookAndFeel::pluginBorderStrong());
+    g.drawRoundedRectangle(bounds.reduced(0.5f), 6.0f, 1.0f);
+
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 11.0f, juce::Font::plain));
+    auto area = getLocalBounds().reduced(kPad);
+    const int nameW = 84;
+    const int colW = (area.getWidth() - nameW) / 5;
+
+    auto drawRow = [&](juce::Rectangle<int> row, const juce::String& name, const juce::String* cols, juce::Colour colour)
+    {
+        g.setColour(colour);
+        g.drawText(name, row.removeFromLeft(nameW), juce::Justification::centredLeft, false);
+        for (int c = 0; c < 5; ++c)
+            g.drawText(cols[c], row.removeFromLeft(colW), juce::Justification::centredRight, false);
+    };
+
+    const juce::String header[] = { "min", "avg", "p99", "max", "%RT" };
+    drawRow(area.removeFromTop(kRowH), "stage (us)", header, OmbicLookAndFeel::pluginMuted());
+
+    if (!emulation::StageProfiler::isEnabled())
+    {
+        g.setColour(OmbicLookAndFeel::pluginMuted());
+        g.drawText("Build with OMBIC_STAGE_PROFILING=ON", area.removeFromTop(kRowH), juce::Justification::centredLeft, false);
+        return;
+    }
+
+    for (int s = 0; s < kNumRows; ++s)
+    {
+        const auto& st = stats_[static_cast<size_t>(s)];
+        const auto stage = static_cast<emulation::StageProfiler::Stage>(s);
+        // %RT: average time per sample against the sample period (100% = no headroom left).
+        const double pctRt = st.avgNsPerSample * sampleRate_ * 1.0e-7;
+        const juce::String cols[] = {
+            juce::String(st.minNs * 1.0e-3, 1), juce::String(st.avgNs * 1.0e-3, 1),
+            juce::String(st.p99Ns * 1.0e-3, 1), juce::String(st.maxNs * 1.0e-3, 1),
+            juce::String(pctRt, 2)
+        };
+        const bool isTotal = stage == emulation::StageProfiler::Stage::Total;
+        const auto colour = st.blocks == 0 ? OmbicLookAndFeel::pluginMuted()
+                                           : (isTotal ? OmbicLookAndFeel::ombicYellow() : OmbicLookAndFeel::pluginText());
+        drawRow(area.removeFromTop(kRowH), emulation::StageProfiler::getStageName(stage), cols, colour);
+    }
+
+    // GUI: paint time per frame; last column is the share of one scheduler frame (1 / kTickHz).
+    const auto& ps = paintStats_;
+    const double pctFrame = ps.avgNs * RenderScheduler::kTickHz * 1.0e-7;
+    const juce::String paintCols[] = {
+        juce::String(ps.minNs * 1.0e-3, 1), juce::String(ps.avgNs * 1.0e-3, 1),
+        juce::String(ps.p99Ns * 1.0e-3, 1), juce::String(ps.maxNs * 1.0e-3, 1),
+        juce::String(pctFrame, 2)
+    };
+    drawRow(area.removeFromTop(kRowH), CachedLayer::isCachingEnabled() ? "GUI paint" : "GUI nocache", paintCols,
+            ps.blocks == 0 ? OmbicLookAndFeel::pluginMuted() : OmbicLookAndFeel::ombicBlue());
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "OmbicLookAndFeel.h"
+#include "../Emulation/StageProfiler.h"
+#include "PaintProfiler.h"
+
+/** Developer overlay: per-stage DSP time (min / avg / p99 / max per block, µs) and share of the block budget, plus
+ *  this editor's GUI paint time per rendered frame (PaintProfiler; % of the scheduler's frame period). Only has data
+ *  when built with OMBIC_STAGE_PROFILING. Owner calls refresh() at a low rate (~5 Hz). */
+class StageTimingOverlay : public juce::Component
+{
+public:
+    StageTimingOverlay(const emulation::StageProfiler& profiler, const PaintProfiler& paintProfiler);
+
+    /** Snapshot the profiler and repaint. sampleRate sets the "% of real time" column. */
+    void refresh(double sampleRate);
+
+    void paint(juce::Graphics& g) override;
+
+    /** Size that fits every row at the current font. */
+    static juce::Rectangle<int> getPreferredSize() { return { 0, 0, 360, kRowH * (kNumRows + 2) + 2 * kPad }; }
+
+private:
+    static constexpr int kNumRows = emulation::StageProfiler::kNumStages;
+    static constexpr int kRowH = 16;
+    static constexpr int kPad = 8;
+
+    const emulation::StageProfiler& profiler_;
+    const PaintProfiler& paintProfiler_;
+    std::array<emulation::StageProfiler::Stats, emulation::StageProfiler::kNumStages> stats_{};
+    emulation::StageProfiler::Stats paintStats_{};
+    double sampleRate_ = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageTimingOverlay)
+};
@@ -1,12 +1,154 @@
 #include "TransferCurveComponent.h"
-#include "../PluginProcessor.h"
+#include "PaintProfiler.h"
 
+//==============================================================================
+/** Computes curves off the message thread. Only the newest request matters: one queued behind a running computation
+ *  replaces any older one, so dragging a knob never builds a backlog. */
+class TransferCurveComponent::Worker : public juce::Thread
+{
+public:
+    Worker(TransferCurveComponent& owner, OmbicCompressorProcessor& processor)
+        : juce::Thread("Ombic transfer curve"), owner_(owner), processor_(processor)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~Worker() override { stopThread(2000); }
+
+    void request(const OmbicCompressorProcessor::TransferCurveSettings& settings)
+    {
+        {
+            const juce::SpinLock::ScopedLockType sl(lock_);
+            pending_ = settings;
+            hasPending_ = true;
+        }
+        notify();
+    }
+
+    /** Message thread: take the latest finished curve, if any arrived since the last call. */
+    bool takeResult(OmbicCompressorProcessor::TransferCurveSettings& settings, bool& valid, Curve& outputDb)
+    {
+        const juce::SpinLock::ScopedLockType sl(lock_);
+        if (!hasResult_)
+            return false;
+        settings = resultSettings_;
+        valid = resultValid_;
+        outputDb = result_;
+        hasResult_ = false;
+        return true;
+    }
+
+private:
+    void run() override
+    {
+        Curve inputDb;
+        for (int i = 0; i < kNumPoints; ++i)
+            inputDb[static_cast<size_t>(i)] = pointInputDb(i);
+
+        while (!threadShouldExit())
+        {
+            OmbicCompressorProcessor::TransferCurveSettings settings;
+            bool hasWork = false;
+            {
+                const juce::SpinLock::ScopedLockType sl(lock_);
+                std::swap(hasWork, hasPending_);
+                settings = pending_;
+            }
+            if (!hasWork)
+            {
+                wait(-1);
+                continue;
+            }
+
+            Curve outputDb{};
+            const bool valid = processor_.computeTransferCurve(settings, inputDb.data(), outputDb.data(), kNumPoints);
+            {
+                const juce::SpinLock::ScopedLockType sl(lock_);
+                resultSettings_ = settings;
+                resultValid_ = valid;
+                result_ = outputDb;
+                hasResult_ = true;
+            }
+            owner_.triggerAsyncUpdate();
+        }
+    }
+
+    TransferCurveComponent& owner_;
+    OmbicCompressorProcessor& processor_;
+    juce::SpinLock lock_;
+    OmbicCompressorProcessor::TransferCurveSettings pending_, resultSettings_;
+    bool hasPending_ = false, hasResult_ = false, resultValid_ = false;
+    Curve result_{};
+};
+
+//==============================================================================
 TransferCurveComponent::TransferCurveComponent(OmbicCompressorProcessor& processor)
-    : proc(processor) {}
+    : proc(processor)
+    , worker_(std::make_unique<Worker>(*this, processor))
+{
+    requested_ = proc.getTransferCurveSettings();
+    hasRequest_ = true;
+    worker_->request(requested_);
+}
+
+TransferCurveComponent::~TransferCurveComponent()
+{
+    worker_.reset();
+    cancelPendingUpdate();
+}
 
 void TransferCurveComponent::resized() {}
 
-void TransferCurveComponent::paint(juce::Graphics& g)
+juce::Point<float> TransferCurveComponent::getDotCentre() const
+{
+    const auto plot = getPlotArea();
+    const float x = juce::jlimit(kDbMin, kDbMax, dotInDb_);
+    const float y = juce::jlimit(kDbMin, kDbMax, dotOutDb_);
+    return { plot.getX() + plot.getWidth() * (x - kDbMin) / (kDbMax - kDbMin),
+             plot.getBottom() - plot.getHeight() * (y - kDbMin) / (kDbMax - kDbMin) };
+}
+
+juce::Rectangle<int> TransferCurveComponent::getDotArea() const
+{
+    return juce::Rectangle<float>(14.0f, 14.0f).withCentre(getDotCentre()).getSmallestIntegerContainer();
+}
+
+void TransferCurveComponent::renderTick(const RenderScheduler::Frame& frame)
+{
+    const auto settings = proc.getTransferCurveSettings();
+    if (!hasRequest_ || settings != requested_)
+    {
+        requested_ = settings;
+        hasRequest_ = true;
+        worker_->request(settings);   // full repaint once the curve arrives (handleAsyncUpdate)
+    }
+
+    const float inDb = juce::jlimit(kDbMin, kDbMax, frame.inputRmsDb);
+    const float outDb = juce::jlimit(kDbMin, kDbMax, frame.outputRmsDb);
+    if (RenderScheduler::exceeds(inDb, dotInDb_, RenderScheduler::kMeterThresholdDb)
+        || RenderScheduler::exceeds(outDb, dotOutDb_, RenderScheduler::kMeterThresholdDb))
+    {
+        repaint(getDotArea());
+        dotInDb_ = inDb;
+        dotOutDb_ = outDb;
+        repaint(getDotArea());
+    }
+}
+
+void TransferCurveComponent::handleAsyncUpdate()
+{
+    OmbicCompressorProcessor::TransferCurveSettings settings;
+    bool valid = false;
+    if (!worker_->takeResult(settings, valid, curveOutDb_))
+        return;
+    shown_ = settings;
+    hasShown_ = true;
+    curveValid_ = valid;
+    ++curveVersion_;
+    repaint();
+}
+
+void TransferCurveComponent::paintStaticLayer(juce::Graphics& g) const
 {
     auto b = getLocalBounds().toFloat();
     // Spec §6: background pluginBg, border 1px pluginBorder, 10px radius
@@ -15,7 +157,9 @@ void TransferCurveComponent::paint(juce::Graphics& g)
     g.setColour(OmbicLookAndFeel::pluginBorder());
     g.drawRoundedRectangle(b.reduced(0.5f), 10.0f, 1.0f);
 
-    if (!proc.hasCurveDataLoaded())
+    if (!hasShown_)
+        return;
+    if (!shown_.curveDataLoaded)
     {
         g.setColour(OmbicLookAndFeel::pluginMuted());
         g.setFont(OmbicLookAndFeel::getOmbicFontForPainting(11.0f, true));
@@ -23,9 +167,9 @@ void TransferCurveComponent::paint(juce::Graphics& g)
         return;
     }
 
-    auto plotArea = b.reduced(20.0f, 10.0f);
-    const float dbMin = -50.0f;
-    const float dbMax = 0.0f;
+    auto plotArea = getPlotArea();
+    const float dbMin = kDbMin;
+    const float dbMax = kDbMax;
 
     auto dbToX = [&](float db) {
         return plotArea.getX() + plotArea.getWidth() * (db - dbMin) / (dbMax - dbMin);
@@ -34,24 +178,6 @@ void TransferCurveComponent::paint(juce::Graphics& g)
         return plotArea.getBottom() - plotArea.getHeight() * (db - dbMin) / (dbMax - dbMin);
     };
 
-    auto& apvts = proc.getValueTreeState();
-    float thresholdRaw = 50.0f;
-    float ratio = 4.0f;
-    int mode = 0;
-    if (auto* r = apvts.getRawParameterValue(OmbicCompressorProcessor::paramThreshold))
-        thresholdRaw = r->load();
-    if (auto* r = apvts.getRawParameterValue(OmbicCompressorProcessor::paramRatio))
-        ratio = r->load();
-    if (auto* r = apvts.getRawParameterValue(OmbicCompressorProcessor::paramCompressorMode))
-        mode = juce::jlimit(0, 3, static_cast<int>(r->load() * 3.0f + 0.5f));
-
-    // FET/VCA: threshold 0..100 -> dB -60..0 (VCA internal -1..3 mapped same for display); Opto: gentler; PWM: soft knee
-    float threshDb = -60.0f + (thresholdRaw / 100.0f) * 60.0f;
-    threshDb = juce::jlimit(dbMin, dbMax, threshDb);
-    float displayRatio = (mode == 1 || mode == 3) ? juce::jmax(1.0f, ratio) : (mode == 2) ? juce::jlimit(1.5f, 8.0f, ratio) : 2.5f;
-    const bool softKnee = (mode == 2);
-    const float kneeDb = softKnee ? 3.0f : 0.0f;
-
     // Grid 6×6, 4% white; unity line dashed 8% white
     g.setColour(juce::Colour(0x0affffff));
     for (int i = 1; i < 6; ++i)
@@ -64,55 +190,47 @@ void TransferCurveComponent::paint(juce::Graphics& g)
     float dashLen = 3.0f;
     g.drawDashedLine(juce::Line<float>(dbToX(dbMin), dbToY(dbMin), dbToX(dbMax), dbToY(dbMax)), &dashLen, 1, 1.0f);
 
-    // Transfer curve: below threshold out = in; above (with optional soft knee) out = thresh + (in - thresh) / ratio
-    juce::Path curve;
-    const int steps = 64;
-    bool started = false;
-    for (int i = 0; i <= steps; ++i)
+    // Transfer curve from the worker (output = input - static gain reduction)
+    if (curveValid_)
     {
-        float inDb = dbMin + (dbMax - dbMin) * static_cast<float>(i) / static_cast<float>(steps);
-        float outDb;
-        if (inDb <= threshDb - kneeDb)
-            outDb = inDb;
-        else if (inDb >= threshDb + kneeDb)
-            outDb = threshDb + (inDb - threshDb) / displayRatio;
-        else if (kneeDb > 0.0f)
+        juce::Path curve;
+        for (int i = 0; i < kNumPoints; ++i)
         {
-            float t = (inDb - (threshDb - kneeDb)) / (2.0f * kneeDb);
-            t = t * t * (3.0f - 2.0f * t);
-            float linearOut = inDb;
-            float compressedOut = threshDb + (inDb - threshDb) / displayRatio;
-            outDb = linearOut + t * (compressedOut - linearOut);
+            const float x = dbToX(pointInputDb(i));
+            const float y = dbToY(juce::jlimit(dbMin, dbMax, curveOutDb_[static_cast<size_t>(i)]));
+            if (i == 0)
+                curve.startNewSubPath(x, y);
+            else
+                curve.lineTo(x, y);
         }
-        else
-            outDb = threshDb + (inDb - threshDb) / displayRatio;
-        outDb = juce::jlimit(dbMin, dbMax, outDb);
-        float x = dbToX(inDb);
-        float y = dbToY(outDb);
-        if (!started) { curve.startNewSubPath(x, y); started = true; }
-        else curve.lineTo(x, y);
+        juce::Colour curveCol = (shown_.mode == 2) ? OmbicLookAndFeel::ombicTeal() : OmbicLookAndFeel::ombicBlue();
+        g.setColour(curveCol);
+        g.strokePath(curve, juce::PathStrokeType(2.0f, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
     }
-    juce::Colour curveCol = (mode == 2) ? OmbicLookAndFeel::ombicTeal() : OmbicLookAndFeel::ombicBlue();
-    g.setColour(curveCol);
-    g.strokePath(curve, juce::PathStrokeType(2.0f, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+
+    // Axis labels: "OUT" top-left, "IN" bottom-right, 8px, 25% white
+    g.setFont(OmbicLookAndFeel::getOmbicFontForPainting(8.0f, true));
+    g.setColour(juce::Colour(0x40ffffff));
+    g.drawText("OUT", static_cast<int>(plotArea.getX()), static_cast<int>(plotArea.getY() - 2), 24, 10, juce::Justification::left);
+    g.drawText("IN", static_cast<int>(plotArea.getRight() - 18), static_cast<int>(plotArea.getBottom() - 10), 18, 10, juce::Justification::right);
+}
+
+void TransferCurveComponent::paint(juce::Graphics& g)
+{
+    OMBIC_PAINT_SCOPE(*this);
+    staticLayer_.draw(g, getLocalBounds(), curveVersion_, [this](juce::Graphics& lg) { paintStaticLayer(lg); });
+
+    if (!hasShown_ || !shown_.curveDataLoaded)
+        return;
 
     // Current input/output point (pink accent + red core per OMBIC fun colors)
-    float inDb = proc.inputLevelDb.load();
-    float outDb = proc.outputLevelDb.load();
-    inDb = juce::jlimit(dbMin, dbMax, inDb);
-    outDb = juce::jlimit(dbMin, dbMax, outDb);
-    float px = dbToX(inDb);
-    float py = dbToY(outDb);
+    const auto dot = getDotCentre();
+    float px = dot.x;
+    float py = dot.y;
     g.setColour(OmbicLookAndFeel::ombicPink().withAlpha(0.7f));
     g.fillEllipse(px - 5, py - 5, 10, 10);
     g.setColour(OmbicLookAndFeel::ombicRed());
     g.fillEllipse(px - 4, py - 4, 8, 8);
     g.setColour(OmbicLookAndFeel::ink());
     g.drawEllipse(px - 4, py - 4, 8, 8, 1.0f);
-
-    // Axis labels: "OUT" top-left, "IN" bottom-right, 8px, 25% white
-    g.setFont(OmbicLookAndFeel::getOmbicFontForPainting(8.0f, true));
-    g.setColour(juce::Colour(0x40ffffff));
-    g.drawText("OUT", static_cast<int>(plotArea.getX()), static_cast<int>(plotArea.getY() - 2), 24, 10, juce::Justification::left);
-    g.drawText("IN", static_cast<int>(plotArea.getRight() - 18), static_cast<int>(plotArea.getBottom() - 10), 18, 10, juce::Justification::right);
 }
@@ -2,19 +2,59 @@
 
 #include <JuceHeader.h>
 #include "OmbicLookAndFeel.h"
+#include "RenderScheduler.h"
+#include "CachedLayer.h"
+#include "../PluginProcessor.h"
+#include <array>
+#include <memory>
 
-class OmbicCompressorProcessor;
-
-/** Transfer curve: input level (x) vs output level (y). 1:1 below threshold, flattening above by ratio. */
-class TransferCurveComponent : public juce::Component
+/** Transfer curve: input level (x) vs output level (y) from the compressor's real gain computer (measured curves for
+ *  Opto/FET/VCA, the soft-knee computer for PWM), with the RMS operating point as a dot.
+ *
+ *  The curve is computed on a worker thread whenever threshold, ratio, mode or FET character change, and the whole
+ *  static layer (background, grid, unity line, curve, labels) is a CachedLayer. paint() blits it and draws the dot; renderTick (forwarded by the owning view) repaints only the dot's old and new areas. */
+class TransferCurveComponent : public juce::Component,
+                               public RenderScheduler::Client,
+                               private juce::AsyncUpdater
 {
 public:
     explicit TransferCurveComponent(OmbicCompressorProcessor& processor);
+    ~TransferCurveComponent() override;
+
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void lookAndFeelChanged() override { staticLayer_.invalidate(); }
+    void renderTick(const RenderScheduler::Frame& frame) override;
 
 private:
+    static constexpr float kDbMin = -50.0f;
+    static constexpr float kDbMax = 0.0f;
+    static constexpr int kNumPoints = 256;   // ~0.2 dB per step across the plot
+    using Curve = std::array<float, kNumPoints>;
+    static float pointInputDb(int i) noexcept { return kDbMin + (kDbMax - kDbMin) * static_cast<float>(i) / static_cast<float>(kNumPoints - 1); }
+
+    class Worker;
+
+    juce::Rectangle<float> getPlotArea() const { return getLocalBounds().toFloat().reduced(20.0f, 10.0f); }
+    juce::Point<float> getDotCentre() const;
+    juce::Rectangle<int> getDotArea() const;
+    void handleAsyncUpdate() override;
+    void paintStaticLayer(juce::Graphics& g) const;
+
     OmbicCompressorProcessor& proc;
+    float dotInDb_ = kDbMin, dotOutDb_ = kDbMin;   // operating point as last painted
+
+    OmbicCompressorProcessor::TransferCurveSettings requested_;   // last settings handed to the worker
+    OmbicCompressorProcessor::TransferCurveSettings shown_;       // settings of the curve in staticLayer_
+    bool hasRequest_ = false;
+    bool hasShown_ = false;     // a worker result has arrived
+    bool curveValid_ = false;   // worker produced a curve for shown_ (false: mode has no curve data)
+    Curve curveOutDb_{};
+
+    CachedLayer staticLayer_;
+    juce::int64 curveVersion_ = 0;   // bumped per worker result: the static layer's cache key
+
+    std::unique_ptr<Worker> worker_;   // last: stopped before anything it posts to is destroyed
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TransferCurveComponent)
 };
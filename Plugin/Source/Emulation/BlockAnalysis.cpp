@@ -0,0 +1,94 @@
+#include "BlockAnalysis.h"
+#include <algorithm>
+#include <cmath>
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+namespace emulation {
+
+namespace {
+
+/** One channel: level into `level`; if mix != nullptr, mix = x * gain (first channel) or mix += x * gain. */
+void analyseChannel(const float* x, int n, float gain, float* mix, bool accumulate, ChannelLevel& level)
+{
+    int i = 0;
+    float peak = 0.0f, sumSq = 0.0f;
+
+#if JUCE_USE_SSE_INTRINSICS
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 g = _mm_set1_ps(gain);
+    __m128 vPeak = _mm_setzero_ps();
+    __m128 vSum = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(x + i);
+        vPeak = _mm_max_ps(vPeak, _mm_and_ps(v, absMask));
+        vSum = _mm_add_ps(vSum, _mm_mul_ps(v, v));
+        if (mix != nullptr)
+        {
+            __m128 m = _mm_mul_ps(v, g);
+            if (accumulate)
+                m = _mm_add_ps(m, _mm_loadu_ps(mix + i));
+            _mm_storeu_ps(mix + i, m);
+        }
+    }
+    // Horizontal max / sum
+    vPeak = _mm_max_ps(vPeak, _mm_movehl_ps(vPeak, vPeak));
+    vPeak = _mm_max_ss(vPeak, _mm_shuffle_ps(vPeak, vPeak, 1));
+    vSum = _mm_add_ps(vSum, _mm_movehl_ps(vSum, vSum));
+    vSum = _mm_add_ss(vSum, _mm_shuffle_ps(vSum, vSum, 1));
+    peak = _mm_cvtss_f32(vPeak);
+    sumSq = _mm_cvtss_f32(vSum);
+#elif JUCE_USE_ARM_NEON
+    const float32x4_t g = vdupq_n_f32(gain);
+    float32x4_t vPeak = vdupq_n_f32(0.0f);
+    float32x4_t vSum = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(x + i);
+        vPeak = vmaxq_f32(vPeak, vabsq_f32(v));
+        vSum = vmlaq_f32(vSum, v, v);
+        if (mix != nullptr)
+        {
+            float32x4_t m = vmulq_f32(v, g);
+            if (accumulate)
+                m = vaddq_f32(m, vld1q_f32(mix + i));
+            vst1q_f32(mix + i, m);
+        }
+    }
+    float32x2_t p2 = vpmax_f32(vget_low_f32(vPeak), vget_high_f32(vPeak));
+    p2 = vpmax_f32(p2, p2);
+    float32x2_t s2 = vadd_f32(vget_low_f32(vSum), vget_high_f32(vSum));
+    s2 = vpadd_f32(s2, s2);
+    peak = vget_lane_f32(p2, 0);
+    sumSq = vget_lane_f32(s2, 0);
+#endif
+
+    for (; i < n; ++i)
+    {
+        const float v = x[i];
+        peak = std::max(peak, std::abs(v));
+        sumSq += v * v;
+        if (mix != nullptr)
+            mix[i] = accumulate ? mix[i] + v * gain : v * gain;
+    }
+    level.peak = peak;
+    level.sumSquares = sumSq;
+}
+
+} // namespace
+
+void analyseAndMix(const float* const* channels, int numChannels, int numSamples, ChannelLevel* levels, float* mixOut)
+{
+    if (numChannels <= 0)
+        return;
+    const float gain = 1.0f / static_cast<float>(numChannels);
+    for (int ch = 0; ch < numChannels; ++ch)
+        analyseChannel(channels[ch], numSamples, gain, mixOut, ch > 0, levels[ch]);
+}
+
+} // namespace emulation
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace emulation {
+
+/** Peak (max abs) and sum of squares of one channel over one block. */
+struct ChannelLevel
+{
+    float peak = 0.0f;
+    float sumSquares = 0.0f;
+};
+
+/** Single SIMD pass over a block: per-channel peak + sum of squares into levels[0..numChannels), and, when mixOut is
+ *  non-null, the channel mean written to mixOut (sidechain mono sum / scope capture). Each sample is loaded once;
+ *  horizontal max/sum happen once per channel. Unaligned pointers are fine. Allocation-free (audio thread). */
+void analyseAndMix(const float* const* channels, int numChannels, int numSamples, ChannelLevel* levels, float* mixOut);
+
+/** Same pass over a buffer; levels must hold buffer.getNumChannels() entries. */
+inline void analyseAndMix(const juce::AudioBuffer<float>& buffer, ChannelLevel* levels, float* mixOut)
+{
+    analyseAndMix(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples(), levels, mixOut);
+}
+
+} // namespace emulation
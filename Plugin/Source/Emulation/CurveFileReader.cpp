@@ -0,0 +1,258 @@
+#include "CurveFileReader.h"
+#include <JuceHeader.h>
+#include <charconv>
+#include <cstring>
+
+namespace emulation {
+
+namespace
+{
+    constexpr int kMaxJsonDepth = 64;
+
+    bool isSpace(char c) noexcept { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    char toLower(char c) noexcept { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    std::string_view trimField(std::string_view s) noexcept
+    {
+        while (!s.empty() && (isSpace(s.front()) || s.front() == '"')) s.remove_prefix(1);
+        while (!s.empty() && (isSpace(s.back()) || s.back() == '"')) s.remove_suffix(1);
+        return s;
+    }
+
+    bool equalsIgnoreCase(std::string_view s, std::string_view lower) noexcept
+    {
+        if (s.size() != lower.size()) return false;
+        for (size_t i = 0; i < s.size(); ++i)
+            if (toLower(s[i]) != lower[i]) return false;
+        return true;
+    }
+
+    /** Whole-field float parse, independent of the C locale. from_chars where the standard library has the
+     *  floating-point overloads (libc++ lacks them); otherwise JUCE's reader on a bounded stack copy, which parses
+     *  with the "C" locale rather than LC_NUMERIC (still no heap). */
+    template <typename T>
+    bool parseWhole(std::string_view s, T& out) noexcept
+    {
+        if (!s.empty() && s.front() == '+') s.remove_prefix(1);   // from_chars rejects a leading '+'
+        if (s.empty()) return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return ec == std::errc() && end == s.data() + s.size();
+#else
+        char buf[64];
+        if (s.size() >= sizeof(buf)) return false;
+        std::memcpy(buf, s.data(), s.size());
+        buf[s.size()] = '\0';
+        juce::CharPointer_ASCII p(buf);
+        out = static_cast<T>(juce::CharacterFunctions::readDoubleValue(p));
+        return p.getAddress() == buf + s.size();
+#endif
+    }
+}
+
+std::optional<float> parseNumber(std::string_view field) noexcept
+{
+    float v = 0.0f;
+    if (!parseWhole(trimField(field), v)) return {};
+    return v;
+}
+
+bool parseFlag(std::string_view field) noexcept
+{
+    const auto t = trimField(field);
+    return !(equalsIgnoreCase(t, "false") || t == "0");
+}
+
+bool headerEquals(std::string_view field, std::string_view lowerCaseName) noexcept
+{
+    return equalsIgnoreCase(trimField(field), lowerCaseName);
+}
+
+//==============================================================================
+CsvReader::CsvReader(const char* data, size_t size) noexcept
+    : pos_(data), end_(data + size)
+{
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        pos_ += 3;
+}
+
+bool CsvReader::nextRow()
+{
+    while (pos_ < end_)
+    {
+        fields_.clear();
+        const char* lineStart = pos_;
+        const char* fieldStart = pos_;
+        bool inQuotes = false;
+        for (; pos_ < end_; ++pos_)
+        {
+            const char c = *pos_;
+            if (c == '"')
+                inQuotes = !inQuotes;
+            else if (!inQuotes && c == ',')
+            {
+                fields_.emplace_back(fieldStart, static_cast<size_t>(pos_ - fieldStart));
+                fieldStart = pos_ + 1;
+            }
+            else if (!inQuotes && (c == '\n' || c == '\r'))
+                break;
+        }
+        const char* lineEnd = pos_;
+        fields_.emplace_back(fieldStart, static_cast<size_t>(lineEnd - fieldStart));
+        // Step over the line break (CRLF counts once)
+        if (pos_ < end_ && *pos_ == '\r') ++pos_;
+        if (pos_ < end_ && *pos_ == '\n') ++pos_;
+
+        for (const char* p = lineStart; p < lineEnd; ++p)
+            if (!isSpace(*p))
+                return true;
+    }
+    fields_.clear();
+    return false;
+}
+
+std::string_view CsvReader::getField(int i) const noexcept
+{
+    return (i >= 0 && i < getNumFields()) ? fields_[static_cast<size_t>(i)] : std::string_view();
+}
+
+//==============================================================================
+bool JsonObjectArrayReader::read(const char* data, size_t size)
+{
+    pos_ = data;
+    end_ = data + size;
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        pos_ += 3;
+    skipSpace();
+    if (pos_ >= end_ || *pos_ != '[') return false;
+    ++pos_;
+    skipSpace();
+    if (pos_ < end_ && *pos_ == ']') return true;
+    for (;;)
+    {
+        skipSpace();
+        if (pos_ >= end_) return false;
+        if (*pos_ == '{')
+        {
+            if (!parseObject()) return false;
+        }
+        else if (!skipValue(1))
+            return false;
+        skipSpace();
+        if (pos_ >= end_) return false;
+        if (*pos_ == ']') { ++pos_; return true; }
+        if (*pos_ != ',') return false;
+        ++pos_;
+    }
+}
+
+bool JsonObjectArrayReader::parseObject()
+{
+    ++pos_;   // '{'
+    beginObject();
+    skipSpace();
+    if (pos_ < end_ && *pos_ == '}') { ++pos_; return true; }
+    for (;;)
+    {
+        skipSpace();
+        std::string_view key;
+        if (!readString(key)) return false;
+        skipSpace();
+        if (pos_ >= end_ || *pos_ != ':') return false;
+        ++pos_;
+        skipSpace();
+        if (pos_ >= end_) return false;
+        const char c = *pos_;
+        if (c == '-' || (c >= '0' && c <= '9'))
+        {
+            double value = 0.0;
+            if (!readNumber(value)) return false;
+            numberMember(key, value);
+        }
+        else if (!skipValue(2))
+            return false;
+        skipSpace();
+        if (pos_ >= end_) return false;
+        if (*pos_ == '}') { ++pos_; return true; }
+        if (*pos_ != ',') return false;
+        ++pos_;
+    }
+}
+
+bool JsonObjectArrayReader::skipValue(int depth)
+{
+    if (depth > kMaxJsonDepth) return false;
+    skipSpace();
+    if (pos_ >= end_) return false;
+    const char c = *pos_;
+    if (c == '"')
+    {
+        std::string_view ignored;
+        return readString(ignored);
+    }
+    if (c == '{' || c == '[')
+    {
+        const char close = (c == '{') ? '}' : ']';
+        ++pos_;
+        skipSpace();
+        if (pos_ < end_ && *pos_ == close) { ++pos_; return true; }
+        for (;;)
+        {
+            if (c == '{')
+            {
+                std::string_view key;
+                skipSpace();
+                if (!readString(key)) return false;
+                skipSpace();
+                if (pos_ >= end_ || *pos_ != ':') return false;
+                ++pos_;
+            }
+            if (!skipValue(depth + 1)) return false;
+            skipSpace();
+            if (pos_ >= end_) return false;
+            if (*pos_ == close) { ++pos_; return true; }
+            if (*pos_ != ',') return false;
+            ++pos_;
+        }
+    }
+    // Number or literal (true / false / null): run to the next delimiter
+    const char* start = pos_;
+    while (pos_ < end_ && !isSpace(*pos_) && *pos_ != ',' && *pos_ != '}' && *pos_ != ']')
+        ++pos_;
+    return pos_ > start;
+}
+
+bool JsonObjectArrayReader::readString(std::string_view& out)
+{
+    if (pos_ >= end_ || *pos_ != '"') return false;
+    const char* start = ++pos_;
+    for (; pos_ < end_; ++pos_)
+    {
+        if (*pos_ == '\\') { ++pos_; continue; }   // escapes stay raw in the view (keys here are plain ASCII)
+        if (*pos_ == '"')
+        {
+            out = std::string_view(start, static_cast<size_t>(pos_ - start));
+            ++pos_;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JsonObjectArrayReader::readNumber(double& out)
+{
+    const char* start = pos_;
+    auto isNumberChar = [](char c) { return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'; };
+    while (pos_ < end_ && isNumberChar(*pos_))
+        ++pos_;
+    return parseWhole(std::string_view(start, static_cast<size_t>(pos_ - start)), out);
+}
+
+void JsonObjectArrayReader::skipSpace() noexcept
+{
+    while (pos_ < end_ && isSpace(*pos_))
+        ++pos_;
+}
+
+} // namespace emulation
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace emulation {
+
+/** Number in an analyzer file field: surrounding spaces and quotes are ignored, the whole rest must parse ('.' as the
+ *  decimal point whatever the locale). Empty or unparseable fields are nullopt; "nan" parses as NaN. No allocation. */
+std::optional<float> parseNumber(std::string_view field) noexcept;
+
+/** True unless the field is False / 0 (measurement_ok style flags; case-insensitive). */
+bool parseFlag(std::string_view field) noexcept;
+
+/** Case-insensitive comparison of a header field (spaces and quotes ignored) with a lower-case name. */
+bool headerEquals(std::string_view field, std::string_view lowerCaseName) noexcept;
+
+/** Single pass over CSV text held in memory (e.g. a memory-mapped file): each nextRow() splits one line into fields
+ *  that view the text in place, so reading allocates nothing per row or field. Handles CRLF / LF, a UTF-8 BOM, and
+ *  double-quoted fields containing commas (quotes stay in the view; parseNumber() ignores them). Blank lines are
+ *  skipped. The text must outlive the reader. */
+class CsvReader
+{
+public:
+    CsvReader(const char* data, size_t size) noexcept;
+
+    /** Advance to the next non-blank line; false at end of text. */
+    bool nextRow();
+
+    int getNumFields() const noexcept { return static_cast<int>(fields_.size()); }
+    /** Field i of the current row, or empty if the row is shorter. */
+    std::string_view getField(int i) const noexcept;
+
+private:
+    const char* pos_;
+    const char* end_;
+    std::vector<std::string_view> fields_;   // reused: grows to the widest row once
+};
+
+/** Streaming reader for a JSON array of objects (thd_vs_level.json): walks the text once and reports each object's
+ *  top-level numeric members; nested objects / arrays and non-numeric values are skipped without being built.
+ *  Returns false if the text is not an array of objects (objects seen before the error have been reported). */
+class JsonObjectArrayReader
+{
+public:
+    virtual ~JsonObjectArrayReader() = default;
+
+    bool read(const char* data, size_t size);
+
+protected:
+    virtual void beginObject() {}
+    virtual void numberMember(std::string_view key, double value) = 0;
+
+private:
+    bool parseObject();
+    bool skipValue(int depth);
+    bool readString(std::string_view& out);
+    bool readNumber(double& out);
+    void skipSpace() noexcept;
+
+    const char* pos_ = nullptr;
+    const char* end_ = nullptr;
+};
+
+} // namespace emulation
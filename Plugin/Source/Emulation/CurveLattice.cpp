@@ -0,0 +1,287 @@
+#include "CurveLattice.h"
+#include "MonotoneCubic.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <set>
+
+namespace emulation {
+
+void LatticeAxis::setValues(std::vector<float> v)
+{
+    values = std::move(v);
+    const float range = values.size() > 1 ? values.back() - values.front() : 0.0f;
+    invStep = range > 0.0f ? static_cast<float>(values.size() - 1) / range : 0.0f;
+}
+
+int LatticeAxis::locate(float x, float& frac) const noexcept
+{
+    const int last = static_cast<int>(values.size()) - 2;   // last cell
+    if (!(x > values.front())) { frac = 0.0f; return 0; }   // also catches NaN
+    if (x >= values.back()) { frac = 1.0f; return last; }
+    int i = juce::jlimit(0, last, static_cast<int>((x - values.front()) * invStep));
+    while (i > 0 && x < values[static_cast<size_t>(i)]) --i;
+    while (i < last && x >= values[static_cast<size_t>(i + 1)]) ++i;
+    const float lo = values[static_cast<size_t>(i)], hi = values[static_cast<size_t>(i + 1)];
+    frac = (x - lo) / (hi - lo);
+    return i;
+}
+
+std::map<CurveLattice::Key, CurveLattice::Curve> CurveLattice::groupCurves(const ColumnTable& compression)
+{
+    using namespace CompressionColumn;
+    // Absent cells read as 0, which is what a missing parameter means here
+    const float* threshold = compression.column(Threshold);
+    const float* ratio = compression.column(Ratio);
+    const float* attackMs = compression.column(AttackMs);
+    const float* releaseMs = compression.column(ReleaseMs);
+    const float* input = compression.column(InputDb);
+    const float* gainReduction = compression.column(GainReductionDb);
+    std::map<Key, std::map<float, std::pair<float, int>>> groups;
+    for (int r = 0; r < compression.numRows; ++r)
+    {
+        auto& sum = groups[{ threshold[r], ratio[r], attackMs[r], releaseMs[r] }][input[r]];
+        sum.first += gainReduction[r];
+        ++sum.second;
+    }
+    std::map<Key, Curve> curves;
+    for (const auto& [key, byInput] : groups)
+    {
+        auto& [inputDb, grDb] = curves[key];
+        for (const auto& [inDb, sum] : byInput)   // std::map: already ascending in input level
+        {
+            inputDb.push_back(inDb);
+            grDb.push_back(sum.first / static_cast<float>(sum.second));
+        }
+    }
+    return curves;
+}
+
+void CurveLattice::build(const std::map<Key, Curve>& curves)
+{
+    coeffs_.clear();
+    inputGrid_.clear();
+    numSegments_ = 0;
+    for (auto& axis : axes_)
+        axis.setValues({});
+    if (curves.empty())
+        return;
+
+    std::array<std::set<float>, NumParamAxes> distinct;
+    std::set<float> inputLevels;
+    for (const auto& [key, curve] : curves)
+    {
+        for (size_t a = 0; a < NumParamAxes; ++a)
+            distinct[a].insert(key[a]);
+        inputLevels.insert(curve.first.begin(), curve.first.end());
+    }
+    if (inputLevels.empty())
+        return;
+    for (size_t a = 0; a < NumParamAxes; ++a)
+        axes_[a].setValues({ distinct[a].begin(), distinct[a].end() });
+
+    // Uniform input grid over all measured levels: at least as many points, and no coarser than the closest pair
+    const float lo = *inputLevels.begin(), hi = *inputLevels.rbegin();
+    int numPoints = static_cast<int>(inputLevels.size());
+    if (numPoints > 1)
+    {
+        float minStep = hi - lo;
+        for (auto it = std::next(inputLevels.begin()); it != inputLevels.end(); ++it)
+            minStep = juce::jmin(minStep, *it - *std::prev(it));
+        numPoints = juce::jlimit(numPoints, 4 * numPoints, static_cast<int>(std::lround((hi - lo) / minStep)) + 1);
+    }
+    inputGrid_.resize(static_cast<size_t>(numPoints));
+    for (int i = 0; i < numPoints; ++i)
+        inputGrid_[static_cast<size_t>(i)] = numPoints > 1 ? lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(numPoints - 1) : lo;
+    numSegments_ = juce::jmax(1, numPoints - 1);
+    inputStart_ = lo;
+    invInputStep_ = numPoints > 1 ? static_cast<float>(numPoints - 1) / (hi - lo) : 0.0f;
+
+    strides_[NumParamAxes - 1] = 1;
+    for (int a = NumParamAxes - 2; a >= 0; --a)
+        strides_[static_cast<size_t>(a)] = strides_[static_cast<size_t>(a + 1)]
+                                         * static_cast<int>(axes_[static_cast<size_t>(a + 1)].values.size());
+    const size_t numNodes = static_cast<size_t>(strides_[0]) * axes_[0].values.size();
+    const size_t nodeSize = static_cast<size_t>(numSegments_) * 4;
+    coeffs_.assign(numNodes * nodeSize, 0.0f);
+
+    std::array<float, NumParamAxes> span{};
+    for (size_t a = 0; a < NumParamAxes; ++a)
+        span[a] = juce::jmax(1e-6f, axes_[a].values.back() - axes_[a].values.front());
+
+    MonotoneCubic measured, uniform;
+    std::vector<float> samples(inputGrid_.size());
+    for (size_t node = 0; node < numNodes; ++node)
+    {
+        // Node index -> key (threshold slowest)
+        Key key{};
+        size_t rest = node;
+        for (int a = NumParamAxes - 1; a >= 0; --a)
+        {
+            const auto& v = axes_[static_cast<size_t>(a)].values;
+            key[static_cast<size_t>(a)] = v[rest % v.size()];
+            rest /= v.size();
+        }
+
+        auto it = curves.find(key);
+        if (it == curves.end())
+        {
+            float bestD = 0.0f;
+            for (auto c = curves.begin(); c != curves.end(); ++c)
+            {
+                float d = 0.0f;
+                for (size_t a = 0; a < NumParamAxes; ++a)
+                {
+                    const float n = (c->first[a] - key[a]) / span[a];
+                    d += n * n;
+                }
+                if (it == curves.end() || d < bestD) { it = c; bestD = d; }
+            }
+        }
+
+        measured.fit(it->second.first, it->second.second);
+        for (size_t i = 0; i < inputGrid_.size(); ++i)
+            samples[i] = measured(inputGrid_[i]);
+        float* out = coeffs_.data() + node * nodeSize;
+        if (inputGrid_.size() < 2)
+        {
+            out[0] = samples[0];   // one level: constant
+            continue;
+        }
+        uniform.fit(inputGrid_, samples);
+        for (int seg = 0; seg < numSegments_; ++seg)
+            uniform.getSegment(static_cast<size_t>(seg), out + 4 * seg);
+    }
+}
+
+int CurveLattice::locateCorners(const Key& params, std::array<int, 1 << NumParamAxes>& offsets,
+                                std::array<float, 1 << NumParamAxes>& weights) const noexcept
+{
+    // Cell on each populated axis: base node plus (stride, fraction) per interpolated dimension
+    int base = 0, dims = 0;
+    std::array<int, NumParamAxes> step{};
+    std::array<float, NumParamAxes> frac{};
+    for (size_t a = 0; a < NumParamAxes; ++a)
+    {
+        const auto& axis = axes_[a];
+        if (axis.values.size() < 2)
+            continue;
+        float f = 0.0f;
+        const int i = axis.locate(params[a], f);
+        base += i * strides_[a];
+        step[static_cast<size_t>(dims)] = strides_[a];
+        frac[static_cast<size_t>(dims)] = f;
+        ++dims;
+    }
+
+    const int nodeSize = numSegments_ * 4;
+    const int numCorners = 1 << dims;
+    for (int corner = 0; corner < numCorners; ++corner)
+    {
+        float w = 1.0f;
+        int node = base;
+        for (int d = 0; d < dims; ++d)
+        {
+            if ((corner >> d) & 1)
+            {
+                w *= frac[static_cast<size_t>(d)];
+                node += step[static_cast<size_t>(d)];
+            }
+            else
+                w *= 1.0f - frac[static_cast<size_t>(d)];
+        }
+        offsets[static_cast<size_t>(corner)] = node * nodeSize;
+        weights[static_cast<size_t>(corner)] = w;
+    }
+    return numCorners;
+}
+
+int CurveLattice::locateSegment(float inputDb, float& t) const noexcept
+{
+    float u = (inputDb - inputStart_) * invInputStep_;
+    u = u > 0.0f ? juce::jmin(u, static_cast<float>(numSegments_)) : 0.0f;   // also catches NaN
+    const int seg = juce::jmin(static_cast<int>(u), numSegments_ - 1);
+    t = u - static_cast<float>(seg);
+    return seg;
+}
+
+float CurveLattice::evaluate(const Key& params, float inputDb) const noexcept
+{
+    if (coeffs_.empty())
+        return 0.0f;
+
+    std::array<int, 1 << NumParamAxes> offsets;
+    std::array<float, 1 << NumParamAxes> weights;
+    const int numCorners = locateCorners(params, offsets, weights);
+    float t = 0.0f;
+    const int seg = locateSegment(inputDb, t) * 4;
+
+    // Blend the corner segments' coefficients, then evaluate one cubic
+    float c0 = 0.0f, c1 = 0.0f, c2 = 0.0f, c3 = 0.0f;
+    for (int corner = 0; corner < numCorners; ++corner)
+    {
+        const float w = weights[static_cast<size_t>(corner)];
+        if (w == 0.0f)
+            continue;
+        const float* c = coeffs_.data() + offsets[static_cast<size_t>(corner)] + seg;
+        c0 += w * c[0];
+        c1 += w * c[1];
+        c2 += w * c[2];
+        c3 += w * c[3];
+    }
+    return ((c3 * t + c2) * t + c1) * t + c0;
+}
+
+void CurveLattice::getSlice(const Key& params, Slice& slice) const
+{
+    const size_t nodeSize = static_cast<size_t>(numSegments_) * 4;
+    slice.coeffs_.assign(nodeSize, 0.0f);
+    slice.inputStart_ = inputStart_;
+    slice.invStep_ = invInputStep_;
+    slice.numSegments_ = coeffs_.empty() ? 0 : numSegments_;
+    if (coeffs_.empty())
+        return;
+
+    std::array<int, 1 << NumParamAxes> offsets;
+    std::array<float, 1 << NumParamAxes> weights;
+    const int numCorners = locateCorners(params, offsets, weights);
+    for (int corner = 0; corner < numCorners; ++corner)
+    {
+        const float w = weights[static_cast<size_t>(corner)];
+        if (w == 0.0f)
+            continue;
+        juce::FloatVectorOperations::addWithMultiply(slice.coeffs_.data(), coeffs_.data() + offsets[static_cast<size_t>(corner)],
+                                                     w, static_cast<int>(nodeSize));
+    }
+}
+
+void CurveLattice::Slice::evaluate(const float* inputDb, float* grDb, int numPoints) const noexcept
+{
+    if (numSegments_ == 0)
+    {
+        std::fill(grDb, grDb + numPoints, 0.0f);
+        return;
+    }
+    const float* coeffs = coeffs_.data();
+    const float last = static_cast<float>(numSegments_);
+    const int lastSegment = numSegments_ - 1;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        float u = (inputDb[i] - inputStart_) * invStep_;
+        u = u > 0.0f ? (u < last ? u : last) : 0.0f;
+        const int seg = juce::jmin(static_cast<int>(u), lastSegment);
+        const float t = u - static_cast<float>(seg);
+        const float* c = coeffs + 4 * seg;
+        grDb[i] = ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+    }
+}
+
+size_t CurveLattice::getMemoryBytes() const noexcept
+{
+    size_t n = coeffs_.capacity() + inputGrid_.capacity();
+    for (const auto& axis : axes_)
+        n += axis.values.capacity();
+    return n * sizeof(float);
+}
+
+} // namespace emulation
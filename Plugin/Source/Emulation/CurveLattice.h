@@ -0,0 +1,99 @@
+#pragma once
+
+#include "DataLoader.h"
+#include <JuceHeader.h>
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace emulation {
+
+/** One axis of a measured grid: ascending values, roughly evenly spaced (measurement grids round their steps). */
+struct LatticeAxis
+{
+    std::vector<float> values;
+    float invStep = 0.0f;   // (n - 1) / range: uniform first guess for locate()
+
+    void setValues(std::vector<float> v);
+    /** Lower cell index and fraction within the cell, clamped to the ends; O(1) (uniform guess plus at most a step
+     *  or two of correction). Requires values.size() >= 2. */
+    int locate(float x, float& frac) const noexcept;
+};
+
+/** Measured compression curves on a regular lattice: gain reduction (dB) at every combination of threshold, ratio,
+ *  attack_ms and release_ms, each node holding its curve over input level as monotone cubic segments (PCHIP) with
+ *  precomputed coefficients on a uniform input grid.
+ *
+ *  Built once at load time from the measured grid (e.g. standard_20x20: 20 thresholds x 17 ratios x 25 input levels
+ *  for fetish_v2). Axes with a single measured value are dropped from the interpolation. A lookup locates its cell
+ *  on each populated parameter axis in O(1) (uniform guess plus at most a step or two of correction, since measured
+ *  axes are only roughly evenly spaced) and its input segment by a single multiply, blends the 2^d corner nodes'
+ *  segment coefficients and evaluates one cubic. Gain reduction is therefore smooth (C1) through the measured knee
+ *  points yet never overshoots them. Queries outside an axis clamp to its ends, like the measured curves.
+ *  evaluate() is const, lock- and allocation-free. */
+class CurveLattice
+{
+public:
+    enum Axis { Threshold, Ratio, AttackMs, ReleaseMs, NumParamAxes };
+    using Key = std::array<float, NumParamAxes>;
+    /** One measured curve: input levels (dB, ascending) and gain reduction (dB) at each. */
+    using Curve = std::pair<std::vector<float>, std::vector<float>>;
+
+    /** Gain reduction over input level at one parameter point: the blended cubic segments, for evaluating many input
+     *  levels at once (e.g. a transfer curve). The loop is branch-free, so it vectorises. */
+    class Slice
+    {
+    public:
+        void evaluate(const float* inputDb, float* grDb, int numPoints) const noexcept;
+
+    private:
+        friend class CurveLattice;
+        std::vector<float> coeffs_;   // 4 per segment
+        float inputStart_ = 0.0f, invStep_ = 0.0f;
+        int numSegments_ = 0;
+    };
+
+    /** Replace the lattice. Parameter axis values are the distinct key values. Each curve gets a monotone cubic fit
+     *  through its measured points, sampled on a uniform input grid spanning all curves (at least as dense as the
+     *  measured levels), and that grid gets its own monotone cubic segments. Lattice nodes with no measured curve
+     *  take the nearest curve (distance with each axis normalised to its range). Not for the audio thread. */
+    void build(const std::map<Key, Curve>& curves);
+
+    /** One curve per (threshold, ratio, attack_ms, release_ms) in a compression table, input levels ascending;
+     *  repeated input levels are averaged. Missing parameters read as 0. */
+    static std::map<Key, Curve> groupCurves(const ColumnTable& compression);
+
+    bool isEmpty() const noexcept { return coeffs_.empty(); }
+
+    /** Gain reduction (dB) at the given parameters and input level. 0 if empty. */
+    float evaluate(const Key& params, float inputDb) const noexcept;
+
+    /** Blend the curve at the given parameters into slice (allocates only if the slice has not held one yet). */
+    void getSlice(const Key& params, Slice& slice) const;
+
+    /** Measured values along a parameter axis; NumParamAxes = the uniform input grid. */
+    const std::vector<float>& getAxisValues(int axis) const
+    {
+        return axis < NumParamAxes ? axes_[static_cast<size_t>(axis)].values : inputGrid_;
+    }
+
+    /** Heap bytes held by the segment coefficients and axes. */
+    size_t getMemoryBytes() const noexcept;
+
+private:
+    /** Base offset into coeffs_ and the blend weight of each corner node around params. Returns the corner count. */
+    int locateCorners(const Key& params, std::array<int, 1 << NumParamAxes>& offsets,
+                      std::array<float, 1 << NumParamAxes>& weights) const noexcept;
+    /** Input segment index and fraction: one multiply and a clamp on the uniform grid. */
+    int locateSegment(float inputDb, float& t) const noexcept;
+
+    std::array<LatticeAxis, NumParamAxes> axes_;
+    std::array<int, NumParamAxes> strides_{};   // in nodes
+    std::vector<float> inputGrid_;
+    float inputStart_ = 0.0f, invInputStep_ = 0.0f;
+    int numSegments_ = 0;
+    std::vector<float> coeffs_;   // node-major, then segment, then c0..c3 (threshold slowest)
+};
+
+} // namespace emulation
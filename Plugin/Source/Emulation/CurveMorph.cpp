@@ -0,0 +1,162 @@
+#include "CurveMorph.h"
+#include <cmath>
+
+namespace emulation {
+
+namespace
+{
+    constexpr float kInputStepDb = (CurveMorph::kMaxInputDb - CurveMorph::kMinInputDb) / (CurveMorph::kNumInputs - 1);
+    constexpr float kRatioStep = (CurveMorph::kMaxRatio - CurveMorph::kMinRatio) / (CurveMorph::kNumRatios - 1);
+
+    /** Lower node and fraction of x on a uniform axis, clamped to the ends. */
+    inline int locateUniform(float x, float start, float invStep, int n, float& frac) noexcept
+    {
+        const float pos = juce::jlimit(0.0f, static_cast<float>(n - 1), (x - start) * invStep);
+        const int i = juce::jmin(static_cast<int>(pos), n - 2);
+        frac = pos - static_cast<float>(i);
+        return i;
+    }
+}
+
+CurveMorph::CurveMorph(ThresholdRange thresholdRange)
+    : range_(thresholdRange)
+{
+    const float span = range_.atMax - range_.atMin;
+    thresholdInvStep_ = span != 0.0f ? static_cast<float>(kNumThresholds - 1) / span : 0.0f;
+    sourceA_.assign(static_cast<size_t>(kTableSize), 0.0f);
+    sourceB_.assign(static_cast<size_t>(kTableSize), 0.0f);
+    for (auto& t : tables_)
+        t.grDb.assign(static_cast<size_t>(kTableSize), 0.0f);
+}
+
+void CurveMorph::sample(const MeasuredCompressor::Tables& tables, ThresholdRange range, std::vector<float>& grid)
+{
+    std::array<float, kNumInputs> inputDb{};
+    for (int k = 0; k < kNumInputs; ++k)
+        inputDb[static_cast<size_t>(k)] = kMinInputDb + static_cast<float>(k) * kInputStepDb;
+
+    CurveLattice::Slice slice;
+    for (int t = 0; t < kNumThresholds; ++t)
+    {
+        // Same knob position in the sampled profile's own threshold units
+        const float knob = static_cast<float>(t) / static_cast<float>(kNumThresholds - 1);
+        const float threshold = range.atMin + knob * (range.atMax - range.atMin);
+        for (int r = 0; r < kNumRatios; ++r)
+        {
+            const float ratio = kMinRatio + static_cast<float>(r) * kRatioStep;
+            tables.curves.getSlice({ threshold, ratio, 0.0f, 0.0f }, slice);
+            slice.evaluate(inputDb.data(), grid.data() + (t * kNumRatios + r) * kNumInputs, kNumInputs);
+        }
+    }
+}
+
+void CurveMorph::setSources(const MeasuredCompressor::Tables& a, const MeasuredCompressor::Tables& b, ThresholdRange partnerRange)
+{
+    std::vector<float> gridA(static_cast<size_t>(kTableSize)), gridB(static_cast<size_t>(kTableSize));
+    sample(a, range_, gridA);
+    sample(b, partnerRange, gridB);
+    const juce::ScopedLock sl(sourceLock_);
+    sourceA_.swap(gridA);
+    sourceB_.swap(gridB);
+    sourcesChanged_ = true;
+}
+
+void CurveMorph::update(float amount)
+{
+    amount = juce::jlimit(0.0f, 1.0f, amount);
+    {
+        const juce::ScopedLock sl(sourceLock_);
+        if (!sourcesChanged_ && amount == blendedAmount_)
+            return;
+        sourcesChanged_ = false;
+        blendedAmount_ = amount;
+
+        auto& out = tables_[static_cast<size_t>(back_)];
+        const float* a = sourceA_.data();
+        const float* b = sourceB_.data();
+        float* dst = out.grDb.data();
+        for (int i = 0; i < kTableSize; ++i)
+            dst[i] = a[i] + amount * (b[i] - a[i]);
+        out.amount = amount;
+    }
+    back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & ~kFresh;
+}
+
+bool CurveMorph::acquire(Blend& blend) noexcept
+{
+    if ((middle_.load(std::memory_order_relaxed) & kFresh) != 0)
+    {
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & ~kFresh;
+        hasFront_ = true;
+    }
+    if (!hasFront_)
+        return false;
+    const auto& t = tables_[static_cast<size_t>(front_)];
+    if (t.amount <= 0.0f)
+        return false;
+    blend.owner_ = this;
+    blend.table_ = t.grDb.data();
+    return true;
+}
+
+float CurveMorph::Blend::gainReductionDb(float threshold, float ratio, float inputDb) const noexcept
+{
+    float ft, fr, fi;
+    const int t = locateUniform(threshold, owner_->range_.atMin, owner_->thresholdInvStep_, kNumThresholds, ft);
+    const int r = locateUniform(ratio, kMinRatio, 1.0f / kRatioStep, kNumRatios, fr);
+    const int i = locateUniform(inputDb, kMinInputDb, 1.0f / kInputStepDb, kNumInputs, fi);
+
+    auto row = [this, i, fi](int tt, int rr) noexcept {
+        const float* p = table_ + (tt * kNumRatios + rr) * kNumInputs + i;
+        return p[0] + fi * (p[1] - p[0]);
+    };
+    const float lo = row(t, r) + fr * (row(t, r + 1) - row(t, r));
+    const float hi = row(t + 1, r) + fr * (row(t + 1, r + 1) - row(t + 1, r));
+    return lo + ft * (hi - lo);
+}
+
+//==============================================================================
+CurveMorph::Worker::Worker()
+    : juce::Thread("Ombic curve morph")
+{
+}
+
+CurveMorph::Worker::~Worker()
+{
+    stop();
+}
+
+void CurveMorph::Worker::add(CurveMorph& morph, const std::atomic<float>& amount)
+{
+    jassert(!isThreadRunning());
+    morphs_.emplace_back(&morph, &amount);
+}
+
+void CurveMorph::Worker::clear()
+{
+    jassert(!isThreadRunning());
+    morphs_.clear();
+}
+
+void CurveMorph::Worker::start()
+{
+    if (!morphs_.empty())
+        startThread(juce::Thread::Priority::low);
+}
+
+void CurveMorph::Worker::stop()
+{
+    stopThread(1000);
+}
+
+void CurveMorph::Worker::run()
+{
+    while (!threadShouldExit())
+    {
+        for (auto& [morph, amount] : morphs_)
+            morph->update(amount->load(std::memory_order_relaxed));
+        wait(kPollIntervalMs);
+    }
+}
+
+} // namespace emulation
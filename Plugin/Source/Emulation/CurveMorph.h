@@ -0,0 +1,115 @@
+#pragma once
+
+#include "MeasuredCompressor.h"
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace emulation {
+
+/** Continuous blend ("Character") between the gain-reduction curves of two profiles, e.g. fetish_v2 and dbcomp_vca,
+ *  for the price of one table lookup per detector block whatever the blend.
+ *
+ *  Both profiles are resampled once onto a common lattice: threshold in the playing engine's units (the partner's
+ *  threshold range is mapped linearly onto it, i.e. both are read at the same knob position), ratio 1..20 and input
+ *  level. Attack/release axes are read at their lowest node, like the transfer curve. Whenever the blend amount moves,
+ *  a Worker thread mixes the two grids into a spare table and publishes it through a lock-free triple buffer; the
+ *  audio thread picks up the newest table at the start of each block and interpolates it trilinearly. Nothing on the
+ *  audio side locks, waits or allocates. At amount 0 the compressor keeps its own (exact) curves. */
+class CurveMorph
+{
+public:
+    /** Threshold at knob 0 % and 100 % in an engine's units (FET dB, Opto 0..100, VCA reference units). */
+    struct ThresholdRange
+    {
+        float atMin = 0.0f, atMax = 100.0f;
+    };
+
+    static constexpr int kNumThresholds = 21;   // 5 % knob steps
+    static constexpr int kNumRatios = 20;       // 1:1 .. 20:1
+    static constexpr int kNumInputs = 46;       // -80 .. +10 dB in 2 dB steps
+    static constexpr float kMinRatio = 1.0f, kMaxRatio = 20.0f;
+    static constexpr float kMinInputDb = -80.0f, kMaxInputDb = 10.0f;
+    static constexpr int kTableSize = kNumThresholds * kNumRatios * kNumInputs;
+
+    /** Allocates every grid and table up front. thresholdRange: the playing engine's (the compressor's) units. */
+    explicit CurveMorph(ThresholdRange thresholdRange);
+
+    /** Resample the playing profile (a) and the partner (b) onto the lattice and reblend on the next update().
+     *  Not the audio thread; safe while the worker and the audio thread run. */
+    void setSources(const MeasuredCompressor::Tables& a, const MeasuredCompressor::Tables& b, ThresholdRange partnerRange);
+
+    /** Worker: blend and publish if the amount (0 = a, 1 = b) or the sources changed since the last call. */
+    void update(float amount);
+
+    /** Newest blended table, for one audio block. */
+    class Blend
+    {
+    public:
+        /** Gain reduction (dB); threshold in the engine's units. */
+        float gainReductionDb(float threshold, float ratio, float inputDb) const noexcept;
+
+    private:
+        friend class CurveMorph;
+        const CurveMorph* owner_ = nullptr;
+        const float* table_ = nullptr;
+    };
+
+    /** Audio thread: takes the newest published table. Returns false (blend untouched) before the first blend or
+     *  while the amount is 0; the table stays valid until the next call. */
+    bool acquire(Blend& blend) noexcept;
+
+    /** Services a fixed set of morphs from one low-priority thread, polling each morph's amount every kPollIntervalMs
+     *  (a parameter value the audio thread never has to signal). */
+    class Worker : private juce::Thread
+    {
+    public:
+        static constexpr int kPollIntervalMs = 10;
+
+        Worker();
+        ~Worker() override;
+
+        /** Blend amount (0..1) read from e.g. a parameter. Call while stopped; morphs must outlive the run. */
+        void add(CurveMorph& morph, const std::atomic<float>& amount);
+        void clear();
+        void start();
+        void stop();
+
+    private:
+        void run() override;
+        std::vector<std::pair<CurveMorph*, const std::atomic<float>*>> morphs_;
+        JUCE_DECLARE_NON_COPYABLE(Worker)
+    };
+
+private:
+    struct Table
+    {
+        std::vector<float> grDb;   // [threshold][ratio][input]
+        float amount = 0.0f;
+    };
+    static constexpr int kFresh = 4;   // flag on middle_: published since the audio thread last took it
+
+    /** Gain reduction of tables on the lattice, its threshold axis spanning range (the profile's own units). */
+    static void sample(const MeasuredCompressor::Tables& tables, ThresholdRange range, std::vector<float>& grid);
+
+    ThresholdRange range_;
+    float thresholdInvStep_ = 0.0f;
+
+    // Worker side (sourceLock_ also taken by setSources)
+    juce::CriticalSection sourceLock_;
+    std::vector<float> sourceA_, sourceB_;
+    bool sourcesChanged_ = false;
+    float blendedAmount_ = -1.0f;
+
+    // Triple buffer: worker writes tables_[back_], the audio thread reads tables_[front_], middle_ is the handoff
+    std::array<Table, 3> tables_;
+    int back_ = 0;
+    std::atomic<int> middle_{ 1 };
+    int front_ = 2;
+    bool hasFront_ = false;
+
+    JUCE_DECLARE_NON_COPYABLE(CurveMorph)
+};
+
+} // namespace emulation
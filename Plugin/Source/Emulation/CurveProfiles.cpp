@@ -0,0 +1,189 @@
+#include "CurveProfiles.h"
+#include "CurveFileReader.h"
+#include <algorithm>
+
+namespace emulation {
+
+namespace
+{
+    /** Header plus first data row of compression_curve.csv: a ratio value means a FET-style (threshold x ratio) unit. */
+    bool firstCurveRowHasRatio(const juce::File& csv)
+    {
+        juce::FileInputStream in(csv);
+        if (!in.openedOk()) return false;
+        const juce::String text = in.readNextLine() + "\n" + in.readNextLine();
+        const auto utf8 = text.toStdString();
+        CsvReader reader(utf8.data(), utf8.size());
+        if (!reader.nextRow()) return false;
+        int ratioColumn = -1;
+        for (int i = 0; i < reader.getNumFields() && ratioColumn < 0; ++i)
+            if (headerEquals(reader.getField(i), "ratio"))
+                ratioColumn = i;
+        return ratioColumn >= 0 && reader.nextRow() && parseNumber(reader.getField(ratioColumn)).has_value();
+    }
+
+    juce::var readManifest(const juce::File& dir)
+    {
+        const auto manifestFile = dir.getChildFile("manifest.json");
+        return manifestFile.existsAsFile() ? juce::JSON::parse(manifestFile) : juce::var();
+    }
+
+    juce::String declaredMode(const juce::var& manifest)
+    {
+        return manifest.getProperty("mode", {}).toString().toLowerCase();
+    }
+
+    MVPChain::Mode inferMode(const juce::File& dir, const juce::var& manifest)
+    {
+        const auto declared = declaredMode(manifest);
+        if (declared == "fet") return MVPChain::Mode::FET;
+        if (declared == "opto") return MVPChain::Mode::Opto;
+        if (declared == "vca") return MVPChain::Mode::VCA;
+
+        const auto dirName = dir.getFileName().toLowerCase();
+        if (dirName.contains("vca")) return MVPChain::Mode::VCA;
+        if (dirName.contains("lala") || dirName.contains("opto")) return MVPChain::Mode::Opto;
+        if (dirName.contains("fet")) return MVPChain::Mode::FET;
+
+        return firstCurveRowHasRatio(dir.getChildFile("compression_curve.csv")) ? MVPChain::Mode::FET : MVPChain::Mode::Opto;
+    }
+}
+
+std::vector<CurveProfile> discoverCurveProfiles(const juce::Array<juce::File>& roots)
+{
+    std::vector<CurveProfile> profiles;
+    for (const auto& root : roots)
+    {
+        if (!root.isDirectory()) continue;
+        for (const auto& dir : root.findChildFiles(juce::File::findDirectories, false))
+        {
+            if (!dir.getChildFile("compression_curve.csv").existsAsFile()) continue;
+            const auto id = dir.getFileName();
+            if (std::any_of(profiles.begin(), profiles.end(), [&](const CurveProfile& p) { return p.id == id; }))
+                continue;
+
+            const juce::var manifest = readManifest(dir);
+            const auto declared = declaredMode(manifest);
+            if (declared.isNotEmpty() && declared != "fet" && declared != "opto" && declared != "vca")
+                continue;   // another engine's capture, e.g. OmbicMeasure --mode=pwm
+            CurveProfile p;
+            p.id = id;
+            p.name = manifest.getProperty("name", manifest.getProperty("source", id)).toString();
+            p.directory = dir;
+            p.mode = inferMode(dir, manifest);
+            profiles.push_back(p);
+        }
+    }
+    std::sort(profiles.begin(), profiles.end(),
+              [](const CurveProfile& a, const CurveProfile& b) { return a.name.compareNatural(b.name) < 0; });
+    return profiles;
+}
+
+juce::File findPwmCurveData(const juce::Array<juce::File>& roots)
+{
+    for (const auto& root : roots)
+    {
+        if (!root.isDirectory()) continue;
+        auto dirs = root.findChildFiles(juce::File::findDirectories, false);
+        dirs.sort();
+        for (const auto& dir : dirs)
+            if (dir.getChildFile("compression_curve.csv").existsAsFile() && declaredMode(readManifest(dir)) == "pwm")
+                return dir;
+    }
+    return {};
+}
+
+//==============================================================================
+CurveStore::TablesPtr CurveStore::acquire(const CurveProfile& profile)
+{
+    const juce::ScopedLock sl(lock_);
+    const auto key = profile.directory.getFullPathName();
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&](const Entry& e) { return e.key == key; });
+    if (it != entries_.end())
+    {
+        it->lastUse = ++useClock_;
+        return it->tables;
+    }
+
+    const AnalyzerOutput data = loadAnalyzerOutput(profile.directory);
+    if (data.compression.isEmpty())
+        return {};
+    Entry e;
+    e.key = key;
+    e.tables = std::make_shared<const MeasuredCompressor::Tables>(data);
+    e.bytes = sizeof(MeasuredCompressor::Tables) + e.tables->getMemoryBytes();
+    e.lastUse = ++useClock_;
+    residentBytes_ += e.bytes;
+    entries_.push_back(e);
+    auto tables = e.tables;   // held here, so the new set cannot be the one evicted
+    trimLocked();
+    return tables;
+}
+
+CurveStore::TablesPtr CurveStore::reload(const juce::File& directory)
+{
+    // Parse outside the lock: a reload must not hold up acquire() from other instances
+    const AnalyzerOutput data = loadAnalyzerOutput(directory);
+    if (data.compression.isEmpty())
+        return {};
+    auto tables = std::make_shared<const MeasuredCompressor::Tables>(data);
+    const auto bytes = sizeof(MeasuredCompressor::Tables) + tables->getMemoryBytes();
+
+    const juce::ScopedLock sl(lock_);
+    const auto key = directory.getFullPathName();
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&](const Entry& e) { return e.key == key; });
+    if (it == entries_.end())
+    {
+        entries_.push_back({ key, {}, 0, 0 });
+        it = entries_.end() - 1;
+    }
+    residentBytes_ = residentBytes_ - it->bytes + bytes;
+    it->tables = tables;
+    it->bytes = bytes;
+    it->lastUse = ++useClock_;
+    trimLocked();
+    return tables;
+}
+
+void CurveStore::trim()
+{
+    const juce::ScopedLock sl(lock_);
+    trimLocked();
+}
+
+void CurveStore::trimLocked()
+{
+    while (residentBytes_ > budgetBytes_)
+    {
+        // Least recently used set nobody but the store holds
+        auto victim = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+            if (it->tables.use_count() == 1 && (victim == entries_.end() || it->lastUse < victim->lastUse))
+                victim = it;
+        if (victim == entries_.end())
+            return;   // everything resident is in use
+        residentBytes_ -= victim->bytes;
+        entries_.erase(victim);
+    }
+}
+
+void CurveStore::setBudgetBytes(size_t bytes)
+{
+    const juce::ScopedLock sl(lock_);
+    budgetBytes_ = bytes;
+    trimLocked();
+}
+
+size_t CurveStore::getResidentBytes() const
+{
+    const juce::ScopedLock sl(lock_);
+    return residentBytes_;
+}
+
+int CurveStore::getNumResident() const
+{
+    const juce::ScopedLock sl(lock_);
+    return static_cast<int>(entries_.size());
+}
+
+} // namespace emulation
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "MeasuredCompressor.h"
+#include "MVPChain.h"
+#include <JuceHeader.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace emulation {
+
+/** One measured unit: an analyzer-output directory (compression_curve.csv, timing.csv, ...) and the engine that
+ *  plays it. Cheap to discover; the curves themselves are only loaded through CurveStore. */
+struct CurveProfile
+{
+    juce::String id;     // directory name, e.g. "fetish_v2"; unique across the roots
+    juce::String name;   // display name: manifest "name" or "source", else the id
+    juce::File directory;
+    MVPChain::Mode mode = MVPChain::Mode::FET;
+};
+
+/** Profiles in the immediate subdirectories of each root that hold a compression_curve.csv, sorted by name. A root
+ *  earlier in the list wins when two hold the same id (bundled data before user captures). The engine comes from
+ *  manifest.json "mode" ("fet", "opto" or "vca"), else from the directory name (vca / lala, opto / fet), else from the
+ *  first curve row (a ratio column means FET, none means Opto). Directories declaring any other mode (OmbicMeasure's
+ *  "pwm" and "iron" captures) are not profiles. Reads the manifest and one CSV row per profile. */
+std::vector<CurveProfile> discoverCurveProfiles(const juce::Array<juce::File>& roots);
+
+/** Measured PWM curves: the first subdirectory (roots in order, then by name) holding a compression_curve.csv whose
+ *  manifest.json declares mode "pwm", as OmbicMeasure --mode=pwm writes it; juce::File() if there is none. The PWM
+ *  engine computes its gain itself, so these only draw its transfer curve. */
+juce::File findPwmCurveData(const juce::Array<juce::File>& roots);
+
+/** Process-wide store of read-only compressor tables, one set per profile, shared by every plugin instance
+ *  (hold it with juce::SharedResourcePointer). Profiles load on first use; after each load, sets no compressor holds
+ *  any more are evicted least recently used first until the store is within its byte budget, so resident curve memory
+ *  stays bounded however many profiles are installed. Sets still in use are never evicted (they are freed when their
+ *  last user lets go). Thread-safe; loads block other callers, so use it from prepareToPlay or the message thread,
+ *  never the audio thread. */
+class CurveStore
+{
+public:
+    using TablesPtr = std::shared_ptr<const MeasuredCompressor::Tables>;
+
+    static constexpr size_t kDefaultBudgetBytes = 2 * 1024 * 1024;
+
+    /** Tables for the profile, loading them if they are not resident. nullptr if the profile has no compression rows. */
+    TablesPtr acquire(const CurveProfile& profile);
+
+    /** Re-read a profile directory whose files changed (hot reload) and make the new tables the resident set, so
+     *  later acquire() calls get them; compressors still playing the old set keep it until they let go. Returns the
+     *  new set, or nullptr (resident set unchanged) if the directory has no compression rows. */
+    TablesPtr reload(const juce::File& directory);
+
+    /** Evict unused sets, least recently used first, until within budget. */
+    void trim();
+
+    void setBudgetBytes(size_t bytes);
+    size_t getResidentBytes() const;
+    int getNumResident() const;
+
+private:
+    struct Entry
+    {
+        juce::String key;   // full directory path
+        TablesPtr tables;
+        size_t bytes = 0;
+        uint64_t lastUse = 0;
+    };
+
+    void trimLocked();
+
+    mutable juce::CriticalSection lock_;
+    std::vector<Entry> entries_;
+    size_t budgetBytes_ = kDefaultBudgetBytes;
+    size_t residentBytes_ = 0;
+    uint64_t useClock_ = 0;
+};
+
+} // namespace emulation
@@ -0,0 +1,97 @@
+#include "CurveReloader.h"
+
+namespace emulation {
+
+CurveReloader::CurveReloader(juce::CriticalSection& readerLock, CurveStore& store, ReloadCallback onReload)
+    : juce::Thread("Ombic curve reload"), readerLock_(readerLock), store_(store), onReload_(std::move(onReload))
+{
+}
+
+CurveReloader::~CurveReloader()
+{
+    stop();
+}
+
+void CurveReloader::watch(const juce::File& dataDir)
+{
+    jassert(!isThreadRunning());
+    for (const auto& e : entries_)
+        if (e.dataDir == dataDir)
+            return;
+    Entry e;
+    e.dataDir = dataDir;
+    e.loaded = readStamp(dataDir);
+    entries_.push_back(e);
+}
+
+void CurveReloader::reclaimFor(MeasuredCompressor& compressor)
+{
+    jassert(!isThreadRunning());
+    compressors_.push_back(&compressor);
+}
+
+void CurveReloader::start()
+{
+    if (!entries_.empty())
+        startThread(juce::Thread::Priority::low);
+}
+
+void CurveReloader::stop()
+{
+    stopThread(2000);
+}
+
+CurveReloader::Stamp CurveReloader::readStamp(const juce::File& dataDir)
+{
+    const auto compression = dataDir.getChildFile("compression_curve.csv");
+    const auto timing = dataDir.getChildFile("timing.csv");
+    Stamp s;
+    s.compressionTime = compression.getLastModificationTime().toMilliseconds();
+    s.compressionSize = compression.getSize();
+    s.timingTime = timing.getLastModificationTime().toMilliseconds();
+    s.timingSize = timing.getSize();
+    return s;
+}
+
+void CurveReloader::run()
+{
+    while (!threadShouldExit())
+    {
+        for (auto& e : entries_)
+        {
+            const Stamp now = readStamp(e.dataDir);
+            if (now == e.loaded)
+                e.changed = false;
+            else if (e.changed && now == e.pending)
+                reload(e);   // changed, then stable for a poll
+            else
+            {
+                e.changed = true;
+                e.pending = now;
+            }
+        }
+
+        {
+            const juce::ScopedLock sl(readerLock_);
+            for (auto* compressor : compressors_)
+                compressor->releaseRetiredTables();
+        }
+        wait(kPollIntervalMs);
+    }
+}
+
+void CurveReloader::reload(Entry& e)
+{
+    e.changed = false;
+    e.loaded = e.pending;
+    auto tables = store_.reload(e.dataDir);
+    if (tables == nullptr)
+        return;   // mid-write or broken export: keep the current tables, retry on the next change
+    {
+        const juce::ScopedLock sl(readerLock_);
+        onReload_(e.dataDir, std::move(tables));
+    }
+    ++numReloads_;
+}
+
+} // namespace emulation
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "MeasuredCompressor.h"
+#include "CurveProfiles.h"
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+namespace emulation {
+
+/** Developer hot reload of curve data (built with OMBIC_CURVE_HOT_RELOAD): a background thread polls the
+ *  compression_curve.csv and timing.csv of each watched analyzer directory, and when a file has changed and then stayed
+ *  unchanged for one poll (so a half-written save is not picked up), reloads the directory through the CurveStore
+ *  (so a later acquire() of that profile gets the new set, not the stale one) and hands the new
+ *  MeasuredCompressor::Tables to the owner's callback, which publishes them to the compressors playing that directory
+ *  and re-sources any CurveMorph built from it. The audio thread only sees the atomic swaps inside MeasuredCompressor
+ *  and CurveMorph.
+ *
+ *  The callback runs on this thread while holding readerLock, the lock every non-audio caller of the compressors'
+ *  curve lookups holds; outgoing tables of the compressors registered with reclaimFor() are freed under the same
+ *  lock, so nothing can still be reading them. A reload that parses to no compression rows (e.g. the file was
+ *  truncated mid-save) keeps the current tables.
+ *
+ *  Lifetime: compressors and whatever the callback touches must outlive the reloader; destroy (or stop()) it before
+ *  destroying them, and never while holding readerLock. */
+class CurveReloader : private juce::Thread
+{
+public:
+    static constexpr int kPollIntervalMs = 500;
+
+    /** Called with the rebuilt tables of a watched directory, on the reload thread with readerLock held. */
+    using ReloadCallback = std::function<void(const juce::File& dataDir, CurveStore::TablesPtr tables)>;
+
+    CurveReloader(juce::CriticalSection& readerLock, CurveStore& store, ReloadCallback onReload);
+    ~CurveReloader() override;
+
+    /** Watch dataDir (once, however often it is passed). Call before start(). */
+    void watch(const juce::File& dataDir);
+    /** Free compressor's outgoing tables on every poll. Call before start(). */
+    void reclaimFor(MeasuredCompressor& compressor);
+
+    void start();
+    void stop();
+
+    /** Tables published so far (for logging / tests). */
+    int getNumReloads() const noexcept { return numReloads_.load(); }
+
+private:
+    /** Modification times and sizes of the watched files; equal stamps mean nothing changed. */
+    struct Stamp
+    {
+        juce::int64 compressionTime = 0, compressionSize = 0, timingTime = 0, timingSize = 0;
+        bool operator==(const Stamp& o) const noexcept
+        {
+            return compressionTime == o.compressionTime && compressionSize == o.compressionSize
+                && timingTime == o.timingTime && timingSize == o.timingSize;
+        }
+        bool operator!=(const Stamp& o) const noexcept { return !(*this == o); }
+    };
+
+    struct Entry
+    {
+        juce::File dataDir;
+        Stamp loaded;     // files the current tables were built from
+        Stamp pending;    // changed stamp seen on the previous poll
+        bool changed = false;
+    };
+
+    static Stamp readStamp(const juce::File& dataDir);
+    void run() override;
+    void reload(Entry& entry);
+
+    juce::CriticalSection& readerLock_;
+    CurveStore& store_;
+    ReloadCallback onReload_;
+    std::vector<Entry> entries_;                     // fixed once started
+    std::vector<MeasuredCompressor*> compressors_;   // fixed once started
+    std::atomic<int> numReloads_{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(CurveReloader)
+};
+
+} // namespace emulation
@@ -1,180 +1,191 @@
 #include "DataLoader.h"
-#include <cmath>
+#include "CurveFileReader.h"
+#include <array>
+#include <initializer_list>
+#include <vector>
 
 namespace emulation {
 
-static float parseFloat(const juce::String& s)
+namespace
 {
-    return s.trim().getFloatValue();
-}
+    /** A table while loading: row-major cells plus a presence flag each. Packed into the arena, then dropped. */
+    struct ParsedTable
+    {
+        int numColumns = 0;
+        int numRows = 0;
+        std::vector<float> cells;
+        std::vector<char> present;
 
-static std::optional<float> parseOptionalFloat(const juce::String& s)
-{
-    auto t = s.trim();
-    if (t.isEmpty()) return {};
-    float v = t.getFloatValue();
-    if (std::isnan(v) && t != "nan") return {};
-    return v;
-}
+        explicit ParsedTable(int columns) : numColumns(columns) {}
 
-static std::vector<juce::String> tokenizeCsvLine(const juce::String& line)
-{
-    std::vector<juce::String> out;
-    juce::String current;
-    bool inQuotes = false;
-    for (int i = 0; i < line.length(); ++i)
-    {
-        juce::juce_wchar c = line[i];
-        if (c == '"') inQuotes = !inQuotes;
-        else if ((c == ',' && !inQuotes) || c == '\r')
+        /** Append an all-absent row (the vectors grow geometrically, so no row count up front); returns its first
+         *  cell index. */
+        size_t addRow()
         {
-            out.push_back(current.trim());
-            current = juce::String();
+            ++numRows;
+            cells.resize(cells.size() + static_cast<size_t>(numColumns), 0.0f);
+            present.resize(present.size() + static_cast<size_t>(numColumns), 0);
+            return present.size() - static_cast<size_t>(numColumns);
         }
-        else if (c != '\n')
-            current += c;
-    }
-    if (current.isNotEmpty())
-        out.push_back(current.trim());
-    return out;
-}
 
-static std::vector<CompressionRow> loadCompressionCurve(const juce::File& path)
-{
-    std::vector<CompressionRow> rows;
-    if (!path.existsAsFile()) return rows;
-    juce::String content = path.loadFileAsString();
-    juce::StringArray lines;
-    lines.addLines(content);
-    if (lines.size() < 2) return rows;
-    // Header: input_db,output_db,gain_reduction_db,threshold,ratio,knee,attack_ms,release_ms
-    int idxInput = -1, idxOutput = -1, idxGR = -1, idxThresh = -1, idxRatio = -1, idxAttack = -1, idxRelease = -1;
-    juce::StringArray headers;
-    headers.addTokens(lines[0], ",", "");
-    for (int i = 0; i < headers.size(); ++i)
-    {
-        auto h = headers[i].toLowerCase().trim();
-        if (h == "input_db") idxInput = i;
-        else if (h == "output_db") idxOutput = i;
-        else if (h == "gain_reduction_db") idxGR = i;
-        else if (h == "threshold") idxThresh = i;
-        else if (h == "ratio") idxRatio = i;
-        else if (h == "attack_ms") idxAttack = i;
-        else if (h == "release_ms") idxRelease = i;
-    }
-    for (int L = 1; L < lines.size(); ++L)
+        void set(size_t rowStart, int c, std::optional<float> v)
+        {
+            if (!v.has_value()) return;
+            cells[rowStart + static_cast<size_t>(c)] = *v;
+            present[rowStart + static_cast<size_t>(c)] = 1;
+        }
+
+        size_t numValues() const { return static_cast<size_t>(numRows) * static_cast<size_t>(numColumns); }
+        size_t numMaskWords() const { return (numValues() + 31) / 32; }
+    };
+
+    /** Column in a CSV header; isFlag columns hold True / False and load as 1 / 0. */
+    struct CsvColumn
     {
-        auto tokens = tokenizeCsvLine(lines[L]);
-        if (tokens.empty()) continue;
-        CompressionRow r;
-        if (idxInput >= 0 && idxInput < (int)tokens.size()) r.inputDb = parseFloat(tokens[(size_t)idxInput]);
-        if (idxOutput >= 0 && idxOutput < (int)tokens.size()) r.outputDb = parseFloat(tokens[(size_t)idxOutput]);
-        if (idxGR >= 0 && idxGR < (int)tokens.size()) r.gainReductionDb = parseFloat(tokens[(size_t)idxGR]);
-        if (idxThresh >= 0 && idxThresh < (int)tokens.size()) r.threshold = parseOptionalFloat(tokens[(size_t)idxThresh]);
-        if (idxRatio >= 0 && idxRatio < (int)tokens.size()) r.ratio = parseOptionalFloat(tokens[(size_t)idxRatio]);
-        if (idxAttack >= 0 && idxAttack < (int)tokens.size()) r.attackMs = parseOptionalFloat(tokens[(size_t)idxAttack]);
-        if (idxRelease >= 0 && idxRelease < (int)tokens.size()) r.releaseMs = parseOptionalFloat(tokens[(size_t)idxRelease]);
-        rows.push_back(r);
-    }
-    return rows;
-}
+        const char* header;
+        bool isFlag = false;
+    };
 
-static std::vector<TimingRow> loadTimingCsv(const juce::File& path)
-{
-    std::vector<TimingRow> rows;
-    if (!path.existsAsFile()) return rows;
-    juce::String content = path.loadFileAsString();
-    juce::StringArray lines;
-    lines.addLines(content);
-    if (lines.size() < 2) return rows;
-    juce::StringArray headers;
-    headers.addTokens(lines[0], ",", "");
-    int idxAP = -1, idxRP = -1, idxThresh = -1, idxRatio = -1, idxAtMs = -1, idxReMs = -1;
-    for (int i = 0; i < headers.size(); ++i)
+    /** File bytes for the parsers: memory-mapped (no copy) when the OS allows it, else read into memory. */
+    class FileText
     {
-        auto h = headers[i].toLowerCase().trim();
-        if (h == "attack_param") idxAP = i;
-        else if (h == "release_param") idxRP = i;
-        else if (h == "threshold") idxThresh = i;
-        else if (h == "ratio") idxRatio = i;
-        else if (h == "attack_time_ms") idxAtMs = i;
-        else if (h == "release_time_ms") idxReMs = i;
-    }
-    for (int L = 1; L < lines.size(); ++L)
+    public:
+        explicit FileText(const juce::File& file) : mapped_(file, juce::MemoryMappedFile::readOnly)
+        {
+            if (mapped_.getData() == nullptr && file.existsAsFile())
+                file.loadFileAsData(copy_);
+        }
+
+        const char* data() const noexcept
+        {
+            return static_cast<const char*>(mapped_.getData() != nullptr ? mapped_.getData() : copy_.getData());
+        }
+
+        size_t size() const noexcept { return mapped_.getData() != nullptr ? mapped_.getSize() : copy_.getSize(); }
+
+    private:
+        juce::MemoryMappedFile mapped_;
+        juce::MemoryBlock copy_;
+    };
+
+    /** thd_vs_level.json: one row per array element, from its level_db / thd_percent members. */
+    class ThdJsonReader : public JsonObjectArrayReader
     {
-        auto tokens = tokenizeCsvLine(lines[L]);
-        if (tokens.empty()) continue;
-        TimingRow r;
-        if (idxAP >= 0 && idxAP < (int)tokens.size()) r.attackParam = parseOptionalFloat(tokens[(size_t)idxAP]);
-        if (idxRP >= 0 && idxRP < (int)tokens.size()) r.releaseParam = parseOptionalFloat(tokens[(size_t)idxRP]);
-        if (idxThresh >= 0 && idxThresh < (int)tokens.size()) r.threshold = parseOptionalFloat(tokens[(size_t)idxThresh]);
-        if (idxRatio >= 0 && idxRatio < (int)tokens.size()) r.ratio = parseOptionalFloat(tokens[(size_t)idxRatio]);
-        if (idxAtMs >= 0 && idxAtMs < (int)tokens.size()) r.attackTimeMs = parseOptionalFloat(tokens[(size_t)idxAtMs]);
-        if (idxReMs >= 0 && idxReMs < (int)tokens.size()) r.releaseTimeMs = parseOptionalFloat(tokens[(size_t)idxReMs]);
-        rows.push_back(r);
-    }
-    return rows;
+    public:
+        explicit ThdJsonReader(ParsedTable& table) : table_(table) {}
+
+    private:
+        void beginObject() override { row_ = table_.addRow(); }
+
+        void numberMember(std::string_view key, double value) override
+        {
+            if (key == "level_db") table_.set(row_, THDColumn::LevelDb, static_cast<float>(value));
+            else if (key == "thd_percent") table_.set(row_, THDColumn::ThdPercent, static_cast<float>(value));
+        }
+
+        ParsedTable& table_;
+        size_t row_ = 0;
+    };
 }
 
-static std::vector<FRRow> loadFrequencyResponse(const juce::File& path)
+/** Load the listed columns (in that order) of a headed CSV in one pass; header names are matched case-insensitively. */
+static ParsedTable loadCsv(const juce::File& path, std::initializer_list<CsvColumn> columns)
 {
-    std::vector<FRRow> rows;
-    if (!path.existsAsFile()) return rows;
-    juce::String content = path.loadFileAsString();
-    juce::StringArray lines;
-    lines.addLines(content);
-    if (lines.size() < 2) return rows;
-    juce::StringArray headers;
-    headers.addTokens(lines[0], ",", "");
-    int idxFreq = -1, idxMag = -1, idxDrive = -1;
-    for (int i = 0; i < headers.size(); ++i)
+    ParsedTable table(static_cast<int>(columns.size()));
+    const FileText text(path);
+    if (text.size() == 0) return table;
+
+    CsvReader reader(text.data(), text.size());
+    if (!reader.nextRow()) return table;
+    std::vector<int> fileIndex;
+    for (const auto& column : columns)
     {
-        auto h = headers[i].toLowerCase().trim();
-        if (h == "frequency_hz") idxFreq = i;
-        else if (h == "magnitude_db") idxMag = i;
-        else if (h == "drive_level_db") idxDrive = i;
+        int found = -1;
+        for (int i = 0; i < reader.getNumFields() && found < 0; ++i)
+            if (headerEquals(reader.getField(i), column.header))
+                found = i;
+        fileIndex.push_back(found);
     }
-    for (int L = 1; L < lines.size(); ++L)
+
+    while (reader.nextRow())
     {
-        auto tokens = tokenizeCsvLine(lines[L]);
-        if (tokens.empty()) continue;
-        FRRow r;
-        if (idxFreq >= 0 && idxFreq < (int)tokens.size()) r.frequencyHz = parseOptionalFloat(tokens[(size_t)idxFreq]);
-        if (idxMag >= 0 && idxMag < (int)tokens.size()) r.magnitudeDb = parseOptionalFloat(tokens[(size_t)idxMag]);
-        if (idxDrive >= 0 && idxDrive < (int)tokens.size()) r.driveLevelDb = parseOptionalFloat(tokens[(size_t)idxDrive]);
-        rows.push_back(r);
+        const size_t row = table.addRow();
+        int c = 0;
+        for (const auto& column : columns)
+        {
+            const int idx = fileIndex[static_cast<size_t>(c)];
+            if (idx >= 0 && idx < reader.getNumFields())
+            {
+                const auto field = reader.getField(idx);
+                table.set(row, c, column.isFlag ? std::optional<float>(parseFlag(field) ? 1.0f : 0.0f) : parseNumber(field));
+            }
+            ++c;
+        }
     }
-    return rows;
+    return table;
 }
 
-static std::vector<THDRow> loadThdJson(const juce::File& path)
+static ParsedTable loadThdJson(const juce::File& path)
 {
-    std::vector<THDRow> rows;
-    if (!path.existsAsFile()) return rows;
-    juce::var json;
-    if (!juce::JSON::parse(path.loadFileAsString(), json).wasOk() || !json.isArray()) return rows;
-    const auto* arr = json.getArray();
-    if (!arr) return rows;
-    for (const auto& item : *arr)
-    {
-        if (!item.isObject()) continue;
-        auto* obj = item.getDynamicObject();
-        if (!obj) continue;
-        THDRow r;
-        if (obj->hasProperty("level_db")) r.levelDb = (float)obj->getProperty("level_db");
-        if (obj->hasProperty("thd_percent")) r.thdPercent = (float)obj->getProperty("thd_percent");
-        rows.push_back(r);
-    }
-    return rows;
+    ParsedTable table(THDColumn::NumColumns);
+    const FileText text(path);
+    ThdJsonReader reader(table);
+    if (text.size() == 0 || !reader.read(text.data(), text.size()))
+        return ParsedTable(THDColumn::NumColumns);   // malformed: no rows, as before
+    return table;
 }
 
 AnalyzerOutput loadAnalyzerOutput(const juce::File& outputDir)
 {
+    std::array<ParsedTable, 4> parsed {
+        loadCsv(outputDir.getChildFile("compression_curve.csv"),
+                { { "input_db" }, { "output_db" }, { "gain_reduction_db" }, { "threshold" }, { "ratio" },
+                  { "attack_ms" }, { "release_ms" } }),
+        loadCsv(outputDir.getChildFile("timing.csv"),
+                { { "attack_param" }, { "release_param" }, { "threshold" }, { "ratio" },
+                  { "attack_time_ms" }, { "release_time_ms" }, { "measurement_ok", true } }),
+        loadCsv(outputDir.getChildFile("frequency_response.csv"),
+                { { "frequency_hz" }, { "magnitude_db" }, { "drive_level_db" } }),
+        loadThdJson(outputDir.getChildFile("thd_vs_level.json"))
+    };
+
+    // One block: every table's columns, then every table's presence words (floats first keeps both aligned)
+    size_t numValues = 0, numMaskWords = 0;
+    for (const auto& t : parsed)
+    {
+        numValues += t.numValues();
+        numMaskWords += t.numMaskWords();
+    }
+
     AnalyzerOutput out;
-    out.compressionRows = loadCompressionCurve(outputDir.getChildFile("compression_curve.csv"));
-    out.timingRows = loadTimingCsv(outputDir.getChildFile("timing.csv"));
-    out.frRows = loadFrequencyResponse(outputDir.getChildFile("frequency_response.csv"));
-    out.thdRows = loadThdJson(outputDir.getChildFile("thd_vs_level.json"));
+    out.arenaBytes_ = numValues * sizeof(float) + numMaskWords * sizeof(std::uint32_t);
+    out.arena_.calloc(juce::jmax<size_t>(1, out.arenaBytes_));
+    auto* values = reinterpret_cast<float*>(out.arena_.get());
+    auto* masks = reinterpret_cast<std::uint32_t*>(values + numValues);
+
+    std::array<ColumnTable*, 4> tables { &out.compression, &out.timing, &out.fr, &out.thd };
+    for (size_t t = 0; t < parsed.size(); ++t)
+    {
+        const auto& src = parsed[t];
+        auto& dst = *tables[t];
+        dst.numRows = src.numRows;
+        dst.numColumns = src.numColumns;
+        dst.values = values;
+        dst.presence = masks;
+        for (int c = 0; c < src.numColumns; ++c)
+        {
+            for (int r = 0; r < src.numRows; ++r)
+            {
+                const size_t cell = static_cast<size_t>(r) * static_cast<size_t>(src.numColumns) + static_cast<size_t>(c);
+                const size_t bit = static_cast<size_t>(c) * static_cast<size_t>(src.numRows) + static_cast<size_t>(r);
+                values[bit] = src.cells[cell];
+                if (src.present[cell])
+                    masks[bit >> 5] |= 1u << (bit & 31);
+            }
+        }
+        values += src.numValues();
+        masks += src.numMaskWords();
+    }
     return out;
 }
 
@@ -1,46 +1,72 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <vector>
+#include <cstdint>
 #include <optional>
 
 namespace emulation {
 
-struct CompressionRow {
-    float inputDb = 0;
-    float outputDb = 0;
-    float gainReductionDb = 0;
-    std::optional<float> threshold;
-    std::optional<float> ratio;
-    std::optional<float> attackMs;
-    std::optional<float> releaseMs;
-};
+/** Column indices of each analyzer table (file columns that are not listed are not loaded). */
+namespace CompressionColumn { enum Index : int { InputDb, OutputDb, GainReductionDb, Threshold, Ratio, AttackMs, ReleaseMs, NumColumns }; }
+namespace TimingColumn { enum Index : int { AttackParam, ReleaseParam, Threshold, Ratio, AttackTimeMs, ReleaseTimeMs,
+                                            MeasurementOk,   // 1 / 0; absent = usable. False rows are not usable times
+                                            NumColumns }; }
+namespace FRColumn { enum Index : int { FrequencyHz, MagnitudeDb, DriveLevelDb, NumColumns }; }
+namespace THDColumn { enum Index : int { LevelDb, ThdPercent, NumColumns }; }
 
-struct TimingRow {
-    std::optional<float> attackParam;
-    std::optional<float> releaseParam;
-    std::optional<float> threshold;
-    std::optional<float> ratio;
-    std::optional<float> attackTimeMs;
-    std::optional<float> releaseTimeMs;
-};
+/** One analyzer table stored column-wise: each column is a contiguous run of numRows floats, and one presence bit per
+ *  cell marks which values were actually in the file (blank, unparseable or missing-column cells are absent and read
+ *  as 0). A view into the arena of the AnalyzerOutput it came from; valid while that is alive. */
+struct ColumnTable
+{
+    int numRows = 0;
+    int numColumns = 0;
+    const float* values = nullptr;              // column c starts at values + c * numRows
+    const std::uint32_t* presence = nullptr;    // bit (c * numRows + row)
 
-struct FRRow {
-    std::optional<float> frequencyHz;
-    std::optional<float> magnitudeDb;
-    std::optional<float> driveLevelDb;
-};
+    bool isEmpty() const noexcept { return numRows == 0; }
+
+    const float* column(int c) const noexcept { return values + static_cast<size_t>(c) * static_cast<size_t>(numRows); }
+
+    bool has(int c, int row) const noexcept
+    {
+        const auto bit = static_cast<size_t>(c) * static_cast<size_t>(numRows) + static_cast<size_t>(row);
+        return ((presence[bit >> 5] >> (bit & 31)) & 1u) != 0;
+    }
 
-struct THDRow {
-    std::optional<float> levelDb;
-    std::optional<float> thdPercent;
+    std::optional<float> get(int c, int row) const noexcept
+    {
+        if (!has(c, row)) return {};
+        return column(c)[row];
+    }
 };
 
-struct AnalyzerOutput {
-    std::vector<CompressionRow> compressionRows;
-    std::vector<TimingRow> timingRows;
-    std::vector<FRRow> frRows;
-    std::vector<THDRow> thdRows;
+/** All analyzer tables of one data set. Every column and presence mask lives in a single heap block allocated once
+ *  per load; the parsed text and intermediate rows are dropped before loadAnalyzerOutput() returns. Move-only: the
+ *  tables point into the block, which a move hands over intact. Consumers build what they need (lattices, IRs) at
+ *  construction and need not keep the data set alive afterwards. */
+class AnalyzerOutput
+{
+public:
+    AnalyzerOutput() = default;
+    AnalyzerOutput(AnalyzerOutput&&) noexcept = default;
+    AnalyzerOutput& operator=(AnalyzerOutput&&) noexcept = default;
+
+    ColumnTable compression;
+    ColumnTable timing;
+    ColumnTable fr;
+    ColumnTable thd;
+
+    /** Bytes held by the data set (its one arena). */
+    size_t getMemoryBytes() const noexcept { return arenaBytes_; }
+
+private:
+    friend AnalyzerOutput loadAnalyzerOutput(const juce::File& outputDir);
+
+    juce::HeapBlock<char> arena_;
+    size_t arenaBytes_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(AnalyzerOutput)
 };
 
 /** Load all analyzer outputs from a directory (compression_curve.csv, timing.csv, frequency_response.csv, thd_vs_level.json). */
@@ -1,47 +1,36 @@
 #include "FRCharacter.h"
+#include "MonotoneCubic.h"
 #include <algorithm>
 #include <cmath>
 #include <map>
 
 namespace emulation {
 
-static float interp1d(const std::vector<float>& x, const std::vector<float>& y, float xq)
-{
-    if (x.empty() || x.size() != y.size()) return 1.0f;
-    if (xq <= x.front()) return y.front();
-    if (xq >= x.back()) return y.back();
-    size_t i = 0;
-    while (i + 1 < x.size() && x[i + 1] <= xq) ++i;
-    if (i + 1 >= x.size()) return y.back();
-    float t = (xq - x[i]) / (x[i + 1] - x[i]);
-    return y[i] + t * (y[i + 1] - y[i]);
-}
-
-FRCharacter::FRCharacter(const std::vector<FRRow>& frRows, double sampleRate,
+FRCharacter::FRCharacter(const ColumnTable& fr, double sampleRate,
                          std::optional<float> driveLevelDb, int irLength)
 {
+    using namespace FRColumn;
     irLength = std::max(1, irLength);
     int order = (int)std::round(std::log2(irLength));
     int nFft = 1 << order;
     ir_.resize((size_t)nFft, 0.0f);
     ir_[0] = 1.0f;
-    if (frRows.empty()) return;
+    if (fr.isEmpty()) return;
 
-    std::vector<FRRow> rows;
-    if (driveLevelDb.has_value())
-    {
-        for (const auto& r : frRows)
-            if (r.driveLevelDb.has_value() && std::abs(*r.driveLevelDb - *driveLevelDb) < 0.01f)
-                rows.push_back(r);
-    }
-    if (rows.empty()) rows = frRows;
-    if (rows.empty()) return;
+    // Rows at the requested drive level, or all rows if none match
+    auto atDrive = [&](int r) {
+        return driveLevelDb.has_value() && fr.has(DriveLevelDb, r)
+               && std::abs(fr.column(DriveLevelDb)[r] - *driveLevelDb) < 0.01f;
+    };
+    bool anyAtDrive = false;
+    for (int r = 0; r < fr.numRows && !anyAtDrive; ++r)
+        anyAtDrive = atDrive(r);
 
     std::map<float, std::vector<float>> byFreq;
-    for (const auto& r : rows)
+    for (int r = 0; r < fr.numRows; ++r)
     {
-        if (r.frequencyHz.has_value() && r.magnitudeDb.has_value())
-            byFreq[*r.frequencyHz].push_back(*r.magnitudeDb);
+        if ((!anyAtDrive || atDrive(r)) && fr.has(FrequencyHz, r) && fr.has(MagnitudeDb, r))
+            byFreq[fr.column(FrequencyHz)[r]].push_back(fr.column(MagnitudeDb)[r]);
     }
     std::vector<float> freqs, magDb;
     for (const auto& p : byFreq)
@@ -68,9 +57,12 @@ FRCharacter::FRCharacter(const std::vector<FRRow>& frRows, double sampleRate,
     std::vector<float> binFreqs((size_t)nBins);
     for (int i = 0; i < nBins; ++i)
         binFreqs[(size_t)i] = (float)(i * sampleRate / nFft);
+    // Monotone cubic through the measured points: smooth between them, no ripple the measurement does not have
+    MonotoneCubic magnitude;
+    magnitude.fit(sortedFreqs, magLinear);
     std::vector<float> magAtBins((size_t)nBins);
     for (int i = 0; i < nBins; ++i)
-        magAtBins[(size_t)i] = interp1d(sortedFreqs, magLinear, binFreqs[(size_t)i]);
+        magAtBins[(size_t)i] = magnitude(binFreqs[(size_t)i]);
 
     // JUCE real-only FFT buffer: [Re(0), Re(Nyquist), Re(1), Im(1), Re(2), Im(2), ...]
     std::vector<float> fftBuffer((size_t)nFft);
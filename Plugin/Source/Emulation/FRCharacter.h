@@ -11,7 +11,7 @@ namespace emulation {
 class FRCharacter
 {
 public:
-    FRCharacter(const std::vector<FRRow>& frRows, double sampleRate,
+    FRCharacter(const ColumnTable& fr, double sampleRate,
                 std::optional<float> driveLevelDb = {},
                 int irLength = 256);
 
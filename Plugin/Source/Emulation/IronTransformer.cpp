@@ -43,6 +43,8 @@ void IronTransformer::prepare(double sampleRate)
     drive_ = 0.0f;
     asymmetry_ = 0.0f;
     wet_ = 0.0f;
+    coeffMode_ = -1;
+    coeffAmount_ = -1.0f;
     lfPreCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
         sampleRate, kLfShelfFreqHz, 0.707f, 1.0f);
     lfPostCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
@@ -57,30 +59,37 @@ void IronTransformer::prepare(double sampleRate)
     }
 }
 
+void IronTransformer::reset() noexcept
+{
+    for (auto* filters : { &lfPre_, &lfPost_, &hfShelf_ })
+        for (auto& f : *filters)
+            f.reset();
+}
+
 void IronTransformer::updateCoeffs(int mode, float ironAmount)
 {
-    getModeCoeffs(mode, ironAmount, lfGainDb_, hfFreqHz_, asymmetryScale_);
     float amt = juce::jlimit(0.0f, 1.0f, ironAmount);
+    if (mode == coeffMode_ && amt == coeffAmount_)
+        return;
+    coeffMode_ = mode;
+    coeffAmount_ = amt;
+
+    getModeCoeffs(mode, ironAmount, lfGainDb_, hfFreqHz_, asymmetryScale_);
     drive_ = amt * kMaxDrive;
     asymmetry_ = 0.15f * amt * asymmetryScale_;
     wet_ = amt;
 
-    if (sampleRate_ > 0)
+    // Coefficients are rewritten in place (no allocation); filters already point at these objects.
+    if (sampleRate_ > 0 && lfPreCoeffs_ && lfPostCoeffs_ && hfShelfCoeffs_)
     {
         float lfGainLinear = std::pow(10.0f, lfGainDb_ / 20.0f);
-        lfPreCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
+        *lfPreCoeffs_ = juce::dsp::IIR::ArrayCoefficients<float>::makeLowShelf(
             sampleRate_, kLfShelfFreqHz, 0.707f, lfGainLinear);
-        lfPostCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
+        *lfPostCoeffs_ = juce::dsp::IIR::ArrayCoefficients<float>::makeLowShelf(
             sampleRate_, kLfShelfFreqHz, 0.707f, 1.0f / lfGainLinear);
         float hfGain = 0.5f;
-        hfShelfCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
+        *hfShelfCoeffs_ = juce::dsp::IIR::ArrayCoefficients<float>::makeHighShelf(
             sampleRate_, hfFreqHz_, 0.707f, hfGain);
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            if (lfPreCoeffs_) lfPre_[ch].coefficients = lfPreCoeffs_;
-            if (lfPostCoeffs_) lfPost_[ch].coefficients = lfPostCoeffs_;
-            if (hfShelfCoeffs_) hfShelf_[ch].coefficients = hfShelfCoeffs_;
-        }
     }
 }
 
@@ -12,6 +12,8 @@ public:
     IronTransformer() = default;
 
     void prepare(double sampleRate);
+    /** Clear the shelf filter history; coefficients stay. */
+    void reset() noexcept;
     /** Process buffer. mode: 0=Opto, 1=FET, 2=PWM. ironAmount: 0–1 (0=bypass). */
     void process(juce::AudioBuffer<float>& buffer, int mode, float ironAmount);
 
@@ -37,6 +39,10 @@ private:
     float hfFreqHz_ = 10000.0f;
     float asymmetryScale_ = 1.0f;
 
+    // Last (mode, amount) the coefficients were computed for; avoids recomputing every block.
+    int coeffMode_ = -1;
+    float coeffAmount_ = -1.0f;
+
     static constexpr float kLfShelfFreqHz = 200.0f;
     static constexpr float kMaxDrive = 2.5f;
 };
@@ -0,0 +1,117 @@
+#include "LoudnessMeter.h"
+#include <cmath>
+
+namespace emulation {
+
+namespace {
+
+float energyToLufs(double meanSquare)
+{
+    if (meanSquare <= 0.0)
+        return LoudnessMeter::kFloorLufs;
+    return juce::jmax(LoudnessMeter::kFloorLufs, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)));
+}
+
+// Mean square of a block at the -70 LUFS absolute gate.
+const double kAbsoluteGateEnergy = std::pow(10.0, (-70.0 + 0.691) / 10.0);
+
+} // namespace
+
+void LoudnessMeter::prepare(double sampleRate, int numChannels)
+{
+    // K-weighting for any sample rate (BS.1770 stage parameters; matches the 48 kHz table in the recommendation).
+    const double pi = juce::MathConstants<double>::pi;
+    {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const double k = std::tan(pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        stages_[0] = { (vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+                       2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+    }
+    {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        const double k = std::tan(pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+        stages_[1] = { 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+    }
+    blockLength_ = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+    state_.assign(static_cast<size_t>(juce::jmax(1, numChannels)), ChannelState{});
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (auto& s : state_)
+        s = ChannelState{};
+    blockFill_ = 0;
+    blockEnergy_ = 0.0;
+    blockMeans_.fill(0.0);
+    blocksWritten_ = 0;
+    momentaryLufs_ = shortTermLufs_ = gatedShortTermLufs_ = kFloorLufs;
+}
+
+void LoudnessMeter::process(const float* const* channels, int numChannels, int numSamples)
+{
+    numChannels = juce::jmin(numChannels, static_cast<int>(state_.size()));
+    int pos = 0;
+    while (pos < numSamples)
+    {
+        const int todo = juce::jmin(numSamples - pos, blockLength_ - blockFill_);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& st = state_[static_cast<size_t>(ch)];
+            const float* x = channels[ch] + pos;
+            double sum = 0.0;
+            for (int i = 0; i < todo; ++i)
+            {
+                double v = x[i];
+                for (int s = 0; s < 2; ++s)
+                {
+                    const auto& f = stages_[static_cast<size_t>(s)];
+                    const double y = f.b0 * v + st.z1[s];
+                    st.z1[s] = f.b1 * v - f.a1 * y + st.z2[s];
+                    st.z2[s] = f.b2 * v - f.a2 * y;
+                    v = y;
+                }
+                sum += v * v;
+            }
+            blockEnergy_ += sum;
+        }
+        blockFill_ += todo;
+        pos += todo;
+        if (blockFill_ >= blockLength_)
+            finishBlock();
+    }
+}
+
+void LoudnessMeter::finishBlock()
+{
+    blockMeans_[static_cast<size_t>(blocksWritten_ % kShortTermBlocks)] = blockEnergy_ / blockLength_;
+    ++blocksWritten_;
+    blockEnergy_ = 0.0;
+    blockFill_ = 0;
+
+    // Windows are averaged over the blocks seen so far until they fill (first 400 ms / 3 s after reset).
+    double momentary = 0.0, shortTerm = 0.0, gated = 0.0;
+    int gatedCount = 0;
+    const int available = juce::jmin(blocksWritten_, kShortTermBlocks);
+    for (int i = 0; i < available; ++i)
+    {
+        const double e = blockMeans_[static_cast<size_t>((blocksWritten_ - 1 - i) % kShortTermBlocks)];
+        if (i < kMomentaryBlocks)
+            momentary += e;
+        shortTerm += e;
+        if (e > kAbsoluteGateEnergy)
+        {
+            gated += e;
+            ++gatedCount;
+        }
+    }
+    momentaryLufs_ = energyToLufs(momentary / juce::jmin(available, kMomentaryBlocks));
+    shortTermLufs_ = energyToLufs(shortTerm / available);
+    gatedShortTermLufs_ = gatedCount > 0 ? energyToLufs(gated / gatedCount) : kFloorLufs;
+}
+
+} // namespace emulation
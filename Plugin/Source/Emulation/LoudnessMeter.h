@@ -0,0 +1,60 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace emulation {
+
+/** ITU-R BS.1770 / EBU R128 loudness: K-weighting (shelf + RLB high-pass, double-precision biquads) and
+ *  100 ms energy blocks in a 3 s ring. Momentary = last 400 ms, short-term = last 3 s (both ungated, as in R128);
+ *  the gated short-term mean skips blocks below the -70 LUFS absolute gate so pauses don't pull it down.
+ *  prepare() allocates; process() is allocation-free (audio thread). Values update every 100 ms. */
+class LoudnessMeter
+{
+public:
+    static constexpr float kFloorLufs = -70.0f;
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    /** Channels 0/1 are weighted 1.0 (L/R); numChannels beyond prepare() are ignored. */
+    void process(const float* const* channels, int numChannels, int numSamples);
+    void process(const juce::AudioBuffer<float>& buffer)
+    {
+        process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+    }
+
+    float getMomentaryLufs() const { return momentaryLufs_; }
+    float getShortTermLufs() const { return shortTermLufs_; }
+    /** Short-term mean over blocks above the absolute gate; kFloorLufs when none are. */
+    float getGatedShortTermLufs() const { return gatedShortTermLufs_; }
+
+private:
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+    struct ChannelState
+    {
+        double z1[2]{}, z2[2]{};   // transposed direct form II state, per stage
+    };
+
+    static constexpr int kMomentaryBlocks = 4;    // 400 ms
+    static constexpr int kShortTermBlocks = 30;   // 3 s
+
+    void finishBlock();
+
+    std::array<Biquad, 2> stages_;   // 0 = pre-filter shelf, 1 = RLB high-pass
+    std::vector<ChannelState> state_;
+    int blockLength_ = 4800;
+    int blockFill_ = 0;
+    double blockEnergy_ = 0.0;
+    std::array<double, kShortTermBlocks> blockMeans_{};
+    int blocksWritten_ = 0;
+    float momentaryLufs_ = kFloorLufs;
+    float shortTermLufs_ = kFloorLufs;
+    float gatedShortTermLufs_ = kFloorLufs;
+};
+
+} // namespace emulation
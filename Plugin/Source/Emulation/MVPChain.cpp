@@ -25,26 +25,71 @@ MVPChain::MVPChain(Mode mode, double sampleRate,
     , neonBeforeCompressor_(neonBeforeCompressor)
 {
     juce::File dataDir = (mode == Mode::VCA) ? vcaDataDir : ((mode == Mode::FET) ? fetishDataDir : lalaDataDir);
-    AnalyzerOutput data = loadAnalyzerOutput(dataDir);
+    // The data set only lives for this constructor: each stage keeps its own compact tables
+    const AnalyzerOutput data = loadAnalyzerOutput(dataDir);
     compressor_ = std::make_unique<MeasuredCompressor>(data);
-
-    if (characterFr && !data.frRows.empty())
-        frCharacter_ = std::make_unique<FRCharacter>(data.frRows, sampleRate, characterFrDriveDb);
-    if (characterThd && !data.thdRows.empty())
-        thdCharacter_ = std::make_unique<THDCharacter>(data.thdRows, -4.0f, characterThdMix);
+    addCharacter(data, characterFr, characterThd, characterFrDriveDb, characterThdMix);
     neonEnabled_ = neonEnable;
     neonBeforeCompressor_ = neonBeforeCompressor;
     if (neonEnable)
-    {
-        neon_ = std::make_unique<NeonTapeSaturation>(sampleRate);
-        neon_->setDepth(neonDepth);
-        neon_->setModulationBandwidthHz(neonModulationBandwidthHz);
-        neon_->setToneFilterCutoffHz(400.0f + (neonModulationBandwidthHz - 200.0f) / 4800.0f * 11600.0f); // 0..1 tone -> 400 Hz..12 kHz
-        neon_->setBurstiness(neonBurstiness);
-        neon_->setGMin(neonGMin);
-        neon_->setDryWet(neonDryWet);
-        neon_->setSaturationAfter(neonSaturationAfter);
-    }
+        createNeon(neonDepth, neonModulationBandwidthHz, neonBurstiness, neonGMin, neonDryWet, neonSaturationAfter);
+}
+
+MVPChain::MVPChain(Mode mode, double sampleRate,
+                   std::shared_ptr<const MeasuredCompressor::Tables> tables,
+                   bool neonEnable,
+                   bool neonBeforeCompressor,
+                   float neonDepth,
+                   float neonModulationBandwidthHz,
+                   float neonBurstiness,
+                   float neonGMin,
+                   float neonDryWet,
+                   bool neonSaturationAfter)
+    : mode_(mode)
+    , sampleRate_(sampleRate)
+    , neonBeforeCompressor_(neonBeforeCompressor)
+{
+    if (tables != nullptr)
+        compressor_ = std::make_unique<MeasuredCompressor>(std::move(tables));
+    neonEnabled_ = neonEnable;
+    if (neonEnable)
+        createNeon(neonDepth, neonModulationBandwidthHz, neonBurstiness, neonGMin, neonDryWet, neonSaturationAfter);
+}
+
+void MVPChain::createNeon(float depth, float modulationBandwidthHz, float burstiness, float gMin, float dryWet, bool saturationAfter)
+{
+    neon_ = std::make_unique<NeonTapeSaturation>(sampleRate_);
+    neon_->setDepth(depth);
+    neon_->setModulationBandwidthHz(modulationBandwidthHz);
+    neon_->setToneFilterCutoffHz(400.0f + (modulationBandwidthHz - 200.0f) / 4800.0f * 11600.0f); // 0..1 tone -> 400 Hz..12 kHz
+    neon_->setBurstiness(burstiness);
+    neon_->setGMin(gMin);
+    neon_->setDryWet(dryWet);
+    neon_->setSaturationAfter(saturationAfter);
+}
+
+void MVPChain::prepare(int maxBlockSize, int numChannels)
+{
+    if (compressor_)
+        compressor_->prepare(maxBlockSize, numChannels);
+}
+
+void MVPChain::reset() noexcept
+{
+    if (compressor_)
+        compressor_->reset();
+    if (neon_)
+        neon_->reset();
+    lastGrDb_ = 0.0f;
+}
+
+void MVPChain::addCharacter(const AnalyzerOutput& data, bool characterFr, bool characterThd,
+                            std::optional<float> characterFrDriveDb, float characterThdMix)
+{
+    if (characterFr && !data.fr.isEmpty())
+        frCharacter_ = std::make_unique<FRCharacter>(data.fr, sampleRate_, characterFrDriveDb);
+    if (characterThd && !data.thd.isEmpty())
+        thdCharacter_ = std::make_unique<THDCharacter>(data.thd, -4.0f, characterThdMix);
 }
 
 void MVPChain::process(juce::AudioBuffer<float>& buffer,
@@ -70,11 +115,16 @@ void MVPChain::process(juce::AudioBuffer<float>& buffer,
         releaseParam = std::nullopt;
     }
 
+    OMBIC_STAGE_TICKS(ticks);
     if (neon_ && neonEnabled_ && neonBeforeCompressor_)
+    {
+        OMBIC_STAGE_SCOPE(ticks, Neon);
         neon_->process(buffer);
+    }
 
     if (compressor_)
     {
+        OMBIC_STAGE_SCOPE(ticks, Compressor);
         if (mode_ == Mode::Opto && externalDetectorBuffer == nullptr)
             compressor_->setSidechainOptoOptions(true, optoLimitMode.value_or(false), sampleRate_);
         else if (mode_ == Mode::Opto && externalDetectorBuffer != nullptr)
@@ -92,12 +142,19 @@ void MVPChain::process(juce::AudioBuffer<float>& buffer,
         }
     }
 
-    if (frCharacter_)
-        frCharacter_->process(buffer);
-    if (thdCharacter_)
-        thdCharacter_->process(buffer);
+    {
+        OMBIC_STAGE_SCOPE(ticks, Compressor);
+        if (frCharacter_)
+            frCharacter_->process(buffer);
+        if (thdCharacter_)
+            thdCharacter_->process(buffer);
+    }
     if (neon_ && neonEnabled_ && !neonBeforeCompressor_)
+    {
+        OMBIC_STAGE_SCOPE(ticks, Neon);
         neon_->process(buffer);
+    }
+    OMBIC_STAGE_COMMIT(stageProfiler_, ticks, buffer.getNumSamples());
 }
 
 void MVPChain::setNeonParams(float depth, float modulationBandwidthHz, float toneFilterCutoffHz, float burstiness, float gMin, float dryWet, float intensity, bool saturationAfter)
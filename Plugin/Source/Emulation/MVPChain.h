@@ -5,6 +5,7 @@
 #include "FRCharacter.h"
 #include "THDCharacter.h"
 #include "NeonTapeSaturation.h"
+#include "StageProfiler.h"
 #include <JuceHeader.h>
 #include <memory>
 #include <optional>
@@ -34,6 +35,30 @@ public:
              float neonDryWet = 1.0f,
              bool neonSaturationAfter = false);
 
+    /** Compressor on already built (e.g. CurveStore-shared) tables instead of loading a directory; no FR/THD character. */
+    MVPChain(Mode mode, double sampleRate,
+             std::shared_ptr<const MeasuredCompressor::Tables> tables,
+             bool neonEnable = false,
+             bool neonBeforeCompressor = false,
+             float neonDepth = 0.02f,
+             float neonModulationBandwidthHz = 1000.0f,
+             float neonBurstiness = 0.0f,
+             float neonGMin = 0.92f,
+             float neonDryWet = 1.0f,
+             bool neonSaturationAfter = false);
+
+    /** Add the FR and / or THD character stages built from a loaded data set (e.g. one shared by many offline chains;
+     *  it need not outlive the chain). Not for the audio thread. */
+    void addCharacter(const AnalyzerOutput& data, bool characterFr, bool characterThd,
+                      std::optional<float> characterFrDriveDb = {}, float characterThdMix = 1.0f);
+
+    /** Size scratch buffers for blocks up to maxBlockSize samples. Call from prepareToPlay, never from the audio thread. */
+    void prepare(int maxBlockSize, int numChannels = 2);
+
+    /** Clear the compressor envelope and Neon state (e.g. between offline renders); tables and settings stay. Not
+     *  while process() runs. */
+    void reset() noexcept;
+
     /** Process buffer. FET: threshold (dB), ratio, attack_param, release_param. Opto: threshold (0–100). optoLimitMode: when Opto, true = Limit (more HF in sidechain).
      *  externalDetectorBuffer: optional SC-filtered mono buffer for level detection; when set, compressor uses it instead of main buffer for detector.
      *  fetCharacter: only used when mode is FET. 0 = Off, 1 = Rev A, 2 = LN. */
@@ -51,10 +76,17 @@ public:
     void setNeonEnabled(bool enabled) { neonEnabled_ = enabled; }
     void setNeonBeforeCompressor(bool before) { neonBeforeCompressor_ = before; }
 
+    /** Neon and Compressor (incl. FR/THD character) time is committed here per process() call when
+     *  OMBIC_STAGE_PROFILING is on. nullptr disables. Set before processing starts. */
+    void setStageProfiler(StageProfiler* profiler) { stageProfiler_ = profiler; }
+
     MeasuredCompressor* getCompressor() { return compressor_.get(); }
+    const MeasuredCompressor* getCompressor() const { return compressor_.get(); }
     float getLastGainReductionDb() const { return lastGrDb_; }
 
 private:
+    void createNeon(float depth, float modulationBandwidthHz, float burstiness, float gMin, float dryWet, bool saturationAfter);
+
     Mode mode_;
     double sampleRate_;
     std::unique_ptr<MeasuredCompressor> compressor_;
@@ -64,6 +96,7 @@ private:
     bool neonBeforeCompressor_ = false;
     bool neonEnabled_ = false;
     mutable float lastGrDb_ = 0.0f;
+    StageProfiler* stageProfiler_ = nullptr;
 };
 
 } // namespace emulation
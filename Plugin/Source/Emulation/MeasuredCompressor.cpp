@@ -1,4 +1,5 @@
 #include "MeasuredCompressor.h"
+#include "CurveMorph.h"
 #include <algorithm>
 #include <cmath>
 
@@ -15,21 +16,82 @@ static constexpr double kSidechainLpfHz = 2400.0;
 static constexpr double kSidechainShelfHz = 2000.0;
 static constexpr float kSidechainShelfGainDb = 2.5f;
 
-static float interp1d(const std::vector<float>& x, const std::vector<float>& y, float xq)
+MeasuredCompressor::Tables::Tables(const AnalyzerOutput& data)
 {
-    if (x.empty() || x.size() != y.size()) return 0.0f;
-    if (xq <= x.front()) return y.front();
-    if (xq >= x.back()) return y.back();
-    size_t i = 0;
-    while (i + 1 < x.size() && x[i + 1] <= xq) ++i;
-    if (i + 1 >= x.size()) return y.back();
-    float t = (xq - x[i]) / (x[i + 1] - x[i]);
-    return y[i] + t * (y[i + 1] - y[i]);
+    curves.build(CurveLattice::groupCurves(data.compression));
+    timing.build(data.timing);
 }
 
-MeasuredCompressor::MeasuredCompressor(const AnalyzerOutput& data) : data_(data)
+MeasuredCompressor::MeasuredCompressor(const AnalyzerOutput& data)
+    : MeasuredCompressor(std::make_shared<const Tables>(data))
 {
-    buildCurveCache();
+}
+
+MeasuredCompressor::MeasuredCompressor(std::shared_ptr<const Tables> tables)
+    : tables_(new TablesRef(std::move(tables)))
+{
+    // Unity biquads; real coefficients are written in place by setSidechainOptoOptions().
+    lpfCoeffs_ = new juce::dsp::IIR::Coefficients<float>(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+    shelfCoeffs_ = new juce::dsp::IIR::Coefficients<float>(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+    for (auto& f : sidechainLpf_) f.coefficients = lpfCoeffs_;
+    for (auto& f : sidechainShelf_) f.coefficients = shelfCoeffs_;
+}
+
+MeasuredCompressor::~MeasuredCompressor()
+{
+    delete tables_.load();
+    delete publishedTables_.load();
+    delete retiredTables_.load();
+    delete fadingTables_;
+}
+
+void MeasuredCompressor::publishTables(std::shared_ptr<const Tables> tables)
+{
+    // Whatever was published before is no longer reachable by the audio thread once exchanged out
+    delete publishedTables_.exchange(new TablesRef(std::move(tables)), std::memory_order_acq_rel);
+}
+
+bool MeasuredCompressor::releaseRetiredTables()
+{
+    const TablesRef* retired = retiredTables_.exchange(nullptr, std::memory_order_acq_rel);
+    delete retired;
+    return retired != nullptr;
+}
+
+bool MeasuredCompressor::isSwapPending() const noexcept
+{
+    // In swap order, so a set moving from one stage to the next is seen in at least one of them
+    return publishedTables_.load(std::memory_order_acquire) != nullptr
+        || fading_.load(std::memory_order_acquire)
+        || retiredTables_.load(std::memory_order_acquire) != nullptr;
+}
+
+void MeasuredCompressor::adoptPublishedTables() noexcept
+{
+    if (fadingTables_ != nullptr || retiredTables_.load(std::memory_order_acquire) != nullptr)
+        return;   // one swap at a time; a newer set waits in publishedTables_
+    // Only this thread empties publishedTables_, so a set seen here is still there for the exchange
+    if (publishedTables_.load(std::memory_order_acquire) == nullptr)
+        return;
+    fading_.store(true, std::memory_order_release);
+    const TablesRef* next = publishedTables_.exchange(nullptr, std::memory_order_acq_rel);
+    fadingTables_ = tables_.load(std::memory_order_relaxed);
+    tables_.store(next, std::memory_order_release);
+    tableFade_ = 0.0f;
+    envelopeCoeffs_.blockSize = 0;   // re-read attack / release times from the new timing table
+}
+
+void MeasuredCompressor::prepare(int maxBlockSize, int numChannels)
+{
+    sidechainBuffer_.setSize(juce::jmax(1, numChannels), juce::jmax(1, maxBlockSize), false, true, false);
+}
+
+void MeasuredCompressor::reset() noexcept
+{
+    envelopeGrDb_ = 0.0f;
+    lastGrDb_ = 0.0f;
+    for (auto& f : sidechainLpf_) f.reset();
+    for (auto& f : sidechainShelf_) f.reset();
 }
 
 void MeasuredCompressor::setSidechainOptoOptions(bool rolloff, bool limit, double sampleRate)
@@ -39,90 +101,47 @@ void MeasuredCompressor::setSidechainOptoOptions(bool rolloff, bool limit, doubl
     sidechainRolloff_ = rolloff;
     sidechainLimit_ = limit;
     sidechainSampleRate_ = sampleRate;
-    lpfCoeffs_.reset();
-    shelfCoeffs_.reset();
-    if (sampleRate > 0 && (rolloff || limit))
-    {
-        if (rolloff)
-            lpfCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, kSidechainLpfHz);
-        if (limit)
-            shelfCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate, kSidechainShelfHz, 0.7f, juce::Decibels::decibelsToGain(kSidechainShelfGainDb));
-    }
-    sidechainLpf_.clear();
-    sidechainShelf_.clear();
+    if (sampleRate > 0 && rolloff)
+        *lpfCoeffs_ = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(sampleRate, kSidechainLpfHz);
+    if (sampleRate > 0 && limit)
+        *shelfCoeffs_ = juce::dsp::IIR::ArrayCoefficients<float>::makeHighShelf(sampleRate, kSidechainShelfHz, 0.7f, juce::Decibels::decibelsToGain(kSidechainShelfGainDb));
+    for (auto& f : sidechainLpf_) f.reset();
+    for (auto& f : sidechainShelf_) f.reset();
 }
 
-void MeasuredCompressor::ensureSidechainFilters(int numChannels, double /*sampleRate*/)
+float MeasuredCompressor::applyFetCharacter(float grDb, float overDb, int character) noexcept
 {
-    if (!sidechainRolloff_ && !sidechainLimit_) return;
-    const auto n = static_cast<size_t>(std::min(numChannels, kMaxSidechainChannels));
-    if (lpfCoeffs_ && sidechainLpf_.size() != n)
-    {
-        sidechainLpf_.resize(n);
-        for (size_t i = 0; i < n; ++i)
-            sidechainLpf_[i].coefficients = lpfCoeffs_;
-    }
-    if (shelfCoeffs_ && sidechainShelf_.size() != n)
-    {
-        sidechainShelf_.resize(n);
-        for (size_t i = 0; i < n; ++i)
-            sidechainShelf_[i].coefficients = shelfCoeffs_;
-    }
+    if (character == 1) // Rev A: more GR in knee (input a few dB above threshold)
+        return (overDb > 0.0f && overDb < 12.0f) ? grDb * 1.15f : grDb;
+    if (character == 2) // LN: gentler
+        return grDb * 0.5f;
+    return grDb;        // Off, no scale
 }
 
-void MeasuredCompressor::buildCurveCache()
+float MeasuredCompressor::staticGainReductionDb(const Tables& tables, float threshold, float inputDb,
+                                                std::optional<float> ratio, std::optional<int> fetCharacter,
+                                                std::optional<float> attackMs, std::optional<float> releaseMs) const
 {
-    curveCache_.clear();
-    if (data_.compressionRows.empty()) return;
+    const float grDb = tables.curves.evaluate({ threshold, ratio.value_or(0.0f), attackMs.value_or(0.0f), releaseMs.value_or(0.0f) }, inputDb);
+    return fetCharacter.has_value() ? applyFetCharacter(grDb, inputDb - threshold, *fetCharacter) : grDb;
+}
 
-    std::map<CurveKey, std::map<float, std::vector<float>>> groups;
-    for (const auto& row : data_.compressionRows)
-    {
-        float t = row.threshold.value_or(0.0f);
-        float r = row.ratio.value_or(0.0f);
-        float a = row.attackMs.value_or(0.0f);
-        float rel = row.releaseMs.value_or(0.0f);
-        CurveKey key(t, r, a, rel);
-        groups[key][row.inputDb].push_back(row.gainReductionDb);
-    }
-    for (auto& [key, byInput] : groups)
-    {
-        std::vector<float> inputDb, grDb;
-        for (auto& [inDb, grs] : byInput)
-        {
-            inputDb.push_back(inDb);
-            float mean = 0;
-            for (float g : grs) mean += g;
-            mean /= (float)grs.size();
-            grDb.push_back(mean);
-        }
-        // Sort by input_db
-        std::vector<size_t> idx(inputDb.size());
-        for (size_t i = 0; i < idx.size(); ++i) idx[i] = i;
-        std::sort(idx.begin(), idx.end(), [&](size_t a, size_t b) { return inputDb[a] < inputDb[b]; });
-        std::vector<float> sortedIn, sortedGr;
-        for (size_t i : idx) { sortedIn.push_back(inputDb[i]); sortedGr.push_back(grDb[i]); }
-        curveCache_[key] = { sortedIn, sortedGr };
-    }
+float MeasuredCompressor::staticGainReductionDb(float threshold, float inputDb, std::optional<float> ratio,
+                                                std::optional<int> fetCharacter,
+                                                std::optional<float> attackMs, std::optional<float> releaseMs) const
+{
+    return staticGainReductionDb(currentTables(), threshold, inputDb, ratio, fetCharacter, attackMs, releaseMs);
 }
 
-std::vector<std::tuple<float, float, float, float>> MeasuredCompressor::nearestKeys(
-    float threshold, std::optional<float> ratio, std::optional<float> attackMs, std::optional<float> releaseMs) const
+void MeasuredCompressor::staticGainReductionDb(float threshold, const float* inputDb, float* grDb, int numPoints,
+                                               std::optional<float> ratio, std::optional<int> fetCharacter) const
 {
-    if (curveCache_.empty()) return {};
-    float q0 = threshold, q1 = ratio.value_or(0.0f), q2 = attackMs.value_or(0.0f), q3 = releaseMs.value_or(0.0f);
-    std::vector<CurveKey> keys;
-    keys.reserve(curveCache_.size());
-    for (auto it = curveCache_.begin(); it != curveCache_.end(); ++it)
-        keys.push_back(it->first);
-    std::sort(keys.begin(), keys.end(), [&](const CurveKey& a, const CurveKey& b) {
-        float da = (std::get<0>(a) - q0) * (std::get<0>(a) - q0) + (std::get<1>(a) - q1) * (std::get<1>(a) - q1)
-                 + (std::get<2>(a) - q2) * (std::get<2>(a) - q2) + (std::get<3>(a) - q3) * (std::get<3>(a) - q3);
-        float db = (std::get<0>(b) - q0) * (std::get<0>(b) - q0) + (std::get<1>(b) - q1) * (std::get<1>(b) - q1)
-                 + (std::get<2>(b) - q2) * (std::get<2>(b) - q2) + (std::get<3>(b) - q3) * (std::get<3>(b) - q3);
-        return da < db;
-    });
-    return keys;
+    CurveLattice::Slice slice;
+    currentTables().curves.getSlice({ threshold, ratio.value_or(0.0f), 0.0f, 0.0f }, slice);
+    slice.evaluate(inputDb, grDb, numPoints);
+    if (fetCharacter.has_value())
+        for (int i = 0; i < numPoints; ++i)
+            grDb[i] = applyFetCharacter(grDb[i], inputDb[i] - threshold, *fetCharacter);
 }
 
 float MeasuredCompressor::gainReductionDb(float threshold, float inputDb,
@@ -130,36 +149,42 @@ float MeasuredCompressor::gainReductionDb(float threshold, float inputDb,
                                           std::optional<float> attackMs,
                                           std::optional<float> releaseMs) const
 {
-    auto keys = nearestKeys(threshold, ratio, attackMs, releaseMs);
-    if (keys.empty()) return 0.0f;
-    auto it = curveCache_.find(keys[0]);
-    const auto& [x0, y0] = it->second;
-    float gr0 = interp1d(x0, y0, inputDb);
-    if (keys.size() == 1) return gr0;
-    auto it1 = curveCache_.find(keys[1]);
-    const auto& [x1, y1] = it1->second;
-    float gr1 = interp1d(x1, y1, inputDb);
-    float t0 = std::get<0>(keys[0]), t1 = std::get<0>(keys[1]);
-    if (std::abs(t1 - t0) < 1e-9f) return gr0;
-    float w = (threshold - t0) / (t1 - t0);
-    w = juce::jlimit(0.0f, 1.0f, w);
-    return (1.0f - w) * gr0 + w * gr1;
+    return currentTables().curves.evaluate({ threshold, ratio.value_or(0.0f), attackMs.value_or(0.0f), releaseMs.value_or(0.0f) }, inputDb);
+}
+
+size_t MeasuredCompressor::getMemoryBytes() const noexcept
+{
+    const auto sidechainBytes = static_cast<size_t>(sidechainBuffer_.getNumChannels())
+                              * static_cast<size_t>(sidechainBuffer_.getNumSamples()) * sizeof(float);
+    return sizeof(*this) + sizeof(Tables) + currentTables().getMemoryBytes() + sidechainBytes;
 }
 
 std::pair<std::optional<float>, std::optional<float>> MeasuredCompressor::getAttackReleaseMs(float attackParam, float releaseParam) const
 {
-    if (data_.timingRows.empty()) return { {}, {} };
-    const TimingRow* best = nullptr;
-    float bestDist = 1e30f;
-    for (const auto& row : data_.timingRows)
-    {
-        if (!row.attackParam.has_value() || !row.releaseParam.has_value()) continue;
-        float d = (*row.attackParam - attackParam) * (*row.attackParam - attackParam)
-                + (*row.releaseParam - releaseParam) * (*row.releaseParam - releaseParam);
-        if (d < bestDist) { bestDist = d; best = &row; }
-    }
-    if (!best) return { {}, {} };
-    return { best->attackTimeMs, best->releaseTimeMs };
+    const TimingTable& timing = currentTables().timing;
+    if (timing.isEmpty()) return { {}, {} };
+    const auto [attackMs, releaseMs] = timing.lookup(attackParam, releaseParam);
+    return { attackMs, releaseMs };
+}
+
+void MeasuredCompressor::updateEnvelopeCoeffs(float attackParam, float releaseParam, double sampleRate, int blockSize)
+{
+    auto& e = envelopeCoeffs_;
+    if (e.attackParam == attackParam && e.releaseParam == releaseParam && e.sampleRate == sampleRate && e.blockSize == blockSize)
+        return;
+    e.attackParam = attackParam;
+    e.releaseParam = releaseParam;
+    e.sampleRate = sampleRate;
+    e.blockSize = blockSize;
+
+    // No usable timing data (e.g. every row measurement_ok False): attack knob is in microseconds, release in ms
+    auto [atMs, reMs] = getAttackReleaseMs(attackParam, releaseParam);
+    e.attackMs = atMs.has_value() ? std::max(0.1f, *atMs) : (attackParam / 1000.0f);
+    e.releaseMs = reMs.has_value() ? std::max(0.1f, *reMs) : releaseParam;
+    const float tauAttackSamp = (e.attackMs / 1000.0f) * (float)sampleRate;
+    const float tauReleaseSamp = (e.releaseMs / 1000.0f) * (float)sampleRate;
+    e.attack = 1.0f - std::exp(-(float)blockSize / tauAttackSamp);
+    e.release = 1.0f - std::exp(-(float)blockSize / tauReleaseSamp);
 }
 
 void MeasuredCompressor::process(juce::AudioBuffer<float>& buffer, double sampleRate,
@@ -173,31 +198,28 @@ void MeasuredCompressor::process(juce::AudioBuffer<float>& buffer, double sample
     const int numSamples = buffer.getNumSamples();
     if (numChannels == 0 || numSamples == 0) return;
 
+    adoptPublishedTables();
+    const Tables& tables = **tables_.load(std::memory_order_relaxed);
+    CurveMorph::Blend morph;
+    const bool useMorph = curveMorph_ != nullptr && curveMorph_->acquire(morph);
+    const float tableFadeStep = 1.0f / juce::jmax(1.0f, kTableCrossfadeMs * 0.001f * static_cast<float>(sampleRate));
+
     const bool useOptoEnvelope = !attackParam.has_value() && !releaseParam.has_value();
 
     bool useEnvelope = false;
-    float attackTimeMs = 10.0f, releaseTimeMs = 100.0f;
+    std::optional<float> curveAttackMs, curveReleaseMs;   // measured-curve attack_ms / release_ms axes (FET)
+    float coeffAttack = 1.0f, coeffRelease = 1.0f;
     if (attackParam.has_value() && releaseParam.has_value())
     {
-        auto [atMs, reMs] = getAttackReleaseMs(*attackParam, *releaseParam);
-        attackTimeMs = atMs.has_value() ? std::max(0.1f, *atMs) : (*attackParam / 1000.0f);
-        releaseTimeMs = reMs.has_value() ? std::max(0.1f, *reMs) : *releaseParam;
+        updateEnvelopeCoeffs(*attackParam, *releaseParam, sampleRate, blockSize);
+        curveAttackMs = envelopeCoeffs_.attackMs;
+        curveReleaseMs = envelopeCoeffs_.releaseMs;
+        coeffAttack = envelopeCoeffs_.attack;
+        coeffRelease = envelopeCoeffs_.release;
         useEnvelope = true;
     }
     else if (useOptoEnvelope)
-    {
-        attackTimeMs = kOptoAttackMs;
         useEnvelope = true;
-    }
-
-    float coeffAttack = 1.0f, coeffRelease = 1.0f;
-    if (useEnvelope && !useOptoEnvelope)
-    {
-        float tauAttackSamp = (attackTimeMs / 1000.0f) * (float)sampleRate;
-        float tauReleaseSamp = (releaseTimeMs / 1000.0f) * (float)sampleRate;
-        coeffAttack = 1.0f - std::exp(-(float)blockSize / tauAttackSamp);
-        coeffRelease = 1.0f - std::exp(-(float)blockSize / tauReleaseSamp);
-    }
 
     const bool useExternalDetector = externalDetectorBuffer != nullptr
         && externalDetectorBuffer->getNumSamples() > 0
@@ -206,18 +228,17 @@ void MeasuredCompressor::process(juce::AudioBuffer<float>& buffer, double sample
     const bool useSidechainFilter = !useExternalDetector && (sidechainRolloff_ || sidechainLimit_);
     if (useSidechainFilter)
     {
-        ensureSidechainFilters(numChannels, sampleRate);
         sidechainBuffer_.makeCopyOf(buffer, true);
         const int nCh = std::min(numChannels, kMaxSidechainChannels);
         for (int ch = 0; ch < nCh; ++ch)
         {
             const auto chU = static_cast<size_t>(ch);
-            if (sidechainRolloff_ && chU < sidechainLpf_.size())
+            if (sidechainRolloff_)
             {
                 for (int i = 0; i < numSamples; ++i)
                     sidechainBuffer_.setSample(ch, i, sidechainLpf_[chU].processSample(sidechainBuffer_.getSample(ch, i)));
             }
-            if (sidechainLimit_ && chU < sidechainShelf_.size())
+            if (sidechainLimit_)
             {
                 for (int i = 0; i < numSamples; ++i)
                     sidechainBuffer_.setSample(ch, i, sidechainShelf_[chU].processSample(sidechainBuffer_.getSample(ch, i)));
@@ -245,19 +266,32 @@ void MeasuredCompressor::process(juce::AudioBuffer<float>& buffer, double sample
                 sumSq += levelBuffer->getSample(ch, i) * levelBuffer->getSample(ch, i);
         float rms = std::sqrt(sumSq / static_cast<float>(levelChannels * juce::jmax(1, levelLen)));
         float inputDb = rms <= 1e-10f ? -100.0f : 20.0f * std::log10(rms);
-        float targetGrDb = gainReductionDb(threshold, inputDb, ratio, {}, {});
-        if (fetCharacter.has_value())
+        float targetGrDb = 0.0f;
+        if (useMorph)   // Character blend: one lookup in the pre-blended table
         {
-            const int c = *fetCharacter;
-            if (c == 1) // Rev A: more GR in knee (input a few dB above threshold)
+            targetGrDb = morph.gainReductionDb(threshold, ratio.value_or(0.0f), inputDb);
+            if (fetCharacter.has_value())
+                targetGrDb = applyFetCharacter(targetGrDb, inputDb - threshold, *fetCharacter);
+        }
+        else
+            targetGrDb = staticGainReductionDb(tables, threshold, inputDb, ratio, fetCharacter, curveAttackMs, curveReleaseMs);
+        if (fadingTables_ != nullptr)
+        {
+            // Table swap: blend from the outgoing curves, then park them for releaseRetiredTables(). Under a Character
+            // blend the target never came from the tables (the morph is re-sourced with the swap and carries the
+            // change), so fading from the plain outgoing curve would jump; just run the fade out to retire them.
+            if (!useMorph)
+            {
+                const float oldGrDb = staticGainReductionDb(**fadingTables_, threshold, inputDb, ratio, fetCharacter, curveAttackMs, curveReleaseMs);
+                targetGrDb = oldGrDb + (targetGrDb - oldGrDb) * tableFade_;
+            }
+            tableFade_ += tableFadeStep * static_cast<float>(len);
+            if (tableFade_ >= 1.0f)
             {
-                float overDb = inputDb - threshold;
-                if (overDb > 0.0f && overDb < 12.0f)
-                    targetGrDb *= 1.15f;
+                retiredTables_.store(fadingTables_, std::memory_order_release);
+                fadingTables_ = nullptr;
+                fading_.store(false, std::memory_order_release);
             }
-            else if (c == 2) // LN: gentler
-                targetGrDb *= 0.5f;
-            // c == 0: Off, no scale
         }
 
         float grDb;
@@ -1,27 +1,100 @@
 #pragma once
 
 #include "DataLoader.h"
+#include "CurveLattice.h"
+#include "TimingTable.h"
 #include <JuceHeader.h>
-#include <map>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <optional>
 
 namespace emulation {
 
-/** Compressor from analyzer data: interpolate gain_reduction_db from compression CSV; optional one-pole envelope from timing CSV.
- *  Opto mode: fixed program-dependent envelope (attack ~10 ms, dual release); optional sidechain LPF (rolloff) and HF shelf (Limit). */
+class CurveMorph;
+
+/** Compressor from analyzer data: interpolate gain_reduction_db from compression CSV (multilinear over the measured
+ *  threshold / ratio / attack / release lattice, monotone cubic over input level); optional one-pole envelope from timing CSV.
+ *  Opto mode: fixed program-dependent envelope (attack ~10 ms, dual release); optional sidechain LPF (rolloff) and HF shelf (Limit).
+ *
+ *  The lattice and timing table form an immutable, shareable Tables set (one per curve profile, see CurveStore) that can
+ *  be replaced while audio runs (hot reload, profile switch): publishTables() hands over a new set with one atomic exchange, process() adopts it at the start of a block and
+ *  crossfades the gain-reduction target from the old set over kTableCrossfadeMs (not while a Character blend supplies the
+ *  target; the re-sourced morph carries the change), then parks the old set for releaseRetiredTables(). The audio
+ *  thread never allocates, frees or waits for a swap. */
 class MeasuredCompressor
 {
 public:
+    /** Curve lattice and timing table built from one data set. Immutable once built, so instances can share one. */
+    struct Tables
+    {
+        explicit Tables(const AnalyzerOutput& data);
+
+        /** Heap bytes held by the lattice and timing grid. */
+        size_t getMemoryBytes() const noexcept { return curves.getMemoryBytes() + timing.getMemoryBytes(); }
+
+        CurveLattice curves;
+        TimingTable timing;
+    };
+
+    static constexpr float kTableCrossfadeMs = 50.0f;
+
+    /** Builds the curve lattice and timing table from the data set; nothing refers back to it afterwards. */
     explicit MeasuredCompressor(const AnalyzerOutput& data);
+    /** Uses an already built (possibly shared) set of tables. */
+    explicit MeasuredCompressor(std::shared_ptr<const Tables> tables);
+    ~MeasuredCompressor();
+
+    /** Replace the curve tables (e.g. after the capture files changed). Any thread but the audio thread; wait-free.
+     *  The next process() call fades over to them. A set published before the previous one was adopted replaces it. */
+    void publishTables(std::shared_ptr<const Tables> tables);
+
+    /** Drop this compressor's reference to a set process() has finished fading out, if any. Not the audio thread, and only while nothing else can be
+     *  inside gainReductionDb / staticGainReductionDb (hold the lock those callers hold). True if a set was released,
+     *  i.e. a swap has completed since the last call. */
+    bool releaseRetiredTables();
+
+    /** True from publishTables() until the swap has finished and its outgoing set was released, i.e. while whoever
+     *  reclaims tables (releaseRetiredTables) still has work to come. Any thread. */
+    bool isSwapPending() const noexcept;
+
+    /** Allocate scratch buffers for the largest block process() will see. Call before processing (not on the audio thread). */
+    void prepare(int maxBlockSize, int numChannels = kMaxSidechainChannels);
+
+    /** Clear the envelope and sidechain filter history (e.g. between offline renders); the tables stay. Not while
+     *  process() runs. */
+    void reset() noexcept;
 
-    /** Interpolate gain reduction (dB) from measured curve. Opto: pass only threshold (e.g. 25,50,75). FET: threshold + ratio (+ optional attack_ms, release_ms). */
+    /** Interpolate gain reduction (dB) from measured curve. Opto: pass only threshold (e.g. 25,50,75). FET: threshold + ratio (+ optional attack_ms, release_ms).
+     *  Unset values read as 0 (clamped to the axis), which only matters on axes the data actually varies. */
     float gainReductionDb(float threshold, float inputDb,
                          std::optional<float> ratio = {},
                          std::optional<float> attackMs = {},
                          std::optional<float> releaseMs = {}) const;
 
-    /** Interpolate (attack_time_ms, release_time_ms) from timing table. Returns (nullopt, nullopt) if no data. */
+    /** Steady-state gain reduction exactly as process() targets it: gainReductionDb (threshold/ratio curve) plus the
+     *  FET character scaling. Used for the GUI transfer curve; const and allocation-free, so safe off the audio thread. */
+    float staticGainReductionDb(float threshold, float inputDb, std::optional<float> ratio,
+                                std::optional<int> fetCharacter = std::nullopt,
+                                std::optional<float> attackMs = {}, std::optional<float> releaseMs = {}) const;
+
+    /** staticGainReductionDb over many input levels at one setting (e.g. the GUI transfer curve): the curve is blended
+     *  once and evaluated in a single vectorisable pass. Allocates a small scratch curve, so not for the audio thread. */
+    void staticGainReductionDb(float threshold, const float* inputDb, float* grDb, int numPoints,
+                               std::optional<float> ratio, std::optional<int> fetCharacter = std::nullopt) const;
+
+    /** FET character scaling of a curve's gain reduction (overDb = input - threshold). 0 = Off, 1 = Rev A (more GR
+     *  in the knee), 2 = LN (gentler). */
+    static float applyFetCharacter(float grDb, float overDb, int character) noexcept;
+
+    /** Read the static curve from a Character blend (CurveMorph) while its amount is above 0; nullptr = own curves
+     *  only. The morph must outlive processing. Set before processing starts (not on the audio thread). */
+    void setCurveMorph(CurveMorph* morph) noexcept { curveMorph_ = morph; }
+    bool hasCurveMorph() const noexcept { return curveMorph_ != nullptr; }
+
+    /** Bilinearly interpolated (attack_time_ms, release_time_ms) from the timing table. Returns (nullopt, nullopt) if there
+     *  is no usable timing data (rows with measurement_ok False are ignored). */
     std::pair<std::optional<float>, std::optional<float>> getAttackReleaseMs(float attackParam, float releaseParam) const;
 
     /** Opto sidechain: rolloff = LPF so bass drives compression more; limit = HF shelf so Limit mode has more HF sensitivity. Call when in Opto mode (and on sample rate change). */
@@ -40,15 +113,39 @@ public:
     /** Last gain reduction (dB) applied in process() — for metering. */
     float getLastGainReductionDb() const { return lastGrDb_; }
 
+    /** Bytes this instance keeps resident: the object, curve lattice, timing table and sidechain scratch. */
+    size_t getMemoryBytes() const noexcept;
+
 private:
-    void buildCurveCache();
-    void ensureSidechainFilters(int numChannels, double sampleRate);
-    std::vector<std::tuple<float, float, float, float>> nearestKeys(float threshold, std::optional<float> ratio,
-                                                                     std::optional<float> attackMs, std::optional<float> releaseMs) const;
-
-    AnalyzerOutput data_;
-    using CurveKey = std::tuple<float, float, float, float>;
-    std::map<CurveKey, std::pair<std::vector<float>, std::vector<float>>> curveCache_;
+    using TablesRef = std::shared_ptr<const Tables>;
+
+    const Tables& currentTables() const noexcept { return **tables_.load(std::memory_order_acquire); }
+    float staticGainReductionDb(const Tables& tables, float threshold, float inputDb, std::optional<float> ratio,
+                                std::optional<int> fetCharacter, std::optional<float> attackMs, std::optional<float> releaseMs) const;
+    /** Audio thread: take a published set unless a crossfade is running or the last outgoing set is still parked. */
+    void adoptPublishedTables() noexcept;
+    /** FET envelope times and coefficients; recomputed only when the knobs, sample rate or block size change. */
+    void updateEnvelopeCoeffs(float attackParam, float releaseParam, double sampleRate, int blockSize);
+
+    struct EnvelopeCoeffs
+    {
+        float attackParam = -1.0f, releaseParam = -1.0f;
+        double sampleRate = 0.0;
+        int blockSize = 0;
+        float attackMs = 10.0f, releaseMs = 100.0f;
+        float attack = 1.0f, release = 1.0f;   // one-pole coefficients per blockSize step
+    };
+
+    // Owned heap references, so they can be exchanged atomically and the audio thread never touches a reference count.
+    // tables_ is written only by the audio thread; references are only deleted off it.
+    std::atomic<const TablesRef*> tables_{ nullptr };
+    std::atomic<const TablesRef*> publishedTables_{ nullptr };   // published, not yet adopted
+    std::atomic<const TablesRef*> retiredTables_{ nullptr };     // faded out, waiting for releaseRetiredTables()
+    const TablesRef* fadingTables_ = nullptr;                    // audio thread: outgoing set during a crossfade
+    std::atomic<bool> fading_{ false };                          // fadingTables_ != nullptr, for isSwapPending()
+    float tableFade_ = 1.0f;                                  // audio thread: 0 -> 1 across the crossfade
+    CurveMorph* curveMorph_ = nullptr;
+    EnvelopeCoeffs envelopeCoeffs_;
     float envelopeGrDb_ = 0.0f;
     float lastGrDb_ = 0.0f;
 
@@ -56,11 +153,14 @@ private:
     bool sidechainLimit_ = false;
     double sidechainSampleRate_ = 48000.0;
     static constexpr int kMaxSidechainChannels = 2;
-    std::vector<juce::dsp::IIR::Filter<float>> sidechainLpf_;
-    std::vector<juce::dsp::IIR::Filter<float>> sidechainShelf_;
+    // Coefficient objects are allocated once in the constructor and updated in place, so option changes never allocate.
+    std::array<juce::dsp::IIR::Filter<float>, kMaxSidechainChannels> sidechainLpf_;
+    std::array<juce::dsp::IIR::Filter<float>, kMaxSidechainChannels> sidechainShelf_;
     juce::dsp::IIR::Coefficients<float>::Ptr lpfCoeffs_;
     juce::dsp::IIR::Coefficients<float>::Ptr shelfCoeffs_;
     juce::AudioBuffer<float> sidechainBuffer_;
+
+    JUCE_DECLARE_NON_COPYABLE(MeasuredCompressor)
 };
 
 } // namespace emulation
@@ -0,0 +1,164 @@
+#include "MeterBus.h"
+#include <algorithm>
+#include <cmath>
+
+namespace emulation {
+
+namespace {
+
+void fetchMax(std::atomic<float>& target, float value) noexcept
+{
+    float current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+// History fields are dB in 1/256 dB steps (±128 dB) as 16-bit two's complement.
+constexpr float kHistoryScale = 256.0f;
+
+std::uint64_t packDb(float db) noexcept
+{
+    const int q = juce::jlimit(-32768, 32767, juce::roundToInt(db * kHistoryScale));
+    return static_cast<std::uint16_t>(static_cast<std::int16_t>(q));
+}
+
+float unpackDb(std::uint64_t bits) noexcept
+{
+    return static_cast<float>(static_cast<std::int16_t>(static_cast<std::uint16_t>(bits & 0xffffu))) / kHistoryScale;
+}
+
+} // namespace
+
+MeterBus::Frame MeterBus::silentFrame()
+{
+    Frame f;
+    f.fill(-60.0f);
+    f[GainReduction] = 0.0f;
+    return f;
+}
+
+MeterBus::MeterBus()
+{
+    const Frame silent = silentFrame();
+    for (int v = 0; v < NumValues; ++v)
+        latest_[static_cast<size_t>(v)].store(silent[static_cast<size_t>(v)]);
+    for (auto& slot : slots_)
+        for (auto& value : slot.values)
+            value.store(kEmpty);
+}
+
+void MeterBus::push(const Frame& frame, int numSamples) noexcept
+{
+    for (int v = 0; v < NumValues; ++v)
+        latest_[static_cast<size_t>(v)].store(frame[static_cast<size_t>(v)], std::memory_order_relaxed);
+    for (auto& slot : slots_)
+    {
+        if (!slot.claimed.load(std::memory_order_relaxed))
+            continue;
+        for (int v = 0; v < NumValues; ++v)
+            fetchMax(slot.values[static_cast<size_t>(v)], frame[static_cast<size_t>(v)]);
+    }
+
+    const std::uint64_t n = historyWritten_.load(std::memory_order_relaxed);
+    history_[static_cast<size_t>(n % kHistorySize)].store(pack(frame, numSamples), std::memory_order_relaxed);
+    historyWritten_.store(n + 1, std::memory_order_release);
+}
+
+MeterBus::Frame MeterBus::getLatest() const noexcept
+{
+    Frame f;
+    for (int v = 0; v < NumValues; ++v)
+        f[static_cast<size_t>(v)] = latest_[static_cast<size_t>(v)].load(std::memory_order_relaxed);
+    return f;
+}
+
+int MeterBus::claimSlot() noexcept
+{
+    for (int i = 0; i < kMaxReaders; ++i)
+    {
+        auto& slot = slots_[static_cast<size_t>(i)];
+        bool expected = false;
+        if (slot.claimed.compare_exchange_strong(expected, true))
+        {
+            for (auto& value : slot.values)
+                value.store(kEmpty, std::memory_order_relaxed);
+            return i;
+        }
+    }
+    return -1;
+}
+
+void MeterBus::releaseSlot(int slot) noexcept
+{
+    if (slot >= 0 && slot < kMaxReaders)
+        slots_[static_cast<size_t>(slot)].claimed.store(false);
+}
+
+MeterBus::Reader::Reader(MeterBus& bus) : bus_(bus), slot_(bus.claimSlot())
+{
+    jassert(slot_ >= 0);   // more GUI consumers than kMaxReaders: this one sees snapshots only
+}
+
+MeterBus::Reader::~Reader()
+{
+    bus_.releaseSlot(slot_);
+}
+
+MeterBus::Frame MeterBus::Reader::read() noexcept
+{
+    if (slot_ < 0)
+        return last_ = bus_.getLatest();
+    auto& values = bus_.slots_[static_cast<size_t>(slot_)].values;
+    for (int v = 0; v < NumValues; ++v)
+    {
+        const float taken = values[static_cast<size_t>(v)].exchange(kEmpty, std::memory_order_relaxed);
+        if (taken > kEmpty)
+            last_[static_cast<size_t>(v)] = taken;
+    }
+    return last_;
+}
+
+int MeterBus::readHistory(std::uint64_t& position, HistoryEntry* dest, int maxEntries) const noexcept
+{
+    const std::uint64_t written = historyWritten_.load(std::memory_order_acquire);
+    const std::uint64_t oldest = written > kHistorySize ? written - kHistorySize : 0;
+    std::uint64_t start = juce::jlimit(oldest, written, position);
+    int count = static_cast<int>(juce::jmin<std::uint64_t>(written - start, static_cast<std::uint64_t>(juce::jmax(0, maxEntries))));
+    for (int i = 0; i < count; ++i)
+        dest[i] = unpack(history_[static_cast<size_t>((start + static_cast<std::uint64_t>(i)) % kHistorySize)]
+                             .load(std::memory_order_relaxed));
+
+    // The writer may have lapped the oldest entries while we copied (the next write reuses one more slot): drop them.
+    const std::uint64_t after = historyWritten_.load(std::memory_order_acquire);
+    const std::uint64_t firstIntact = after + 1 > kHistorySize ? after + 1 - kHistorySize : 0;
+    if (start < firstIntact)
+    {
+        const int drop = static_cast<int>(juce::jmin<std::uint64_t>(firstIntact - start, static_cast<std::uint64_t>(count)));
+        std::copy(dest + drop, dest + count, dest);
+        count -= drop;
+        start += static_cast<std::uint64_t>(drop);
+    }
+    position = start + static_cast<std::uint64_t>(count);
+    return count;
+}
+
+std::uint64_t MeterBus::pack(const Frame& frame, int numSamples) noexcept
+{
+    return packDb(frame[GainReduction])
+         | (packDb(frame[InputPeak]) << 16)
+         | (packDb(frame[OutputPeak]) << 32)
+         | (static_cast<std::uint64_t>(juce::jlimit(0, 0xffff, numSamples)) << 48);
+}
+
+MeterBus::HistoryEntry MeterBus::unpack(std::uint64_t packed) noexcept
+{
+    HistoryEntry e;
+    e.grDb = unpackDb(packed);
+    e.inputPeakDb = unpackDb(packed >> 16);
+    e.outputPeakDb = unpackDb(packed >> 32);
+    e.numSamples = static_cast<int>((packed >> 48) & 0xffffu);
+    return e;
+}
+
+} // namespace emulation
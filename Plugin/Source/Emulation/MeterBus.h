@@ -0,0 +1,94 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace emulation {
+
+/** Audio-thread to GUI meter hand-off that loses nothing between GUI frames.
+ *
+ *  Levels: every GUI consumer owns a Reader slot. The audio thread max-accumulates each block's values into every
+ *  claimed slot; Reader::read() takes them with an atomic exchange, so a consumer polling at 45 Hz still sees the
+ *  loudest block (and the largest GR spike) since its previous read, whatever the host block size.
+ *
+ *  History: a fixed ring of per-block (GR, input peak, output peak, block length) entries, each packed into one
+ *  64-bit atomic so readers never see a torn entry. Readers keep their own position; a reader that falls more than
+ *  kHistorySize blocks behind skips to the oldest entry still intact.
+ *
+ *  Everything is lock- and allocation-free on the audio thread. All values are dB; GR is positive dB of reduction. */
+class MeterBus
+{
+public:
+    enum Value { InputPeak, InputPeakL, InputPeakR, OutputPeak, OutputPeakL, OutputPeakR, GainReduction, NumValues };
+    using Frame = std::array<float, NumValues>;
+
+    static constexpr int kMaxReaders = 16;
+    static constexpr int kHistorySize = 4096;   // blocks; power of two (~5.5 s of 64-sample blocks at 48 kHz)
+
+    static Frame silentFrame();
+
+    MeterBus();
+
+    /** Audio thread, once per processed block. */
+    void push(const Frame& frame, int numSamples) noexcept;
+
+    /** Latest block's values (plain snapshot, may miss peaks; for consumers that only want the current state). */
+    Frame getLatest() const noexcept;
+
+    /** One GUI consumer. Claims a slot on construction and releases it on destruction; if all slots are taken,
+     *  read() falls back to getLatest(). Construct and read on the message thread. */
+    class Reader
+    {
+    public:
+        explicit Reader(MeterBus& bus);
+        ~Reader();
+
+        /** Per-value maximum since the previous read; values with no block since then repeat the last read. */
+        Frame read() noexcept;
+
+    private:
+        MeterBus& bus_;
+        int slot_ = -1;
+        Frame last_ = silentFrame();
+        JUCE_DECLARE_NON_COPYABLE(Reader)
+    };
+
+    struct HistoryEntry
+    {
+        float grDb = 0.0f;
+        float inputPeakDb = -60.0f;
+        float outputPeakDb = -60.0f;
+        int numSamples = 0;
+    };
+
+    /** Copies entries written since position (a running block count; start from getHistoryPosition()) into dest,
+     *  oldest first, and advances position. Returns the number copied (<= maxEntries). Any thread. */
+    int readHistory(std::uint64_t& position, HistoryEntry* dest, int maxEntries) const noexcept;
+    std::uint64_t getHistoryPosition() const noexcept { return historyWritten_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr float kEmpty = -1.0e9f;   // slot value meaning "no block since the last read"
+
+    struct alignas(64) Slot
+    {
+        std::atomic<bool> claimed{ false };
+        std::array<std::atomic<float>, NumValues> values;
+    };
+    std::array<Slot, kMaxReaders> slots_;
+    std::array<std::atomic<float>, NumValues> latest_;
+
+    std::array<std::atomic<std::uint64_t>, kHistorySize> history_{};
+    std::atomic<std::uint64_t> historyWritten_{ 0 };
+
+    int claimSlot() noexcept;
+    void releaseSlot(int slot) noexcept;
+
+    static std::uint64_t pack(const Frame& frame, int numSamples) noexcept;
+    static HistoryEntry unpack(std::uint64_t packed) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(MeterBus)
+};
+
+} // namespace emulation
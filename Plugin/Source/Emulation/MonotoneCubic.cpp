@@ -0,0 +1,72 @@
+#include "MonotoneCubic.h"
+#include <algorithm>
+#include <cmath>
+
+namespace emulation {
+
+void MonotoneCubic::fit(const float* x, const float* y, size_t n)
+{
+    x_.assign(x, x + n);
+    y_.assign(y, y + n);
+    slope_.assign(n, 0.0f);
+    if (n < 2)
+        return;
+
+    std::vector<float> h(n - 1), delta(n - 1);
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+        h[i] = x[i + 1] - x[i];
+        delta[i] = (y[i + 1] - y[i]) / h[i];
+    }
+    if (n == 2)
+    {
+        slope_[0] = slope_[1] = delta[0];
+        return;
+    }
+
+    // Interior: weighted harmonic mean of the neighbouring secants, 0 at local extrema (Fritsch-Carlson)
+    for (size_t i = 1; i + 1 < n; ++i)
+    {
+        if (delta[i - 1] * delta[i] <= 0.0f)
+            continue;
+        const float w1 = 2.0f * h[i] + h[i - 1], w2 = h[i] + 2.0f * h[i - 1];
+        slope_[i] = (w1 + w2) / (w1 / delta[i - 1] + w2 / delta[i]);
+    }
+
+    // Ends: one-sided three-point estimate, limited so the end interval cannot overshoot
+    auto endSlope = [](float h0, float h1, float d0, float d1) {
+        float m = ((2.0f * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if (m * d0 <= 0.0f)
+            m = 0.0f;
+        else if (d0 * d1 <= 0.0f && std::abs(m) > std::abs(3.0f * d0))
+            m = 3.0f * d0;
+        return m;
+    };
+    slope_[0] = endSlope(h[0], h[1], delta[0], delta[1]);
+    slope_[n - 1] = endSlope(h[n - 2], h[n - 3], delta[n - 2], delta[n - 3]);
+}
+
+float MonotoneCubic::operator()(float xq) const noexcept
+{
+    if (x_.empty()) return 0.0f;
+    if (!(xq > x_.front())) return y_.front();   // also catches NaN
+    if (xq >= x_.back()) return y_.back();
+    const auto hi = static_cast<size_t>(std::upper_bound(x_.begin(), x_.end(), xq) - x_.begin());
+    const size_t lo = hi - 1;
+    float c[4];
+    getSegment(lo, c);
+    const float t = (xq - x_[lo]) / (x_[hi] - x_[lo]);
+    return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+}
+
+void MonotoneCubic::getSegment(size_t i, float* c) const noexcept
+{
+    const float h = x_[i + 1] - x_[i];
+    const float y0 = y_[i], y1 = y_[i + 1], m0 = h * slope_[i], m1 = h * slope_[i + 1];
+    c[0] = y0;
+    c[1] = m0;
+    c[2] = 3.0f * (y1 - y0) - 2.0f * m0 - m1;
+    c[3] = 2.0f * (y0 - y1) + m0 + m1;
+}
+
+} // namespace emulation
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace emulation {
+
+/** Monotone piecewise cubic Hermite interpolation (PCHIP, Fritsch-Carlson slopes) through measured points.
+ *  Smooth (C1) where linear interpolation has corners, yet never overshoots: between two samples the curve stays
+ *  within their values, so a monotone gain-reduction curve or magnitude response stays monotone. Queries outside
+ *  the samples clamp to the end values, like the measured curves. Fit once (allocates); evaluation is const and
+ *  allocation-free. */
+class MonotoneCubic
+{
+public:
+    /** Fit through (x[i], y[i]); x must be strictly ascending. Fewer than two points: constant (or 0 if none). */
+    void fit(const float* x, const float* y, size_t n);
+    void fit(const std::vector<float>& x, const std::vector<float>& y) { fit(x.data(), y.data(), x.size() < y.size() ? x.size() : y.size()); }
+
+    float operator()(float xq) const noexcept;
+
+    /** Segment i (between samples i and i + 1) in power form over t in [0, 1]: c[0] + c[1] t + c[2] t^2 + c[3] t^3. */
+    void getSegment(size_t i, float* c) const noexcept;
+
+private:
+    std::vector<float> x_, y_, slope_;
+};
+
+} // namespace emulation
@@ -26,6 +26,21 @@ NeonTapeSaturation::NeonTapeSaturation(double sampleRate) : sampleRate_(sampleRa
     toneFilterAlpha_ = onePoleCoeffFromHz(toneFilterCutoffHz_, (float)sampleRate_);
 }
 
+void NeonTapeSaturation::reset() noexcept
+{
+    lpState_ = 0.0f;
+    hpState_ = 0.0f;
+    hpXPrev_ = 0.0f;
+    smoothState_ = 1.0f;
+    toneFilterState_[0] = toneFilterState_[1] = 0.0f;
+    runningMean_ = 0.0f;
+    runningVar_ = 1.0f;
+    for (auto& s : pinkState_) s = 0.0f;
+    burstPhaseSamples_ = 0.0f;
+    burstEnvelope_ = 0.0f;
+    nextEventSamples_ = 0.0f;
+}
+
 void NeonTapeSaturation::setDepth(float depth)
 {
     depth_ = juce::jlimit(0.0f, 1.0f, depth);
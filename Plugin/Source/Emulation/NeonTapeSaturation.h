@@ -25,6 +25,8 @@ public:
     void setToneFilterCutoffHz(float hz);
 
     void process(juce::AudioBuffer<float>& buffer);
+    /** Clear the filter, modulation and burst state to its initial values (settings stay). */
+    void reset() noexcept;
 
 private:
     float nextNoise();
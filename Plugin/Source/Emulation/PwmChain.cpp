@@ -31,10 +31,17 @@ PwmChain::PwmChain(double sampleRate,
     }
 }
 
-void PwmChain::prepare(double sampleRate)
+void PwmChain::prepare(double sampleRate, int maxBlockSize)
 {
     sampleRate_ = sampleRate;
-    pwm_->prepare(sampleRate);
+    pwm_->prepare(sampleRate, maxBlockSize);
+}
+
+void PwmChain::reset() noexcept
+{
+    pwm_->reset();
+    if (neon_)
+        neon_->reset();
 }
 
 void PwmChain::process(juce::AudioBuffer<float>& buffer,
@@ -44,10 +51,18 @@ void PwmChain::process(juce::AudioBuffer<float>& buffer,
                        float releaseMs,
                        const juce::AudioBuffer<float>* externalDetectorBuffer)
 {
+    OMBIC_STAGE_TICKS(ticks);
     if (neon_ && neonEnabled_ && neonBeforeCompressor_)
+    {
+        OMBIC_STAGE_SCOPE(ticks, Neon);
         neon_->process(buffer);
+    }
 
-    pwm_->process(buffer, thresholdPercent, ratio, attackMs, releaseMs, externalDetectorBuffer);
+    {
+        OMBIC_STAGE_SCOPE(ticks, Compressor);
+        pwm_->process(buffer, thresholdPercent, ratio, attackMs, releaseMs, externalDetectorBuffer);
+    }
+    OMBIC_STAGE_COMMIT(stageProfiler_, ticks, buffer.getNumSamples());
 }
 
 void PwmChain::setNeonParams(float depth, float modulationBandwidthHz, float toneFilterCutoffHz,
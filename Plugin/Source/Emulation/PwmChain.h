@@ -2,6 +2,7 @@
 
 #include "PwmCompressor.h"
 #include "NeonTapeSaturation.h"
+#include "StageProfiler.h"
 #include <JuceHeader.h>
 #include <memory>
 
@@ -21,7 +22,9 @@ public:
                       float neonDryWet = 1.0f,
                       bool neonSaturationAfter = false);
 
-    void prepare(double sampleRate);
+    void prepare(double sampleRate, int maxBlockSize = 4096);
+    /** Clear the compressor and Neon state; settings stay. */
+    void reset() noexcept;
 
     /** thresholdPercent 0–100, ratio 1.5–8, attackMs/releaseMs from Speed mapping.
      *  externalDetectorBuffer: when non-null (SC active), use for detector; else internal 150 Hz HPF. */
@@ -37,6 +40,9 @@ public:
     void setNeonEnabled(bool enabled) { neonEnabled_ = enabled; }
     void setNeonBeforeCompressor(bool before) { neonBeforeCompressor_ = before; }
 
+    /** Neon and Compressor time is committed here per process() call when OMBIC_STAGE_PROFILING is on. */
+    void setStageProfiler(StageProfiler* profiler) { stageProfiler_ = profiler; }
+
     float getLastGainReductionDb() const { return pwm_->getLastGainReductionDb(); }
 
 private:
@@ -45,6 +51,7 @@ private:
     std::unique_ptr<PwmCompressor> pwm_;
     bool neonBeforeCompressor_ = true;
     bool neonEnabled_ = true;
+    StageProfiler* stageProfiler_ = nullptr;
 };
 
 } // namespace emulation
@@ -8,17 +8,24 @@ constexpr float kPwmInternalHpfHz = 150.0f;
 constexpr float kSoftKneeDb = 2.0f;  // Slightly tighter than 3 dB so PWM GR is more audible
 } // namespace
 
-void PwmCompressor::prepare(double sampleRate)
+void PwmCompressor::prepare(double sampleRate, int maxBlockSize)
 {
     sampleRate_ = sampleRate;
-    envelope_ = 0.0f;
-    samplesInGr_ = 0;
-    currentGrDb_ = 0.0f;
-    lastGrDb_ = 0.0f;
+    detectorBuffer_.setSize(1, juce::jmax(1, maxBlockSize), false, true, false);
     internalHpfCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeHighPass(
         sampleRate, kPwmInternalHpfHz, 0.7071f);
     if (internalHpfCoeffs_)
         internalHpf_.coefficients = internalHpfCoeffs_;
+    reset();
+}
+
+void PwmCompressor::reset() noexcept
+{
+    envelope_ = 0.0f;
+    samplesInGr_ = 0;
+    currentGrDb_ = 0.0f;
+    lastGrDb_ = 0.0f;
+    internalHpf_.reset();
     for (int i = 0; i < 4; ++i)
         internalHpfState_[i] = 0.0f;
 }
@@ -32,7 +39,7 @@ float PwmCompressor::speedToCoeff(float timeMs, bool isAttack) const
     return juce::jlimit(0.0f, 1.0f, coeff);
 }
 
-float PwmCompressor::gainComputerDb(float levelDb, float thresholdDb, float ratio) const
+float PwmCompressor::gainComputerDb(float levelDb, float thresholdDb, float ratio) noexcept
 {
     float over = levelDb - thresholdDb;
     if (over <= -kSoftKneeDb) return 0.0f;
@@ -43,6 +50,14 @@ float PwmCompressor::gainComputerDb(float levelDb, float thresholdDb, float rati
     return t * over * (1.0f - 1.0f / ratio);
 }
 
+std::pair<float, float> PwmCompressor::speedToTimesMs(float speedPercent) noexcept
+{
+    const float speedNorm = juce::jlimit(0.0f, 100.0f, speedPercent) / 100.0f;
+    const float attackMs = juce::jlimit(0.5f, 80.0f, 80.0f * std::pow(0.0125f, speedNorm));
+    const float releaseMs = juce::jlimit(30.0f, 800.0f, 800.0f * std::pow(0.0375f, speedNorm));
+    return { attackMs, releaseMs };
+}
+
 void PwmCompressor::updateEnvelope(float detectorLevel, int numSamples)
 {
     float target = detectorLevel;
@@ -65,13 +80,10 @@ void PwmCompressor::process(juce::AudioBuffer<float>& buffer,
     const int numSamples = buffer.getNumSamples();
     if (numChannels == 0 || numSamples == 0) return;
 
-    thresholdDb_ = -60.0f + (thresholdPercent / 100.0f) * 60.0f;
+    thresholdDb_ = thresholdPercentToDb(thresholdPercent);
     attackCoeff_ = speedToCoeff(attackMs, true);
     releaseCoeff_ = speedToCoeff(releaseMs, false);
 
-    if (detectorBuffer_.getNumSamples() < numSamples)
-        detectorBuffer_.setSize(1, numSamples);
-
     const bool useExternal = (externalDetector != nullptr && externalDetector->getNumSamples() >= numSamples);
     const float* extMono = useExternal ? externalDetector->getReadPointer(0) : nullptr;
 
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include <optional>
+#include <utility>
 
 namespace emulation {
 
@@ -11,7 +12,10 @@ class PwmCompressor
 public:
     PwmCompressor() = default;
 
-    void prepare(double sampleRate);
+    /** maxBlockSize: largest block process() will receive; sizes scratch so the audio thread never allocates. */
+    void prepare(double sampleRate, int maxBlockSize = 4096);
+    /** Clear the envelope and detector filter history, as after prepare(). */
+    void reset() noexcept;
     /** Process buffer. thresholdPercent 0–100, ratio 1.5–8, attackMs/releaseMs from Speed mapping.
      *  externalDetector: when non-null, use for level detection; when null, use internal 150 Hz HPF on output. */
     void process(juce::AudioBuffer<float>& buffer,
@@ -23,8 +27,14 @@ public:
 
     float getLastGainReductionDb() const { return lastGrDb_; }
 
+    /** Threshold knob (0–100 %) to detector threshold in dB, as process() maps it. */
+    static float thresholdPercentToDb(float thresholdPercent) noexcept { return -60.0f + (thresholdPercent / 100.0f) * 60.0f; }
+    /** Static soft-knee gain computer (dB of gain reduction for a detector level). Also drives the GUI transfer curve. */
+    static float gainComputerDb(float levelDb, float thresholdDb, float ratio) noexcept;
+    /** Speed knob (0–100) to (attackMs, releaseMs) for process(): fast attack and release at 100, slow at 0. */
+    static std::pair<float, float> speedToTimesMs(float speedPercent) noexcept;
+
 private:
-    float gainComputerDb(float levelDb, float thresholdDb, float ratio) const;
     void updateEnvelope(float detectorLevel, int numSamples);
     float speedToCoeff(float timeMs, bool isAttack) const;
 
@@ -0,0 +1,49 @@
+#include "ScopeColumns.h"
+#include <algorithm>
+
+namespace emulation {
+
+void ScopeColumns::setNumColumns(int numColumns) noexcept
+{
+    requestedColumns_.store(juce::jlimit(1, kMaxColumns, numColumns), std::memory_order_relaxed);
+}
+
+void ScopeColumns::capture(const float* samples, int numSamples) noexcept
+{
+    if (samples == nullptr || numSamples <= 0)
+        return;
+    const juce::SpinLock::ScopedTryLockType sl(lock_);
+    if (!sl.isLocked())
+        return;
+
+    const int columns = juce::jmin(requestedColumns_.load(std::memory_order_relaxed), numSamples);
+    // Column c covers [c * n / columns, (c + 1) * n / columns): contiguous, non-empty, every sample in exactly one
+    int start = 0;
+    for (int c = 0; c < columns; ++c)
+    {
+        const int end = static_cast<int>((static_cast<juce::int64>(c) + 1) * numSamples / columns);
+        const auto range = juce::FloatVectorOperations::findMinAndMax(samples + start, end - start);
+        mins_[static_cast<size_t>(c)] = range.getStart();
+        maxs_[static_cast<size_t>(c)] = range.getEnd();
+        start = end;
+    }
+    count_ = columns;
+}
+
+void ScopeColumns::clear() noexcept
+{
+    const juce::SpinLock::ScopedTryLockType sl(lock_);
+    if (sl.isLocked())
+        count_ = 0;
+}
+
+int ScopeColumns::read(float* mins, float* maxs, int maxColumns) const
+{
+    const juce::SpinLock::ScopedLockType sl(lock_);
+    const int n = juce::jmin(count_, maxColumns);
+    std::copy(mins_.begin(), mins_.begin() + n, mins);
+    std::copy(maxs_.begin(), maxs_.begin() + n, maxs);
+    return n;
+}
+
+} // namespace emulation
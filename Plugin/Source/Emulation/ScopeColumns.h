@@ -0,0 +1,47 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+namespace emulation {
+
+/** Latest block reduced to one (min, max) pair per display column, for the Neon scopes.
+ *
+ *  The GUI sets the column count to its pixel width; the audio thread splits each captured block into that many
+ *  contiguous sample ranges and keeps only their extremes. Copying and drawing then cost O(width) however large the
+ *  host block is, and no sample peak between columns is lost (unlike picking every n-th sample). Blocks shorter than
+ *  the width give one column per sample.
+ *
+ *  Audio thread: capture() / clear() only try-lock and skip the block if the GUI is reading. */
+class ScopeColumns
+{
+public:
+    static constexpr int kMaxColumns = 2048;
+
+    ScopeColumns() = default;
+
+    /** Message thread: columns wanted (the scope's width in pixels). Takes effect from the next captured block.
+     *  When several views share a scope the last call wins; each view stretches the columns to its own width. */
+    void setNumColumns(int numColumns) noexcept;
+
+    /** Audio thread: reduce one block. */
+    void capture(const float* samples, int numSamples) noexcept;
+
+    /** Audio thread: no signal for this scope (e.g. Listen switched off). */
+    void clear() noexcept;
+
+    /** Message thread: copy the latest columns; returns how many (0 = nothing captured since the last clear). */
+    int read(float* mins, float* maxs, int maxColumns) const;
+
+private:
+    mutable juce::SpinLock lock_;
+    std::array<float, kMaxColumns> mins_{};
+    std::array<float, kMaxColumns> maxs_{};
+    int count_ = 0;
+    std::atomic<int> requestedColumns_{ 256 };
+
+    JUCE_DECLARE_NON_COPYABLE(ScopeColumns)
+};
+
+} // namespace emulation
@@ -0,0 +1,205 @@
+#include "SpectrumAnalyser.h"
+#include <cmath>
+#include <cstring>
+
+namespace emulation {
+
+namespace {
+
+void fillFloor(SpectrumAnalyser::Bands& b)
+{
+    b.levelDb.fill(SpectrumAnalyser::kFloorDb);
+    b.peakDb.fill(SpectrumAnalyser::kFloorDb);
+}
+
+} // namespace
+
+float SpectrumAnalyser::getBandFrequency(int band) noexcept
+{
+    const float t = static_cast<float>(band) / static_cast<float>(kNumBands - 1);
+    return kMinFrequencyHz * std::pow(kMaxFrequencyHz / kMinFrequencyHz, t);
+}
+
+SpectrumAnalyser::SpectrumAnalyser()
+    : juce::Thread("Ombic spectrum")
+{
+    for (auto& s : sources_)
+    {
+        s.fifoData.assign(static_cast<size_t>(kFifoSize), 0.0f);
+        s.frame.assign(static_cast<size_t>(kFftSize), 0.0f);
+        fillFloor(s.working);
+        fillFloor(s.published);
+    }
+    fftData_.assign(static_cast<size_t>(2 * kFftSize), 0.0f);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    active_.store(false);
+    stopThread(1000);
+}
+
+void SpectrumAnalyser::push(Source source, const float* samples, int numSamples) noexcept
+{
+    if (!isActive() || numSamples <= 0)
+        return;
+    auto& s = sources_[static_cast<size_t>(source)];
+    const auto scope = s.fifo.write(juce::jmin(numSamples, s.fifo.getFreeSpace()));
+    if (scope.blockSize1 > 0)
+        std::memcpy(s.fifoData.data() + scope.startIndex1, samples, sizeof(float) * static_cast<size_t>(scope.blockSize1));
+    if (scope.blockSize2 > 0)
+        std::memcpy(s.fifoData.data() + scope.startIndex2, samples + scope.blockSize1, sizeof(float) * static_cast<size_t>(scope.blockSize2));
+}
+
+std::uint32_t SpectrumAnalyser::getBands(Source source, Bands& dest) const
+{
+    const auto& s = sources_[static_cast<size_t>(source)];
+    const juce::SpinLock::ScopedLockType sl(s.publishLock);
+    dest = s.published;
+    return s.version.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+SpectrumAnalyser::Consumer::Consumer(SpectrumAnalyser& analyser) : analyser_(analyser)
+{
+    analyser_.addConsumer();
+}
+
+SpectrumAnalyser::Consumer::~Consumer()
+{
+    analyser_.removeConsumer();
+}
+
+void SpectrumAnalyser::addConsumer()
+{
+    if (numConsumers_++ == 0)
+    {
+        startThread(juce::Thread::Priority::low);
+        active_.store(true);
+    }
+}
+
+void SpectrumAnalyser::removeConsumer()
+{
+    jassert(numConsumers_ > 0);
+    if (--numConsumers_ == 0)
+    {
+        active_.store(false);
+        stopThread(1000);
+    }
+}
+
+//==============================================================================
+void SpectrumAnalyser::run()
+{
+    // Forget whatever was queued before the last stop, and start the display from the floor.
+    for (auto& s : sources_)
+    {
+        s.fifo.read(s.fifo.getNumReady());
+        std::fill(s.frame.begin(), s.frame.end(), 0.0f);
+        s.pendingSamples = 0;
+        fillFloor(s.working);
+    }
+
+    double preparedRate = 0.0;
+    while (!threadShouldExit())
+    {
+        const double sampleRate = sampleRate_.load();
+        if (sampleRate != preparedRate)
+        {
+            rebuildBandEdges(sampleRate);
+            preparedRate = sampleRate;
+        }
+        for (auto& s : sources_)
+        {
+            drainFifo(s);
+            if (s.pendingSamples >= kHopSize)
+                analyse(s, sampleRate);
+        }
+        wait(15);
+    }
+}
+
+void SpectrumAnalyser::drainFifo(SourceState& s)
+{
+    int ready = s.fifo.getNumReady();
+    if (ready > kFftSize)
+    {
+        // Behind (e.g. thread starved): only the newest frame matters.
+        s.fifo.read(ready - kFftSize);
+        ready = kFftSize;
+    }
+    if (ready <= 0)
+        return;
+    float* frame = s.frame.data();
+    std::memmove(frame, frame + ready, sizeof(float) * static_cast<size_t>(kFftSize - ready));
+    float* dest = frame + (kFftSize - ready);
+    const auto scope = s.fifo.read(ready);
+    if (scope.blockSize1 > 0)
+        std::memcpy(dest, s.fifoData.data() + scope.startIndex1, sizeof(float) * static_cast<size_t>(scope.blockSize1));
+    if (scope.blockSize2 > 0)
+        std::memcpy(dest + scope.blockSize1, s.fifoData.data() + scope.startIndex2, sizeof(float) * static_cast<size_t>(scope.blockSize2));
+    s.pendingSamples += ready;
+}
+
+void SpectrumAnalyser::rebuildBandEdges(double sampleRate)
+{
+    const double binHz = sampleRate / kFftSize;
+    const int lastBin = kFftSize / 2 - 1;
+    const double halfWidth = std::pow(2.0, 0.5 * kSmoothingOctaves);
+    for (int b = 0; b < kNumBands; ++b)
+    {
+        const double fc = getBandFrequency(b);
+        const auto i = static_cast<size_t>(b);
+        bandBin_[i] = static_cast<float>(juce::jlimit(1.0, static_cast<double>(lastBin), fc / binHz));
+        bandLo_[i] = juce::jlimit(1, lastBin, static_cast<int>(std::ceil(fc / halfWidth / binHz)));
+        bandHi_[i] = juce::jlimit(1, lastBin, static_cast<int>(std::floor(fc * halfWidth / binHz)));
+    }
+}
+
+void SpectrumAnalyser::analyse(SourceState& s, double sampleRate)
+{
+    const float elapsedS = static_cast<float>(s.pendingSamples / sampleRate);
+    s.pendingSamples = 0;
+
+    std::memcpy(fftData_.data(), s.frame.data(), sizeof(float) * static_cast<size_t>(kFftSize));
+    std::fill(fftData_.begin() + kFftSize, fftData_.end(), 0.0f);
+    window_.multiplyWithWindowingTable(fftData_.data(), static_cast<size_t>(kFftSize));
+    fft_.performFrequencyOnlyForwardTransform(fftData_.data(), true);
+
+    // Hann coherent gain 0.5: a sine of amplitude A peaks at A * N / 4.
+    const float toAmplitude = 4.0f / static_cast<float>(kFftSize);
+    const float* mag = fftData_.data();
+    const float levelCoeff = 1.0f - std::exp(-elapsedS / kLevelTimeConstantS);
+    const float peakFall = kPeakDecayDbPerSecond * elapsedS;
+    for (int b = 0; b < kNumBands; ++b)
+    {
+        const auto i = static_cast<size_t>(b);
+        float power = 0.0f;
+        if (bandLo_[i] <= bandHi_[i])
+        {
+            for (int k = bandLo_[i]; k <= bandHi_[i]; ++k)
+                power += mag[k] * mag[k];
+            power /= static_cast<float>(bandHi_[i] - bandLo_[i] + 1);
+        }
+        else
+        {
+            // Band narrower than one bin (low frequencies): interpolate between the neighbouring bins.
+            const int k = static_cast<int>(bandBin_[i]);
+            const float frac = bandBin_[i] - static_cast<float>(k);
+            const float a = mag[k] * mag[k], c = mag[k + 1] * mag[k + 1];
+            power = a + frac * (c - a);
+        }
+        const float db = juce::jmax(kFloorDb, 10.0f * std::log10(power * toAmplitude * toAmplitude + 1.0e-12f));
+        float& level = s.working.levelDb[i];
+        level += levelCoeff * (db - level);
+        float& peak = s.working.peakDb[i];
+        peak = juce::jmax(db, peak - peakFall);
+    }
+
+    const juce::SpinLock::ScopedLockType sl(s.publishLock);
+    s.published = s.working;
+    s.version.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace emulation
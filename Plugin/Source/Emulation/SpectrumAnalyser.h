@@ -0,0 +1,112 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace emulation {
+
+/** Real-time spectrum of the input, output and sidechain (detector) signals.
+ *
+ *  The audio thread only copies mono samples into per-source lock-free FIFOs (juce::AbstractFifo), and only while
+ *  a Consumer exists. A background thread (not the message thread) runs a Hann-windowed 4096-point juce::dsp::FFT
+ *  per source, averages power over fractional-octave bands on a log frequency axis, applies ~100 ms level smoothing
+ *  and a decaying peak, and publishes the band arrays. The editor copies those arrays and only draws them.
+ *
+ *  With no Consumer (editor closed) the thread is stopped and push() returns immediately. */
+class SpectrumAnalyser : private juce::Thread
+{
+public:
+    enum Source { Input, Output, Sidechain, NumSources };
+
+    static constexpr int kFftOrder = 12;
+    static constexpr int kFftSize = 1 << kFftOrder;
+    static constexpr int kHopSize = kFftSize / 4;
+    static constexpr int kNumBands = 192;               // log-spaced display points, 20 Hz .. 20 kHz
+    static constexpr float kMinFrequencyHz = 20.0f;
+    static constexpr float kMaxFrequencyHz = 20000.0f;
+    static constexpr float kSmoothingOctaves = 1.0f / 6.0f;
+    static constexpr float kFloorDb = -100.0f;
+
+    /** Centre frequency of display band (static, so the GUI can lay out the axis without locking). */
+    static float getBandFrequency(int band) noexcept;
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    /** prepareToPlay; band edges are rebuilt by the analysis thread on its next pass. */
+    void setSampleRate(double sampleRate) noexcept { sampleRate_.store(sampleRate); }
+
+    /** Audio thread: cheap check so callers can skip building mono mixes when nobody is watching. */
+    bool isActive() const noexcept { return active_.load(std::memory_order_relaxed); }
+
+    /** Audio thread: copy mono samples for one source. Drops what does not fit (analysis thread behind). */
+    void push(Source source, const float* samples, int numSamples) noexcept;
+
+    /** Holds the analyser running (thread started, push() enabled) for its lifetime. Message thread. */
+    class Consumer
+    {
+    public:
+        explicit Consumer(SpectrumAnalyser& analyser);
+        ~Consumer();
+
+    private:
+        SpectrumAnalyser& analyser_;
+        JUCE_DECLARE_NON_COPYABLE(Consumer)
+    };
+
+    struct Bands
+    {
+        std::array<float, kNumBands> levelDb;   // smoothed mean power over the band, dBFS (sine amplitude scale)
+        std::array<float, kNumBands> peakDb;    // max, falling at kPeakDecayDbPerSecond
+    };
+
+    /** Latest published bands. Returns the publication count for the source (changes whenever new data arrives),
+     *  so callers can skip repaints when it has not moved. Any thread except the audio thread. */
+    std::uint32_t getBands(Source source, Bands& dest) const;
+    std::uint32_t getVersion(Source source) const noexcept { return sources_[static_cast<size_t>(source)].version.load(); }
+
+private:
+    static constexpr int kFifoSize = 1 << 15;
+    static constexpr float kLevelTimeConstantS = 0.1f;
+    static constexpr float kPeakDecayDbPerSecond = 20.0f;
+
+    struct SourceState
+    {
+        // Audio thread -> analysis thread
+        juce::AbstractFifo fifo{ kFifoSize };
+        std::vector<float> fifoData;
+        // Analysis thread only
+        std::vector<float> frame;   // latest kFftSize samples, oldest first
+        int pendingSamples = 0;     // samples received since the last transform
+        Bands working;
+        // Analysis thread -> GUI
+        mutable juce::SpinLock publishLock;
+        Bands published;
+        std::atomic<std::uint32_t> version{ 0 };
+    };
+
+    void run() override;
+    void addConsumer();
+    void removeConsumer();
+    void rebuildBandEdges(double sampleRate);
+    void drainFifo(SourceState& s);
+    void analyse(SourceState& s, double sampleRate);
+
+    std::array<SourceState, NumSources> sources_;
+    std::atomic<double> sampleRate_{ 48000.0 };
+    std::atomic<bool> active_{ false };
+    int numConsumers_ = 0;   // message thread
+
+    juce::dsp::FFT fft_{ kFftOrder };
+    juce::dsp::WindowingFunction<float> window_{ static_cast<size_t>(kFftSize), juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData_;   // 2 * kFftSize, analysis thread
+    std::array<int, kNumBands> bandLo_{}, bandHi_{};   // inclusive bin ranges for the current sample rate
+    std::array<float, kNumBands> bandBin_{};           // fractional bin of the centre (used when a band is < 1 bin)
+
+    JUCE_DECLARE_NON_COPYABLE(SpectrumAnalyser)
+};
+
+} // namespace emulation
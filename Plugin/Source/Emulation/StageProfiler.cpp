@@ -0,0 +1,83 @@
+#include "StageProfiler.h"
+#include <algorithm>
+
+namespace emulation {
+
+const char* StageProfiler::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+    case Stage::Sidechain:  return "Sidechain";
+    case Stage::Neon:       return "Neon";
+    case Stage::Compressor: return "Compressor";
+    case Stage::Iron:       return "Iron";
+    case Stage::Makeup:     return "Makeup";
+    case Stage::Metering:   return "Metering";
+    case Stage::Total:      return "Total";
+    default:                return "";
+    }
+}
+
+StageProfiler::StageProfiler()
+{
+    nsPerTick_ = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}
+
+void StageProfiler::commit(const StageTicks& ticks, int numSamples) noexcept
+{
+    for (size_t s = 0; s < rings_.size(); ++s)
+    {
+        if (ticks.ticks[s] <= 0)
+            continue;
+        const double ns = static_cast<double>(ticks.ticks[s]) * nsPerTick_;
+        const auto ns32 = static_cast<std::uint64_t>(juce::jmin(ns, 4.0e9));
+        auto& ring = rings_[s];
+        const std::uint32_t n = ring.writeCount.load(std::memory_order_relaxed);
+        ring.entries[n % kHistory].store((ns32 << 32) | static_cast<std::uint32_t>(juce::jmax(0, numSamples)),
+                                         std::memory_order_relaxed);
+        ring.writeCount.store(n + 1, std::memory_order_release);
+    }
+}
+
+StageProfiler::Stats StageProfiler::getStats(Stage stage) const noexcept
+{
+    Stats st;
+    const auto& ring = rings_[static_cast<size_t>(stage)];
+    const std::uint32_t written = ring.writeCount.load(std::memory_order_acquire);
+    const int count = static_cast<int>(juce::jmin<std::uint32_t>(written, kHistory));
+    if (count == 0)
+        return st;
+
+    std::array<std::uint32_t, kHistory> ns;
+    double sumNs = 0.0, sumSamples = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+        const std::uint64_t e = ring.entries[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        ns[static_cast<size_t>(i)] = static_cast<std::uint32_t>(e >> 32);
+        sumNs += static_cast<double>(e >> 32);
+        sumSamples += static_cast<double>(e & 0xffffffffu);
+    }
+    auto begin = ns.begin(), end = ns.begin() + count;
+    const auto [mn, mx] = std::minmax_element(begin, end);
+    st.blocks = count;
+    st.minNs = *mn;
+    st.maxNs = *mx;
+    st.avgNs = sumNs / count;
+    st.avgNsPerSample = sumSamples > 0.0 ? sumNs / sumSamples : 0.0;
+    auto p99 = begin + juce::jmin(count - 1, (count * 99) / 100);
+    std::nth_element(begin, p99, end);
+    st.p99Ns = *p99;
+    return st;
+}
+
+void StageProfiler::reset() noexcept
+{
+    for (auto& ring : rings_)
+    {
+        ring.writeCount.store(0, std::memory_order_release);
+        for (auto& e : ring.entries)
+            e.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace emulation
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Compiled in with -DOMBIC_STAGE_PROFILING=1 (CMake option OMBIC_STAGE_PROFILING). When off, the macros below are empty.
+#ifndef OMBIC_STAGE_PROFILING
+ #define OMBIC_STAGE_PROFILING 0
+#endif
+
+namespace emulation {
+
+/** Per-stage DSP timing. The audio thread accumulates high-resolution ticks per stage for one block
+ *  (StageTicks, on the stack) and commits them once per block into per-stage rings of atomics.
+ *  Any other thread (editor overlay, benchmark, soak tools) reads rolling min/avg/p99/max from the rings. */
+class StageProfiler
+{
+public:
+    enum class Stage { Sidechain, Neon, Compressor, Iron, Makeup, Metering, Total, NumStages };
+    static constexpr int kNumStages = static_cast<int>(Stage::NumStages);
+    static constexpr int kHistory = 512;   // blocks per rolling window
+
+    static constexpr bool isEnabled() { return OMBIC_STAGE_PROFILING != 0; }
+    static const char* getStageName(Stage stage);
+
+    struct Stats
+    {
+        int blocks = 0;               // blocks in the window
+        double minNs = 0.0;           // per block
+        double avgNs = 0.0;
+        double p99Ns = 0.0;
+        double maxNs = 0.0;
+        double avgNsPerSample = 0.0;
+    };
+
+    /** Ticks accumulated for one block; a stage entered several times per block is summed. */
+    struct StageTicks
+    {
+        std::array<juce::int64, kNumStages> ticks{};
+    };
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage(StageTicks& t, Stage s) noexcept : ticks_(t), stage_(s), start_(juce::Time::getHighResolutionTicks()) {}
+        ~ScopedStage() noexcept { ticks_.ticks[static_cast<size_t>(stage_)] += juce::Time::getHighResolutionTicks() - start_; }
+
+    private:
+        StageTicks& ticks_;
+        Stage stage_;
+        juce::int64 start_;
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    StageProfiler();
+
+    /** Audio thread: record every stage that ran this block. Lock- and allocation-free. */
+    void commit(const StageTicks& ticks, int numSamples) noexcept;
+
+    /** Any thread. Allocation-free (window is copied to the stack). */
+    Stats getStats(Stage stage) const noexcept;
+
+    /** Clears all windows. Safe to call while the audio thread commits (a few entries may survive). */
+    void reset() noexcept;
+
+private:
+    struct Ring
+    {
+        // Each entry packs (ns << 32) | numSamples so a reader never sees a torn pair.
+        std::array<std::atomic<std::uint64_t>, kHistory> entries{};
+        std::atomic<std::uint32_t> writeCount{ 0 };
+    };
+    std::array<Ring, kNumStages> rings_;
+    double nsPerTick_ = 1.0;
+
+    JUCE_DECLARE_NON_COPYABLE(StageProfiler)
+};
+
+} // namespace emulation
+
+#if OMBIC_STAGE_PROFILING
+ #define OMBIC_STAGE_TICKS(name) emulation::StageProfiler::StageTicks name
+ #define OMBIC_STAGE_SCOPE(ticks, stage) \
+     const emulation::StageProfiler::ScopedStage JUCE_JOIN_MACRO(ombicStageScope_, __LINE__)(ticks, emulation::StageProfiler::Stage::stage)
+ #define OMBIC_STAGE_COMMIT(profilerPtr, ticks, numSamples) \
+     do { if ((profilerPtr) != nullptr) (profilerPtr)->commit(ticks, numSamples); } while (false)
+#else
+ #define OMBIC_STAGE_TICKS(name)
+ #define OMBIC_STAGE_SCOPE(ticks, stage)
+ #define OMBIC_STAGE_COMMIT(profilerPtr, ticks, numSamples)
+#endif
@@ -3,24 +3,25 @@
 
 namespace emulation {
 
-THDCharacter::THDCharacter(const std::vector<THDRow>& thdRows,
+THDCharacter::THDCharacter(const ColumnTable& thd,
                            float referenceLevelDb, float mix)
 {
+    using namespace THDColumn;
     mix_ = juce::jlimit(0.0f, 1.0f, mix);
     float thdPct = 0.0f;
-    for (const auto& r : thdRows)
+    for (int r = 0; r < thd.numRows; ++r)
     {
-        if (r.levelDb.has_value() && std::abs(*r.levelDb - referenceLevelDb) < 0.1f)
+        if (thd.has(LevelDb, r) && std::abs(thd.column(LevelDb)[r] - referenceLevelDb) < 0.1f)
         {
-            if (r.thdPercent.has_value()) thdPct = *r.thdPercent;
+            if (thd.has(ThdPercent, r)) thdPct = thd.column(ThdPercent)[r];
             break;
         }
     }
     if (thdPct <= 0.0f)
     {
-        for (const auto& r : thdRows)
-            if (r.thdPercent.has_value() && *r.thdPercent > thdPct)
-                thdPct = *r.thdPercent;
+        for (int r = 0; r < thd.numRows; ++r)
+            if (thd.has(ThdPercent, r) && thd.column(ThdPercent)[r] > thdPct)
+                thdPct = thd.column(ThdPercent)[r];
     }
     float k = 2.0f;
     drive_ = 1.0f + k * (thdPct / 100.0f);
@@ -10,7 +10,7 @@ namespace emulation {
 class THDCharacter
 {
 public:
-    THDCharacter(const std::vector<THDRow>& thdRows,
+    THDCharacter(const ColumnTable& thd,
                  float referenceLevelDb = -4.0f,
                  float mix = 1.0f);
 
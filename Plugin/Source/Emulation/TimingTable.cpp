@@ -0,0 +1,82 @@
+#include "TimingTable.h"
+#include <map>
+#include <set>
+
+namespace emulation {
+
+void TimingTable::build(const ColumnTable& timing)
+{
+    using namespace TimingColumn;
+    attackMs_.clear();
+    releaseMs_.clear();
+    attackAxis_.setValues({});
+    releaseAxis_.setValues({});
+
+    // Usable rows by knob position (a repeated position keeps the last row, as the file order intends)
+    std::map<std::pair<float, float>, std::pair<float, float>> usable;
+    std::set<float> attackParams, releaseParams;
+    for (int r = 0; r < timing.numRows; ++r)
+    {
+        const bool measurementOk = timing.get(MeasurementOk, r).value_or(1.0f) != 0.0f;
+        if (!measurementOk || !timing.has(AttackParam, r) || !timing.has(ReleaseParam, r)
+            || !timing.has(AttackTimeMs, r) || !timing.has(ReleaseTimeMs, r))
+            continue;
+        const float attackParam = timing.column(AttackParam)[r], releaseParam = timing.column(ReleaseParam)[r];
+        usable[{ attackParam, releaseParam }] = { timing.column(AttackTimeMs)[r], timing.column(ReleaseTimeMs)[r] };
+        attackParams.insert(attackParam);
+        releaseParams.insert(releaseParam);
+    }
+    if (usable.empty())
+        return;
+
+    attackAxis_.setValues({ attackParams.begin(), attackParams.end() });
+    releaseAxis_.setValues({ releaseParams.begin(), releaseParams.end() });
+    const auto& av = attackAxis_.values;
+    const auto& rv = releaseAxis_.values;
+    const float attackSpan = juce::jmax(1e-6f, av.back() - av.front());
+    const float releaseSpan = juce::jmax(1e-6f, rv.back() - rv.front());
+
+    attackMs_.reserve(av.size() * rv.size());
+    releaseMs_.reserve(av.size() * rv.size());
+    for (float a : av)
+    {
+        for (float r : rv)
+        {
+            auto it = usable.find({ a, r });
+            if (it == usable.end())
+            {
+                float bestD = 0.0f;
+                for (auto u = usable.begin(); u != usable.end(); ++u)
+                {
+                    const float da = (u->first.first - a) / attackSpan, dr = (u->first.second - r) / releaseSpan;
+                    const float d = da * da + dr * dr;
+                    if (it == usable.end() || d < bestD) { it = u; bestD = d; }
+                }
+            }
+            attackMs_.push_back(it->second.first);
+            releaseMs_.push_back(it->second.second);
+        }
+    }
+}
+
+std::pair<float, float> TimingTable::lookup(float attackParam, float releaseParam) const noexcept
+{
+    const int numRelease = static_cast<int>(releaseAxis_.values.size());
+    int ia = 0, ir = 0, stepA = 0, stepR = 0;
+    float fa = 0.0f, fr = 0.0f;
+    if (attackAxis_.values.size() > 1) { ia = attackAxis_.locate(attackParam, fa); stepA = numRelease; }
+    if (numRelease > 1) { ir = releaseAxis_.locate(releaseParam, fr); stepR = 1; }
+
+    const size_t i00 = static_cast<size_t>(ia * numRelease + ir);
+    const size_t i01 = i00 + static_cast<size_t>(stepR);
+    const size_t i10 = i00 + static_cast<size_t>(stepA);
+    const size_t i11 = i10 + static_cast<size_t>(stepR);
+    auto bilinear = [&](const std::vector<float>& v) {
+        const float lo = v[i00] + fr * (v[i01] - v[i00]);
+        const float hi = v[i10] + fr * (v[i11] - v[i10]);
+        return lo + fa * (hi - lo);
+    };
+    return { bilinear(attackMs_), bilinear(releaseMs_) };
+}
+
+} // namespace emulation
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "DataLoader.h"
+#include "CurveLattice.h"
+#include <utility>
+#include <vector>
+
+namespace emulation {
+
+/** Measured attack / release times (ms) on the (attack_param, release_param) knob grid, e.g. the 20 x 20 grid in
+ *  fetish_v2/timing.csv. Built once at load time into two flat arrays; lookups locate the cell in O(1) and
+ *  interpolate bilinearly, so times glide as the knobs turn instead of snapping to the nearest measured row.
+ *
+ *  Rows with measurement_ok False (or a missing time) are skipped; grid nodes left without a usable row take the
+ *  nearest usable one. With no usable rows the table is empty and the caller falls back to the knob values. */
+class TimingTable
+{
+public:
+    void build(const ColumnTable& timing);
+
+    bool isEmpty() const noexcept { return attackMs_.empty(); }
+
+    /** Heap bytes held by the grid and its axes. */
+    size_t getMemoryBytes() const noexcept
+    {
+        return (attackMs_.capacity() + releaseMs_.capacity() + attackAxis_.values.capacity()
+                + releaseAxis_.values.capacity()) * sizeof(float);
+    }
+
+    /** Knob positions of the grid (ascending). */
+    const std::vector<float>& getAttackParams() const noexcept { return attackAxis_.values; }
+    const std::vector<float>& getReleaseParams() const noexcept { return releaseAxis_.values; }
+
+    /** (attack ms, release ms) at the knob position, clamped to the measured grid. Requires !isEmpty(). */
+    std::pair<float, float> lookup(float attackParam, float releaseParam) const noexcept;
+
+private:
+    LatticeAxis attackAxis_, releaseAxis_;
+    std::vector<float> attackMs_, releaseMs_;   // [attack index * release count + release index]
+};
+
+} // namespace emulation
@@ -0,0 +1,111 @@
+#include "TruePeakDetector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+namespace emulation {
+
+namespace {
+
+constexpr int kHistory = TruePeakDetector::kTapsPerPhase - 1;
+
+// BS.1770-4 Annex 2 interpolation filter, stored [tap][phase] so one SIMD register holds a tap for all four phases.
+alignas(16) const float kPolyphase[TruePeakDetector::kTapsPerPhase][TruePeakDetector::kOversampling] = {
+    {  0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f },
+    {  0.0109863281250f,  0.0292968750000f,  0.0330810546875f,  0.0148925781250f },
+    { -0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f },
+    {  0.0332031250000f,  0.0891113281250f,  0.1015625000000f,  0.0476074218750f },
+    { -0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f },
+    {  0.1373291015625f,  0.4650878906250f,  0.7797851562500f,  0.9721679687500f },
+    {  0.9721679687500f,  0.7797851562500f,  0.4650878906250f,  0.1373291015625f },
+    { -0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f },
+    {  0.0476074218750f,  0.1015625000000f,  0.0891113281250f,  0.0332031250000f },
+    { -0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f },
+    {  0.0148925781250f,  0.0330810546875f,  0.0292968750000f,  0.0109863281250f },
+    { -0.0083007812500f, -0.0189208984375f, -0.0291748046875f,  0.0017089843750f },
+};
+
+} // namespace
+
+void TruePeakDetector::prepare(int maxBlockSize, int numChannels)
+{
+    maxBlockSize_ = juce::jmax(1, maxBlockSize);
+    work_.assign(static_cast<size_t>(juce::jmax(1, numChannels)),
+                 std::vector<float>(static_cast<size_t>(kHistory + maxBlockSize_), 0.0f));
+}
+
+void TruePeakDetector::reset()
+{
+    for (auto& w : work_)
+        std::fill(w.begin(), w.begin() + kHistory, 0.0f);
+}
+
+float TruePeakDetector::processChannel(int channel, const float* samples, int numSamples)
+{
+    if (channel < 0 || channel >= getNumChannels() || numSamples <= 0)
+        return 0.0f;
+    numSamples = juce::jmin(numSamples, maxBlockSize_);
+    float* w = work_[static_cast<size_t>(channel)].data();
+    std::memcpy(w + kHistory, samples, sizeof(float) * static_cast<size_t>(numSamples));
+
+    // Output phase p at input n: sum_k kPolyphase[k][p] * x[n - k], with x[n - k] = w[kHistory + n - k].
+    float peak = 0.0f;
+#if JUCE_USE_SSE_INTRINSICS
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 taps[kTapsPerPhase];
+    for (int k = 0; k < kTapsPerPhase; ++k)
+        taps[k] = _mm_load_ps(kPolyphase[k]);
+    __m128 vPeak = _mm_setzero_ps();
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float* x = w + kHistory + n;
+        __m128 acc = _mm_mul_ps(taps[0], _mm_set1_ps(x[0]));
+        for (int k = 1; k < kTapsPerPhase; ++k)
+            acc = _mm_add_ps(acc, _mm_mul_ps(taps[k], _mm_set1_ps(x[-k])));
+        vPeak = _mm_max_ps(vPeak, _mm_and_ps(acc, absMask));
+    }
+    vPeak = _mm_max_ps(vPeak, _mm_movehl_ps(vPeak, vPeak));
+    vPeak = _mm_max_ss(vPeak, _mm_shuffle_ps(vPeak, vPeak, 1));
+    peak = _mm_cvtss_f32(vPeak);
+#elif JUCE_USE_ARM_NEON
+    float32x4_t taps[kTapsPerPhase];
+    for (int k = 0; k < kTapsPerPhase; ++k)
+        taps[k] = vld1q_f32(kPolyphase[k]);
+    float32x4_t vPeak = vdupq_n_f32(0.0f);
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float* x = w + kHistory + n;
+        float32x4_t acc = vmulq_n_f32(taps[0], x[0]);
+        for (int k = 1; k < kTapsPerPhase; ++k)
+            acc = vmlaq_n_f32(acc, taps[k], x[-k]);
+        vPeak = vmaxq_f32(vPeak, vabsq_f32(acc));
+    }
+    float32x2_t p2 = vpmax_f32(vget_low_f32(vPeak), vget_high_f32(vPeak));
+    p2 = vpmax_f32(p2, p2);
+    peak = vget_lane_f32(p2, 0);
+#else
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float* x = w + kHistory + n;
+        for (int p = 0; p < kOversampling; ++p)
+        {
+            float acc = 0.0f;
+            for (int k = 0; k < kTapsPerPhase; ++k)
+                acc += kPolyphase[k][p] * x[-k];
+            peak = std::max(peak, std::abs(acc));
+        }
+    }
+#endif
+
+    // Keep the last kHistory input samples for the next block.
+    std::memmove(w, w + numSamples, sizeof(float) * static_cast<size_t>(kHistory));
+    return peak;
+}
+
+} // namespace emulation
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace emulation {
+
+/** ITU-R BS.1770-4 (Annex 2) true-peak detector: 4x oversampling with the 48-tap polyphase FIR from the
+ *  recommendation, max abs over the oversampled signal. The four phases are evaluated together in one SIMD
+ *  register per input sample. prepare() allocates; processChannel() is allocation-free (audio thread). */
+class TruePeakDetector
+{
+public:
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+
+    void prepare(int maxBlockSize, int numChannels);
+    /** Clears the filter history (call when detection is switched on after a gap). */
+    void reset();
+
+    /** Linear true peak of numSamples (<= maxBlockSize) samples of one channel; filter state carries across blocks. */
+    float processChannel(int channel, const float* samples, int numSamples);
+
+    int getNumChannels() const { return static_cast<int>(work_.size()); }
+
+private:
+    // Per channel: kTapsPerPhase - 1 samples of history followed by the current block.
+    std::vector<std::vector<float>> work_;
+    int maxBlockSize_ = 0;
+};
+
+} // namespace emulation
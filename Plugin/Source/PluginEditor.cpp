@@ -1,5 +1,5 @@
 #include "PluginEditor.h"
-#include "OmbicAssets.h"
+#include "Components/PaintProfiler.h"
 
 //==============================================================================
 OmbicCompressorEditor::OmbicCompressorEditor(OmbicCompressorProcessor& p)
@@ -11,6 +11,7 @@ OmbicCompressorEditor::OmbicCompressorEditor(OmbicCompressorProcessor& p)
     , outputSection(p)
     , meterStrip(p)
     , mainVu_(p)
+    , renderScheduler_(*this, p)
 {
     setLookAndFeel(&ombicLf);
     const int specW = 900;
@@ -74,6 +75,8 @@ OmbicCompressorEditor::OmbicCompressorEditor(OmbicCompressorProcessor& p)
         apvts, OmbicCompressorProcessor::paramRelease, compressorSection.getReleaseSlider());
     speedAttachment = std::make_unique<SliderAttachment>(
         apvts, OmbicCompressorProcessor::paramPwmSpeed, compressorSection.getSpeedSlider());
+    characterAttachment = std::make_unique<SliderAttachment>(
+        apvts, OmbicCompressorProcessor::paramCharacter, compressorSection.getCharacterSlider());
     makeupAttachment = std::make_unique<SliderAttachment>(
         apvts, OmbicCompressorProcessor::paramMakeupGainDb, outputSection.getOutputSlider());
     ironAttachment = std::make_unique<SliderAttachment>(
@@ -104,7 +107,13 @@ OmbicCompressorEditor::OmbicCompressorEditor(OmbicCompressorProcessor& p)
     saturatorSection.applyPercentDisplay();
 
     updateModeVisibility();
-    startTimerHz(45);
+    renderScheduler_.onTick = [this](const RenderScheduler::Frame&) { editorTick(); };
+    renderScheduler_.addClient(sidechainFilterSection);
+    renderScheduler_.addClient(compressorSection);
+    renderScheduler_.addClient(saturatorSection);
+    renderScheduler_.addClient(outputSection);
+    renderScheduler_.addClient(meterStrip);
+    renderScheduler_.addClient(mainVu_);
 
     lastCurveDataState_ = processorRef.hasCurveDataLoaded();
     const bool curveOk = processorRef.hasCurveDataLoaded();
@@ -116,10 +125,7 @@ OmbicCompressorEditor::OmbicCompressorEditor(OmbicCompressorProcessor& p)
     pwmPill_.setEnabled(curveOk);
     vcaPill_.setEnabled(curveOk);
 
-    int logoSize = 0;
-    const char* logoData = OmbicAssets::getNamedResource("Ombic_Alpha_png", logoSize);
-    if (logoData != nullptr && logoSize > 0)
-        logoWatermark_ = juce::ImageCache::getFromMemory(logoData, logoSize);
+    logoWatermark_ = OmbicLookAndFeel::getLogoImage();
 }
 
 OmbicCompressorEditor::~OmbicCompressorEditor()
@@ -127,7 +133,7 @@ OmbicCompressorEditor::~OmbicCompressorEditor()
     setLookAndFeel(nullptr);
 }
 
-void OmbicCompressorEditor::timerCallback()
+void OmbicCompressorEditor::editorTick()
 {
     updateModeVisibility();
     // §3: animate column widths toward target (300ms ease)
@@ -169,23 +175,17 @@ void OmbicCompressorEditor::timerCallback()
         vcaPill_.setEnabled(curveLoaded);
         repaint();
     }
-    compressorSection.updateGrReadout();
     compressorSection.updateCompressLimitButtonStates();
     compressorSection.updateFetCharacterPillStates();
+    compressorSection.updateCurveProfileControls();
     compressorSection.setHighlight(compressorSection.isInteracting());
     saturatorSection.setHighlight(saturatorSection.isInteracting());
     outputSection.setHighlight(outputSection.isInteracting());
-    outputSection.updateGrReadout();
-    outputSection.repaint();  // IN/OUT meters
-    saturatorSection.repaint();  // neon capsule glow + scope
-    meterStrip.repaint();
     int modeId = compressorSection.getModeCombo().getSelectedId();
     optoPill_.setToggleState(modeId == 1, juce::dontSendNotification);
     fetPill_.setToggleState(modeId == 2, juce::dontSendNotification);
     pwmPill_.setToggleState(modeId == 3, juce::dontSendNotification);
     vcaPill_.setToggleState(modeId == 4, juce::dontSendNotification);
-    if (compressorSection.getGainReductionMeter())
-        compressorSection.getGainReductionMeter()->repaint();
 }
 
 void OmbicCompressorEditor::updateModeVisibility()
@@ -212,6 +212,7 @@ namespace
 
 void OmbicCompressorEditor::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     auto full = getLocalBounds();
     const int w = full.getWidth();
     const int h = full.getHeight();
@@ -9,10 +9,10 @@
 #include "Components/SidechainFilterSection.h"
 #include "Components/MeterStrip.h"
 #include "Components/MainVuComponent.h"
+#include "Components/RenderScheduler.h"
 
 //==============================================================================
-class OmbicCompressorEditor : public juce::AudioProcessorEditor,
-                              private juce::Timer
+class OmbicCompressorEditor : public juce::AudioProcessorEditor
 {
 public:
     explicit OmbicCompressorEditor(OmbicCompressorProcessor&);
@@ -22,7 +22,8 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
+    /** Editor-level state (column animation, pills, highlights) on each scheduler tick, before the sections. */
+    void editorTick();
     void updateModeVisibility();
     void applyColumnLayout(int scFilterW, int compW, int neonW, int outW, int mainVuH);
 
@@ -64,6 +65,7 @@ private:
     std::unique_ptr<SliderAttachment> attackAttachment;
     std::unique_ptr<SliderAttachment> releaseAttachment;
     std::unique_ptr<SliderAttachment> speedAttachment;
+    std::unique_ptr<SliderAttachment> characterAttachment;
     std::unique_ptr<SliderAttachment> makeupAttachment;
     std::unique_ptr<SliderAttachment> ironAttachment;
     std::unique_ptr<ButtonAttachment> autoGainAttachment;
@@ -77,5 +79,7 @@ private:
     std::unique_ptr<ButtonAttachment> neonEnableAttachment;
     std::unique_ptr<ComboBoxAttachment> mainVuDisplayAttachment;
 
+    RenderScheduler renderScheduler_;   // last: destroyed first, so it never ticks a destroyed section
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OmbicCompressorEditor)
 };
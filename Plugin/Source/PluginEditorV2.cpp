@@ -1,5 +1,6 @@
 #include "PluginEditorV2.h"
-#include "OmbicAssets.h"
+#include "Components/PaintProfiler.h"
+#include "Components/CachedLayer.h"
 
 OmbicCompressorEditorV2::OmbicCompressorEditorV2(OmbicCompressorProcessor& p)
     : AudioProcessorEditor(&p)
@@ -8,8 +9,7 @@ OmbicCompressorEditorV2::OmbicCompressorEditorV2(OmbicCompressorProcessor& p)
     , compressorSection(p)
     , saturatorSection(p)
     , outputSection(p)
-    , mainViewAsTube_(p)
-    , mainVu_(p)
+    , renderScheduler_(*this, p)
 {
     setLookAndFeel(&ombicLf);
     setSize(kBaseWidth, kBaseHeight);
@@ -41,8 +41,6 @@ OmbicCompressorEditorV2::OmbicCompressorEditorV2(OmbicCompressorProcessor& p)
     addAndMakeVisible(compressorSection);
     addAndMakeVisible(saturatorSection);
     addAndMakeVisible(outputSection);
-    addAndMakeVisible(mainViewAsTube_);
-    addAndMakeVisible(mainVu_);
 
     mainVuTubeButton_.setButtonText("Tube");
     mainVuTubeButton_.setName("mainVuTube");
@@ -86,6 +84,8 @@ OmbicCompressorEditorV2::OmbicCompressorEditorV2(OmbicCompressorProcessor& p)
         apvts, OmbicCompressorProcessor::paramRelease, compressorSection.getReleaseSlider());
     speedAttachment = std::make_unique<SliderAttachment>(
         apvts, OmbicCompressorProcessor::paramPwmSpeed, compressorSection.getSpeedSlider());
+    characterAttachment = std::make_unique<SliderAttachment>(
+        apvts, OmbicCompressorProcessor::paramCharacter, compressorSection.getCharacterSlider());
     makeupAttachment = std::make_unique<SliderAttachment>(
         apvts, OmbicCompressorProcessor::paramMakeupGainDb, outputSection.getOutputSlider());
     ironAttachment = std::make_unique<SliderAttachment>(
@@ -113,7 +113,11 @@ OmbicCompressorEditorV2::OmbicCompressorEditorV2(OmbicCompressorProcessor& p)
     saturatorSection.applyPercentDisplay();
 
     updateModeVisibility();
-    startTimerHz(45);
+    renderScheduler_.onTick = [this](const RenderScheduler::Frame&) { editorTick(); };
+    renderScheduler_.addClient(sidechainFilterSection);
+    renderScheduler_.addClient(compressorSection);
+    renderScheduler_.addClient(saturatorSection);
+    renderScheduler_.addClient(outputSection);
 
     lastCurveDataState_ = processorRef.hasCurveDataLoaded();
     const bool curveOk = processorRef.hasCurveDataLoaded();
@@ -125,10 +129,7 @@ OmbicCompressorEditorV2::OmbicCompressorEditorV2(OmbicCompressorProcessor& p)
     pwmPill_.setEnabled(curveOk);
     vcaPill_.setEnabled(curveOk);
 
-    int logoSize = 0;
-    const char* logoData = OmbicAssets::getNamedResource("Ombic_Alpha_png", logoSize);
-    if (logoData != nullptr && logoSize > 0)
-        logoWatermark_ = juce::ImageCache::getFromMemory(logoData, logoSize);
+    logoWatermark_ = OmbicLookAndFeel::getLogoImage();
 }
 
 OmbicCompressorEditorV2::~OmbicCompressorEditorV2()
@@ -136,18 +137,19 @@ OmbicCompressorEditorV2::~OmbicCompressorEditorV2()
     setLookAndFeel(nullptr);
 }
 
-void OmbicCompressorEditorV2::timerCallback()
+void OmbicCompressorEditorV2::editorTick()
 {
     updateModeVisibility();
-    compressorSection.updateGrReadout();
     compressorSection.updateCompressLimitButtonStates();
     compressorSection.updateFetCharacterPillStates();
-    outputSection.updateGrReadout();
-    outputSection.repaint();
-    saturatorSection.repaint();
-    mainViewAsTube_.repaint();
-    mainVu_.updateFromParameter();
-    mainVu_.repaint();
+    compressorSection.updateCurveProfileControls();
+    if (mainVu_ != nullptr)
+        mainVu_->updateFromParameter();
+    if (stageTimingOverlay_ != nullptr && stageTimingOverlay_->isVisible() && ++stageTimingTicks_ >= kStageTimingEveryTicks)
+    {
+        stageTimingTicks_ = 0;
+        stageTimingOverlay_->refresh(processorRef.getSampleRate());
+    }
     int modeId = compressorSection.getModeCombo().getSelectedId();
     optoPill_.setToggleState(modeId == 1, juce::dontSendNotification);
     fetPill_.setToggleState(modeId == 2, juce::dontSendNotification);
@@ -161,8 +163,7 @@ void OmbicCompressorEditorV2::timerCallback()
 
     auto* mainVuParam = processorRef.getValueTreeState().getParameter(OmbicCompressorProcessor::paramMainVuDisplay);
     const bool isSimple = mainVuParam && mainVuParam->getValue() > 0.5f;
-    mainViewAsTube_.setVisible(!isSimple);
-    mainVu_.setVisible(isSimple);
+    showMainView(isSimple);
     mainVuTubeButton_.setToggleState(!isSimple, juce::dontSendNotification);
     mainVuArcButton_.setToggleState(isSimple, juce::dontSendNotification);
 
@@ -181,6 +182,64 @@ void OmbicCompressorEditorV2::timerCallback()
     }
 }
 
+bool OmbicCompressorEditorV2::keyPressed(const juce::KeyPress& key)
+{
+    if (emulation::StageProfiler::isEnabled()
+        && key.getKeyCode() == 'P'
+        && key.getModifiers().isCommandDown() && key.getModifiers().isShiftDown())
+    {
+        if (stageTimingOverlay_ == nullptr)
+        {
+            stageTimingOverlay_ = std::make_unique<StageTimingOverlay>(processorRef.getStageProfiler(),
+                                                                       renderScheduler_.getPaintProfiler());
+            addChildComponent(*stageTimingOverlay_);
+            resized();
+        }
+        stageTimingOverlay_->setVisible(!stageTimingOverlay_->isVisible());
+        if (stageTimingOverlay_->isVisible())
+        {
+            stageTimingOverlay_->toFront(false);
+            stageTimingOverlay_->refresh(processorRef.getSampleRate());
+        }
+        return true;
+    }
+    // Cmd/Ctrl+Shift+L: static-layer caching on/off, to compare the overlay's GUI paint row with and without it
+    if (emulation::StageProfiler::isEnabled()
+        && key.getKeyCode() == 'L'
+        && key.getModifiers().isCommandDown() && key.getModifiers().isShiftDown())
+    {
+        CachedLayer::setCachingEnabled(!CachedLayer::isCachingEnabled());
+        renderScheduler_.getPaintProfiler().reset();
+        repaint();
+        return true;
+    }
+    return AudioProcessorEditor::keyPressed(key);
+}
+
+void OmbicCompressorEditorV2::showMainView(bool isSimple)
+{
+    if (isSimple && mainVu_ == nullptr)
+    {
+        mainVu_ = std::make_unique<MainVuComponent>(processorRef);
+        mainVu_->setBounds(mainViewRect_);
+        mainVu_->updateFromParameter();
+        addChildComponent(*mainVu_, 0);   // behind the overlay
+        renderScheduler_.addClient(*mainVu_);
+    }
+    else if (!isSimple && mainViewAsTube_ == nullptr)
+    {
+        mainViewAsTube_ = std::make_unique<MainViewAsTubeComponent>(processorRef);
+        mainViewAsTube_->setBounds(mainViewRect_);
+        addChildComponent(*mainViewAsTube_, 0);
+        renderScheduler_.addClient(*mainViewAsTube_);
+    }
+
+    if (mainViewAsTube_ != nullptr)
+        mainViewAsTube_->setVisible(!isSimple);
+    if (mainVu_ != nullptr)
+        mainVu_->setVisible(isSimple);
+}
+
 void OmbicCompressorEditorV2::updateModeVisibility()
 {
     auto* raw = processorRef.getValueTreeState().getRawParameterValue(OmbicCompressorProcessor::paramCompressorMode);
@@ -192,6 +251,7 @@ void OmbicCompressorEditorV2::updateModeVisibility()
 
 void OmbicCompressorEditorV2::paint(juce::Graphics& g)
 {
+    OMBIC_PAINT_SCOPE(*this);
     auto full = getLocalBounds();
     const int w = full.getWidth();
     const int h = full.getHeight();
@@ -279,9 +339,11 @@ void OmbicCompressorEditorV2::resized()
     auto mainVuToggleRow = content.removeFromTop(mainVuToggleH);
     mainVuTubeButton_.setBounds(mainVuToggleRow.removeFromLeft(56).reduced(0, 2));
     mainVuArcButton_.setBounds(mainVuToggleRow.removeFromLeft(56).reduced(0, 2));
-    auto mainViewRect = content.removeFromTop(mainViewH);
-    mainViewAsTube_.setBounds(mainViewRect);
-    mainVu_.setBounds(mainViewRect);
+    mainViewRect_ = content.removeFromTop(mainViewH);
+    if (mainViewAsTube_ != nullptr)
+        mainViewAsTube_->setBounds(mainViewRect_);
+    if (mainVu_ != nullptr)
+        mainVu_->setBounds(mainViewRect_);
 
     // Use parameter (not combo) for mode so layout is correct on load and when host resizes
     int modeIndex = 0;
@@ -322,9 +384,15 @@ void OmbicCompressorEditorV2::resized()
     };
     grid.performLayout(content);
 
-    // Sync main view visibility from param (so initial state is correct before first timer tick)
+    // Stage timing overlay floats top-right, just under the header
+    if (stageTimingOverlay_ != nullptr)
+    {
+        const auto overlaySize = StageTimingOverlay::getPreferredSize();
+        stageTimingOverlay_->setBounds(getWidth() - overlaySize.getWidth() - 12, kHeaderH + 6,
+                                       overlaySize.getWidth(), overlaySize.getHeight());
+    }
+
+    // Sync main view visibility from param (so initial state is correct before first scheduler tick)
     auto* mainVuParam = processorRef.getValueTreeState().getParameter(OmbicCompressorProcessor::paramMainVuDisplay);
-    bool isSimple = mainVuParam && mainVuParam->getValue() > 0.5f;
-    mainViewAsTube_.setVisible(!isSimple);
-    mainVu_.setVisible(isSimple);
+    showMainView(mainVuParam && mainVuParam->getValue() > 0.5f);
 }
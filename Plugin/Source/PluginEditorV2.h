@@ -9,10 +9,11 @@
 #include "Components/SidechainFilterSection.h"
 #include "Components/MainViewAsTubeComponent.h"
 #include "Components/MainVuComponent.h"
+#include "Components/StageTimingOverlay.h"
+#include "Components/RenderScheduler.h"
 
 /** v2 editor: main view is the tube (saturation-driven glow + filament) or Simple arc; Neon section is knobs only. All v1 features preserved. */
-class OmbicCompressorEditorV2 : public juce::AudioProcessorEditor,
-                                private juce::Timer
+class OmbicCompressorEditorV2 : public juce::AudioProcessorEditor
 {
 public:
     explicit OmbicCompressorEditorV2(OmbicCompressorProcessor&);
@@ -20,10 +21,15 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
+    /** Cmd/Ctrl+Shift+P toggles the stage timing overlay (profiling builds only). */
+    bool keyPressed(const juce::KeyPress& key) override;
 
 private:
-    void timerCallback() override;
+    /** Editor-level state (mode pills, layout, view visibility) on each scheduler tick, before the sections. */
+    void editorTick();
     void updateModeVisibility();
+    /** Show the Tube (false) or Arc (true) main view, constructing it on first use. */
+    void showMainView(bool isSimple);
 
     static constexpr int kBaseWidth = 960;
     static constexpr int kBaseHeight = 540;
@@ -48,8 +54,13 @@ private:
     CompressorSection compressorSection;
     SaturatorSection saturatorSection;
     OutputSection outputSection;
-    MainViewAsTubeComponent mainViewAsTube_;
-    MainVuComponent mainVu_;
+    // Built on first show: only the selected main view exists, the overlay only once toggled on
+    std::unique_ptr<MainViewAsTubeComponent> mainViewAsTube_;
+    std::unique_ptr<MainVuComponent> mainVu_;
+    std::unique_ptr<StageTimingOverlay> stageTimingOverlay_;
+    juce::Rectangle<int> mainViewRect_;
+    int stageTimingTicks_ = 0;   // overlay refreshes every kStageTimingEveryTicks scheduler ticks (~5 Hz)
+    static constexpr int kStageTimingEveryTicks = 9;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
@@ -65,6 +76,7 @@ private:
     std::unique_ptr<SliderAttachment> attackAttachment;
     std::unique_ptr<SliderAttachment> releaseAttachment;
     std::unique_ptr<SliderAttachment> speedAttachment;
+    std::unique_ptr<SliderAttachment> characterAttachment;
     std::unique_ptr<SliderAttachment> makeupAttachment;
     std::unique_ptr<SliderAttachment> ironAttachment;
     std::unique_ptr<ButtonAttachment> autoGainAttachment;
@@ -77,5 +89,7 @@ private:
     std::unique_ptr<ButtonAttachment> neonSaturationAfterAttachment;
     std::unique_ptr<ButtonAttachment> neonEnableAttachment;
 
+    RenderScheduler renderScheduler_;   // last: destroyed first, so it never ticks a destroyed section
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OmbicCompressorEditorV2)
 };
@@ -6,7 +6,9 @@
 #include "Emulation/DataLoader.h"
 #include "Emulation/MVPChain.h"
 #include "Emulation/PwmChain.h"
+#include "Emulation/CurveReloader.h"
 #include "Emulation/IronTransformer.h"
+#include "Emulation/BlockAnalysis.h"
 #if JUCE_MAC
 #include <dlfcn.h>
 #endif
@@ -39,6 +41,53 @@ juce::File getBundledCurveDataRoot()
 #endif
     return {};
 }
+
+float levelToDb(float level, float ceilingDb = 0.0f)
+{
+    return juce::jlimit(-60.0f, ceilingDb, level > 1e-6f ? 20.0f * std::log10(level) : -60.0f);
+}
+
+/** Block RMS over all channels, plus overall / L / R peak (dB) into peakDb[0..2] from one analyseAndMix pass.
+ *  peakCeilingDb > 0 lets true-peak overs through. */
+void publishLevels(const emulation::ChannelLevel* levels, int numChannels, int numSamples,
+                   std::atomic<float>& rmsDb, float* peakDb, float peakCeilingDb = 0.0f)
+{
+    float sumSq = 0.0f, peak = 0.0f;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        sumSq += levels[ch].sumSquares;
+        peak = juce::jmax(peak, levels[ch].peak);
+    }
+    rmsDb.store(levelToDb(std::sqrt(sumSq / static_cast<float>(numChannels * numSamples))));
+    peakDb[0] = levelToDb(peak, peakCeilingDb);
+    peakDb[1] = numChannels >= 1 ? levelToDb(levels[0].peak, peakCeilingDb) : -60.0f;
+    peakDb[2] = numChannels >= 2 ? levelToDb(levels[1].peak, peakCeilingDb) : -60.0f;
+}
+
+/** Replace sample peaks with true peaks (never lower: the interpolator can undershoot a lone sample). */
+void applyTruePeak(emulation::TruePeakDetector& detector, const juce::AudioBuffer<float>& buffer,
+                   emulation::ChannelLevel* levels, int numChannels)
+{
+    for (int ch = 0; ch < numChannels && ch < detector.getNumChannels(); ++ch)
+        levels[ch].peak = juce::jmax(levels[ch].peak,
+                                     detector.processChannel(ch, buffer.getReadPointer(ch), buffer.getNumSamples()));
+}
+
+/** State properties holding the selected curve profile and morph partner per MVPChain::Mode (FET, Opto, VCA). */
+const juce::Identifier curveProfileStateIds[] = { "curveProfileFET", "curveProfileOpto", "curveProfileVCA" };
+const juce::Identifier morphProfileStateIds[] = { "morphProfileFET", "morphProfileOpto", "morphProfileVCA" };
+
+/** Threshold at knob 0 % and 100 % in each engine's units, as processBlock converts it. */
+emulation::CurveMorph::ThresholdRange thresholdRange(emulation::MVPChain::Mode mode)
+{
+    switch (mode)
+    {
+        case emulation::MVPChain::Mode::FET: return { -60.0f, 0.0f };
+        case emulation::MVPChain::Mode::VCA: return { -1.0f, 3.0f };
+        case emulation::MVPChain::Mode::Opto: break;
+    }
+    return { 0.0f, 100.0f };
+}
 }
 
 //==============================================================================
@@ -64,6 +113,7 @@ const char* OmbicCompressorProcessor::paramPwmSpeed           = "pwm_speed";
 const char* OmbicCompressorProcessor::paramIron                = "iron";
 const char* OmbicCompressorProcessor::paramAutoGain            = "auto_gain";
 const char* OmbicCompressorProcessor::paramFetCharacter        = "fet_character";
+const char* OmbicCompressorProcessor::paramCharacter           = "character";
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout OmbicCompressorProcessor::createParameterLayout()
@@ -82,6 +132,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout OmbicCompressorProcessor::cr
         juce::StringArray{ "Off", "Rev A", "LN" },
         0));
 
+    // Character: 0 = the engine's own profile, 1 = its morph partner (e.g. FET -> VCA)
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ paramCharacter, 1 },
+        "Character",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+        0.0f));
+
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ paramThreshold, 1 },
         "Threshold",
@@ -212,7 +269,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout OmbicCompressorProcessor::cr
         0.0f,
         juce::AudioParameterFloatAttributes().withLabel("%")));
 
-    // Auto Gain: parameter-based auto-makeup (additive to manual Output)
+    // Auto Gain: loudness-matched makeup (input vs compressed short-term LUFS), additive to manual Output
     layout.add(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID{ paramAutoGain, 1 },
         "Auto Gain",
@@ -237,6 +294,9 @@ OmbicCompressorProcessor::OmbicCompressorProcessor()
 {
     inputRms.reset(0, 10);
     outputRms.reset(0, 10);
+    // Unity biquad; updateSidechainFilterCoeffs() rewrites it in place so the audio thread never allocates.
+    sidechainHpfCoeffs_ = new juce::dsp::IIR::Coefficients<float>(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+    sidechainHpf_.coefficients = sidechainHpfCoeffs_;
 }
 
 OmbicCompressorProcessor::~OmbicCompressorProcessor() = default;
@@ -246,57 +306,120 @@ void OmbicCompressorProcessor::updateSidechainFilterCoeffs(float frequencyHz)
 {
     if (sampleRateHz <= 0 || frequencyHz <= kScFilterOffHz)
         return;
-    sidechainHpfCoeffs_ = juce::dsp::IIR::Coefficients<float>::makeHighPass(
+    *sidechainHpfCoeffs_ = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
         sampleRateHz, frequencyHz, 0.7071f);  // Butterworth
-    if (sidechainHpfCoeffs_)
-        sidechainHpf_.coefficients = sidechainHpfCoeffs_;
 }
 
 void OmbicCompressorProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     sampleRateHz = sampleRate;
-    pwmChain_.reset();
-    iron_.reset();
+    maxBlockSize_ = juce::jmax(512, samplesPerBlock);
+    const int numChannels = juce::jmax(2, getTotalNumOutputChannels());
     inputRms.reset(sampleRate, 0.05);
     outputRms.reset(sampleRate, 0.05);
     smoothedScFrequency_.reset(sampleRate, 0.015);  // 15 ms ramp
     smoothedScFrequency_.setCurrentAndTargetValue(kScFilterOffHz);
     updateSidechainFilterCoeffs(100.0f);  // initial coeffs for when filter is used
-    sidechainMonoBuffer_.setSize(1, juce::jmax(512, samplesPerBlock));
-    sidechainStereoForListen_.setSize(2, juce::jmax(512, samplesPerBlock));
+    sidechainHpf_.reset();
+    sidechainMonoBuffer_.setSize(1, maxBlockSize_);
+    inputTruePeak_.prepare(maxBlockSize_, juce::jmin(numChannels, kMaxChannels));
+    outputTruePeak_.prepare(maxBlockSize_, juce::jmin(numChannels, kMaxChannels));
+    truePeakWasOn_ = false;
+    spectrumAnalyser_.setSampleRate(sampleRate);
+    inputLoudness_.prepare(sampleRate, juce::jmin(numChannels, kMaxChannels));
+    preMakeupLoudness_.prepare(sampleRate, juce::jmin(numChannels, kMaxChannels));
+    autoGainSmoothedDb_ = 0.0f;
+    autoGainDb.store(0.0f);
+
+    // Everything the audio thread touches is built here: curve data (file I/O), chains, Iron, standalone Neon.
+#if OMBIC_CURVE_HOT_RELOAD
+    curveReloader_.reset();
+#endif
+    morphWorker_.stop();
+    morphWorker_.clear();
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        if (std::abs(chainsSampleRate_ - sampleRate) > 0.5)
+        {
+            fetChain_.reset();
+            optoChain_.reset();
+            vcaChain_.reset();
+        }
+        ensureChains();
+        ensureMorphs();
+#if OMBIC_CURVE_HOT_RELOAD
+        startCurveReloader();
+#endif
+    }
+    chainsSampleRate_ = sampleRate;
+    for (const auto& morph : morphs_)
+        if (morph != nullptr)
+            morphWorker_.add(*morph, *apvts.getRawParameterValue(paramCharacter));
+    morphWorker_.start();
+    for (auto* chain : { fetChain_.get(), optoChain_.get(), vcaChain_.get() })
+    {
+        if (chain != nullptr)
+        {
+            chain->prepare(maxBlockSize_, numChannels);
+            chain->setStageProfiler(&stageProfiler_);
+        }
+    }
+
+    pwmChain_.reset();
+    ensurePwmChain();
+    pwmChain_->prepare(sampleRate, maxBlockSize_);
+    pwmChain_->setStageProfiler(&stageProfiler_);
+    iron_ = std::make_unique<emulation::IronTransformer>();
+    iron_->prepare(sampleRate);
+    standaloneNeon_ = std::make_unique<emulation::NeonTapeSaturation>(sampleRate);
+    scopeSidechain_.clear();
+    scopeWaveform_.clear();
 }
 
 void OmbicCompressorProcessor::releaseResources()
 {
-    fetChain_.reset();
-    optoChain_.reset();
+#if OMBIC_CURVE_HOT_RELOAD
+    curveReloader_.reset();
+#endif
+    morphWorker_.stop();
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        fetChain_.reset();
+        optoChain_.reset();
+        vcaChain_.reset();
+    }
+    chainsSampleRate_ = 0.0;
     pwmChain_.reset();
     iron_.reset();
     standaloneNeon_.reset();
 }
 
-bool OmbicCompressorProcessor::isScListenActive() const
+void OmbicCompressorProcessor::reset()
 {
-    auto* p = apvts.getParameter(paramScListen);
-    return p && p->getValue() > 0.5f;
-}
-
-bool OmbicCompressorProcessor::getScopeSidechainSamples(std::vector<float>& out) const
-{
-    const juce::ScopedLock sl(scopeSidechainLock_);
-    if (scopeSidechainBuffer_.empty())
-        return false;
-    out = scopeSidechainBuffer_;
-    return true;
+    inputRms.setCurrentAndTargetValue(0.0f);
+    outputRms.setCurrentAndTargetValue(0.0f);
+    smoothedScFrequency_.setCurrentAndTargetValue(kScFilterOffHz);
+    sidechainHpf_.reset();
+    inputTruePeak_.reset();
+    outputTruePeak_.reset();
+    inputLoudness_.reset();
+    preMakeupLoudness_.reset();
+    autoGainSmoothedDb_ = 0.0f;
+    autoGainDb.store(0.0f);
+    for (auto* chain : { fetChain_.get(), optoChain_.get(), vcaChain_.get() })
+        if (chain != nullptr)
+            chain->reset();
+    if (pwmChain_ != nullptr) pwmChain_->reset();
+    if (iron_ != nullptr) iron_->reset();
+    if (standaloneNeon_ != nullptr) standaloneNeon_->reset();
+    scopeSidechain_.clear();
+    scopeWaveform_.clear();
 }
 
-bool OmbicCompressorProcessor::getScopeWaveformSamples(std::vector<float>& out) const
+bool OmbicCompressorProcessor::isScListenActive() const
 {
-    const juce::ScopedLock sl(scopeWaveformLock_);
-    if (scopeWaveformBuffer_.empty())
-        return false;
-    out = scopeWaveformBuffer_;
-    return true;
+    auto* p = apvts.getParameter(paramScListen);
+    return p && p->getValue() > 0.5f;
 }
 
 juce::AudioProcessorEditor* OmbicCompressorProcessor::createEditor()
@@ -308,23 +431,17 @@ juce::AudioProcessorEditor* OmbicCompressorProcessor::createEditor()
 #endif
 }
 
-void OmbicCompressorProcessor::ensureChains()
+juce::Array<juce::File> OmbicCompressorProcessor::getCurveProfileRoots()
 {
-    juce::File fetishDir;
-    juce::File lalaDir;
-    juce::File vcaDir;
+    juce::Array<juce::File> roots;
 
     // 1) Bundled data (normal for shipped plugins: curve data lives inside the .vst3)
     juce::File curveDataRoot = getBundledCurveDataRoot();
     if (curveDataRoot.exists())
-    {
-        fetishDir = curveDataRoot.getChildFile("fetish_v2");
-        lalaDir = curveDataRoot.getChildFile("lala_v2");
-        vcaDir = curveDataRoot.getChildFile("dbcomp_vca");
-    }
+        roots.add(curveDataRoot);
 
     // 2) Project / env path (for development: output/fetish_v2, output/lala_v2, output/dbcomp_vca)
-    if (!fetishDir.getChildFile("compression_curve.csv").existsAsFile())
+    if (!curveDataRoot.getChildFile("fetish_v2/compression_curve.csv").existsAsFile())
     {
         juce::File root = dataRoot_;
         if (!root.exists() || !root.getChildFile("output/fetish_v2/compression_curve.csv").existsAsFile())
@@ -340,31 +457,261 @@ void OmbicCompressorProcessor::ensureChains()
                 root = root.getParentDirectory();
             dataRoot_ = root;
         }
-        fetishDir = root.getChildFile("output/fetish_v2");
-        lalaDir = root.getChildFile("output/lala_v2");
-        vcaDir = root.getChildFile("output/dbcomp_vca");
-    }
-    bool fetOk = fetishDir.getChildFile("compression_curve.csv").existsAsFile();
-    bool lalaOk = lalaDir.getChildFile("compression_curve.csv").existsAsFile();
-    bool vcaOk = vcaDir.getChildFile("compression_curve.csv").existsAsFile();
-    std::optional<float> noFrDrive;
-    if (fetOk && !fetChain_)
-        fetChain_ = std::make_unique<emulation::MVPChain>(
-            emulation::MVPChain::Mode::FET, sampleRateHz,
-            fetishDir, lalaDir, vcaDir, false, false, noFrDrive, 1.0f,
-            true, false, 0.02f, 1000.0f, 0.0f, 0.92f, 1.0f, false);
-    if (lalaOk && !optoChain_)
-        optoChain_ = std::make_unique<emulation::MVPChain>(
-            emulation::MVPChain::Mode::Opto, sampleRateHz,
-            fetishDir, lalaDir, vcaDir, false, false, noFrDrive, 1.0f,
-            true, false, 0.02f, 1000.0f, 0.0f, 0.92f, 1.0f, false);
-    if (vcaOk && !vcaChain_)
-        vcaChain_ = std::make_unique<emulation::MVPChain>(
-            emulation::MVPChain::Mode::VCA, sampleRateHz,
-            fetishDir, lalaDir, vcaDir, false, false, noFrDrive, 1.0f,
-            true, false, 0.02f, 1000.0f, 0.0f, 0.92f, 1.0f, false);
+        roots.add(root.getChildFile("output"));
+    }
+
+    // 3) Further captured units installed by the user
+    roots.add(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Ombic/CurveProfiles"));
+    return roots;
+}
+
+const emulation::CurveProfile* OmbicCompressorProcessor::findCurveProfile(const juce::String& profileId) const
+{
+    for (const auto& p : curveProfiles_)
+        if (p.id == profileId)
+            return &p;
+    return nullptr;
+}
+
+const emulation::CurveProfile* OmbicCompressorProcessor::findProfileForMode(emulation::MVPChain::Mode mode) const
+{
+    static const char* const defaultIds[] = { "fetish_v2", "lala_v2", "dbcomp_vca" };   // by MVPChain::Mode
+    const auto m = static_cast<size_t>(mode);
+    for (const auto& id : { selectedProfileIds_[m], juce::String(defaultIds[m]) })
+        if (const auto* p = findCurveProfile(id); p != nullptr && p->mode == mode)
+            return p;
+    for (const auto& p : curveProfiles_)
+        if (p.mode == mode)
+            return &p;
+    return nullptr;
+}
+
+std::unique_ptr<emulation::MVPChain>& OmbicCompressorProcessor::getChain(emulation::MVPChain::Mode mode)
+{
+    using Mode = emulation::MVPChain::Mode;
+    return (mode == Mode::VCA) ? vcaChain_ : ((mode == Mode::FET) ? fetChain_ : optoChain_);
+}
+
+void OmbicCompressorProcessor::ensureChains()
+{
+    using Mode = emulation::MVPChain::Mode;
+    const auto roots = getCurveProfileRoots();
+    curveProfiles_ = emulation::discoverCurveProfiles(roots);
+    if (const auto pwmDir = emulation::findPwmCurveData(roots); pwmDir != juce::File())
+    {
+        auto tables = curveStore_->acquire({ pwmDir.getFileName(), pwmDir.getFileName(), pwmDir });
+        if (tables != pwmTransferTables_)
+        {
+            pwmTransferTables_ = std::move(tables);
+            ++curveProfileSerial_;   // redraw the PWM transfer curve
+        }
+    }
+    for (const auto mode : { Mode::FET, Mode::Opto, Mode::VCA })
+    {
+        auto& chain = getChain(mode);
+        if (chain) continue;
+        const auto* profile = findProfileForMode(mode);
+        if (profile == nullptr) continue;
+        auto tables = curveStore_->acquire(*profile);   // shared with other instances playing the same profile
+        if (tables == nullptr) continue;
+        activeProfiles_[static_cast<size_t>(mode)] = *profile;
+        chain = std::make_unique<emulation::MVPChain>(mode, sampleRateHz, std::move(tables),
+                                                      true, false, 0.02f, 1000.0f, 0.0f, 0.92f, 1.0f, false);
+    }
     if (fetChain_ || optoChain_ || vcaChain_)
         curveDataLoaded_.store(true);
+    ++profileSelectionSerial_;   // list rediscovered, engines may play other profiles
+}
+
+#if OMBIC_CURVE_HOT_RELOAD
+void OmbicCompressorProcessor::startCurveReloader()
+{
+    // Developer mode: rebuild the compressor tables whenever the active captures or the Character partners change
+    using Mode = emulation::MVPChain::Mode;
+    curveReloader_ = std::make_unique<emulation::CurveReloader>(chainsLock_, *curveStore_,
+        [this](const juce::File& dataDir, emulation::CurveStore::TablesPtr tables) { applyReloadedTables(dataDir, std::move(tables)); });
+    for (const auto mode : { Mode::FET, Mode::Opto, Mode::VCA })
+    {
+        const auto m = static_cast<size_t>(mode);
+        if (auto& chain = getChain(mode); chain && chain->getCompressor() != nullptr)
+        {
+            curveReloader_->watch(activeProfiles_[m].directory);
+            curveReloader_->reclaimFor(*chain->getCompressor());
+            if (morphs_[m] != nullptr && morphPartnerTables_[m] != nullptr)
+                curveReloader_->watch(morphPartners_[m].directory);
+        }
+    }
+    curveReloader_->start();
+}
+
+void OmbicCompressorProcessor::applyReloadedTables(const juce::File& dataDir, emulation::CurveStore::TablesPtr tables)
+{
+    using Mode = emulation::MVPChain::Mode;
+    for (const auto mode : { Mode::FET, Mode::Opto, Mode::VCA })
+    {
+        const auto m = static_cast<size_t>(mode);
+        auto& chain = getChain(mode);
+        if (!chain || chain->getCompressor() == nullptr)
+            continue;
+        const bool own = activeProfiles_[m].directory == dataDir;
+        const bool hasMorph = morphs_[m] != nullptr && morphPartnerTables_[m] != nullptr;
+        const bool partner = hasMorph && morphPartners_[m].directory == dataDir;
+        if (partner)
+            morphPartnerTables_[m] = tables;
+        if (hasMorph && (own || partner))
+        {
+            // As selectCurveProfile: the Character blend is built from the sources, so it has to follow them
+            const auto ownTables = own ? tables : curveStore_->acquire(activeProfiles_[m]);
+            if (ownTables != nullptr)
+                morphs_[m]->setSources(*ownTables, *morphPartnerTables_[m], thresholdRange(morphPartners_[m].mode));
+        }
+        if (own)
+            chain->getCompressor()->publishTables(tables);   // the audio thread crossfades over
+    }
+}
+#endif
+
+std::vector<emulation::CurveProfile> OmbicCompressorProcessor::getCurveProfiles() const
+{
+    const juce::ScopedLock sl(chainsLock_);
+    return curveProfiles_;
+}
+
+juce::String OmbicCompressorProcessor::getActiveCurveProfile(emulation::MVPChain::Mode mode) const
+{
+    const juce::ScopedLock sl(chainsLock_);
+    const auto m = static_cast<size_t>(mode);
+    return selectedProfileIds_[m].isNotEmpty() ? selectedProfileIds_[m] : activeProfiles_[m].id;
+}
+
+bool OmbicCompressorProcessor::selectCurveProfile(const juce::String& profileId)
+{
+    emulation::CurveProfile profile;
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        const auto* p = findCurveProfile(profileId);
+        if (p == nullptr)
+            return false;
+        profile = *p;
+    }
+    // Load outside chainsLock_ so the transfer-curve thread is not held up by file I/O
+    auto tables = curveStore_->acquire(profile);
+    if (tables == nullptr)
+        return false;
+
+#if OMBIC_CURVE_HOT_RELOAD
+    curveReloader_.reset();   // before chainsLock_: its thread takes that lock
+#endif
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        const auto m = static_cast<size_t>(profile.mode);
+        selectedProfileIds_[m] = profile.id;
+        ++profileSelectionSerial_;
+        if (auto& chain = getChain(profile.mode); chain && chain->getCompressor() != nullptr)
+        {
+            activeProfiles_[m] = profile;
+            if (morphs_[m] != nullptr && morphPartnerTables_[m] != nullptr)
+                morphs_[m]->setSources(*tables, *morphPartnerTables_[m], thresholdRange(morphPartners_[m].mode));
+            chain->getCompressor()->releaseRetiredTables();
+            chain->getCompressor()->publishTables(std::move(tables));   // the audio thread crossfades over
+        }
+#if OMBIC_CURVE_HOT_RELOAD
+        startCurveReloader();
+#endif
+    }
+    startTimer(kTableReclaimIntervalMs);
+    return true;
+}
+
+void OmbicCompressorProcessor::timerCallback()
+{
+    bool swapped = false, pending = false;
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        for (auto* chain : { fetChain_.get(), optoChain_.get(), vcaChain_.get() })
+            if (chain != nullptr && chain->getCompressor() != nullptr)
+            {
+                swapped = chain->getCompressor()->releaseRetiredTables() || swapped;
+                pending = chain->getCompressor()->isSwapPending() || pending;
+            }
+    }
+    if (swapped)
+    {
+        ++curveProfileSerial_;   // the transfer curve now reads the new profile
+        curveStore_->trim();
+    }
+    if (!pending)
+        stopTimer();   // every switch reclaimed; selectCurveProfile starts it again
+}
+
+void OmbicCompressorProcessor::ensureMorphs()
+{
+    using Mode = emulation::MVPChain::Mode;
+    static const char* const defaultPartnerIds[] = { "dbcomp_vca", "", "fetish_v2" };   // by MVPChain::Mode
+    for (const auto mode : { Mode::FET, Mode::Opto, Mode::VCA })
+    {
+        const auto m = static_cast<size_t>(mode);
+        auto& chain = getChain(mode);
+        if (!chain || chain->getCompressor() == nullptr)
+            continue;
+        const auto* partner = findCurveProfile(morphProfileIds_[m].isNotEmpty() ? morphProfileIds_[m] : juce::String(defaultPartnerIds[m]));
+        auto own = curveStore_->acquire(activeProfiles_[m]);
+        morphPartnerTables_[m] = (partner != nullptr && partner->id != activeProfiles_[m].id) ? curveStore_->acquire(*partner) : nullptr;
+        if (own == nullptr || morphPartnerTables_[m] == nullptr)
+        {
+            chain->getCompressor()->setCurveMorph(nullptr);
+            continue;
+        }
+        morphPartners_[m] = *partner;
+        if (morphs_[m] == nullptr)
+            morphs_[m] = std::make_unique<emulation::CurveMorph>(thresholdRange(mode));
+        morphs_[m]->setSources(*own, *morphPartnerTables_[m], thresholdRange(partner->mode));
+        chain->getCompressor()->setCurveMorph(morphs_[m].get());
+    }
+    ++profileSelectionSerial_;   // partners resolved
+}
+
+bool OmbicCompressorProcessor::selectMorphProfile(emulation::MVPChain::Mode mode, const juce::String& profileId)
+{
+    emulation::CurveProfile partner, own;
+    const auto m = static_cast<size_t>(mode);
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        const auto* p = findCurveProfile(profileId);
+        if (p == nullptr)
+            return false;
+        partner = *p;
+        own = activeProfiles_[m];
+    }
+    auto partnerTables = curveStore_->acquire(partner);
+    auto ownTables = own.directory != juce::File() ? curveStore_->acquire(own) : nullptr;
+    if (partnerTables == nullptr)
+        return false;
+
+#if OMBIC_CURVE_HOT_RELOAD
+    curveReloader_.reset();   // before chainsLock_: its thread takes that lock
+#endif
+    const juce::ScopedLock sl(chainsLock_);
+    morphProfileIds_[m] = partner.id;
+    ++profileSelectionSerial_;
+    if (morphs_[m] != nullptr && ownTables != nullptr)
+    {
+        // The worker reblends from the new sources on its next poll
+        morphPartners_[m] = partner;
+        morphPartnerTables_[m] = partnerTables;
+        morphs_[m]->setSources(*ownTables, *partnerTables, thresholdRange(partner.mode));
+    }
+#if OMBIC_CURVE_HOT_RELOAD
+    startCurveReloader();   // watch the new partner
+#endif
+    return true;
+}
+
+juce::String OmbicCompressorProcessor::getMorphProfile(emulation::MVPChain::Mode mode) const
+{
+    const juce::ScopedLock sl(chainsLock_);
+    const auto m = static_cast<size_t>(mode);
+    return morphProfileIds_[m].isNotEmpty() ? morphProfileIds_[m] : morphPartners_[m].id;
 }
 
 void OmbicCompressorProcessor::ensurePwmChain()
@@ -374,15 +721,102 @@ void OmbicCompressorProcessor::ensurePwmChain()
         sampleRateHz, true, true, 0.02f, 1000.0f, 0.0f, 0.92f, 1.0f, false);
 }
 
-float OmbicCompressorProcessor::estimateMakeupDb(int mode, float thresholdRaw, float ratio,
-                                                 float attackParam, float releaseParam, float speedParam) const
+OmbicCompressorProcessor::TransferCurveSettings OmbicCompressorProcessor::getTransferCurveSettings() const
+{
+    TransferCurveSettings s;
+    s.mode = juce::jlimit(0, 3, static_cast<int>(apvts.getRawParameterValue(paramCompressorMode)->load() * 3.0f + 0.5f));
+    s.thresholdPercent = apvts.getParameterRange(paramThreshold).convertFrom0to1(apvts.getRawParameterValue(paramThreshold)->load());
+    s.ratio = apvts.getParameterRange(paramRatio).convertFrom0to1(apvts.getRawParameterValue(paramRatio)->load());
+    s.fetCharacter = juce::jlimit(0, 2, static_cast<int>(apvts.getRawParameterValue(paramFetCharacter)->load() * 2.0f + 0.5f));
+    s.curveDataLoaded = hasCurveDataLoaded();
+    s.curveProfileSerial = curveProfileSerial_.load();
+    s.character = apvts.getRawParameterValue(paramCharacter)->load();
+    return s;
+}
+
+bool OmbicCompressorProcessor::computeTransferCurve(const TransferCurveSettings& settings, const float* inputDb,
+                                                    float* outputDb, int numPoints) const
+{
+    if (settings.mode == 2) // PWM: measured curves (threshold in knob %) if installed, else the analytic soft knee
+    {
+        const float ratio = juce::jlimit(1.5f, 8.0f, settings.ratio);
+        {
+            const juce::ScopedLock sl(chainsLock_);
+            if (pwmTransferTables_ != nullptr)
+            {
+                emulation::CurveLattice::Slice slice;
+                pwmTransferTables_->curves.getSlice({ settings.thresholdPercent, ratio, 0.0f, 0.0f }, slice);
+                slice.evaluate(inputDb, outputDb, numPoints);
+                juce::FloatVectorOperations::subtract(outputDb, inputDb, outputDb, numPoints);
+                return true;
+            }
+        }
+        const float thresholdDb = emulation::PwmCompressor::thresholdPercentToDb(settings.thresholdPercent);
+        for (int i = 0; i < numPoints; ++i)
+            outputDb[i] = inputDb[i] - emulation::PwmCompressor::gainComputerDb(inputDb[i], thresholdDb, ratio);
+        return true;
+    }
+
+    // Same threshold units and optional arguments as processBlock passes to MVPChain::process
+    float threshold = settings.thresholdPercent;
+    std::optional<float> ratio;
+    std::optional<int> fetCharacter;
+    if (settings.mode == 1)
+    {
+        threshold = -60.0f + (settings.thresholdPercent / 100.0f) * 60.0f;
+        ratio = settings.ratio;
+        fetCharacter = settings.fetCharacter;
+    }
+    else if (settings.mode == 3)
+    {
+        threshold = -1.0f + (settings.thresholdPercent / 100.0f) * 4.0f;
+        ratio = settings.ratio;
+    }
+
+    const juce::ScopedLock sl(chainsLock_);
+    const emulation::MVPChain* chain = (settings.mode == 3) ? vcaChain_.get() : ((settings.mode == 1) ? fetChain_.get() : optoChain_.get());
+    const emulation::MeasuredCompressor* compressor = chain != nullptr ? chain->getCompressor() : nullptr;
+    if (compressor == nullptr)
+        return false;
+    const auto mode = (settings.mode == 3) ? emulation::MVPChain::Mode::VCA
+                    : ((settings.mode == 1) ? emulation::MVPChain::Mode::FET : emulation::MVPChain::Mode::Opto);
+    const auto& partnerTables = morphPartnerTables_[static_cast<size_t>(mode)];
+    if (settings.character > 0.0f && partnerTables != nullptr && compressor->hasCurveMorph())
+    {
+        // Character: blend with the partner read at the same knob position, then the FET character, like the audio path
+        compressor->staticGainReductionDb(threshold, inputDb, outputDb, numPoints, ratio);
+        const auto own = thresholdRange(mode);
+        const auto other = thresholdRange(morphPartners_[static_cast<size_t>(mode)].mode);
+        const float knob = (threshold - own.atMin) / (own.atMax - own.atMin);
+        emulation::CurveLattice::Slice slice;
+        partnerTables->curves.getSlice({ other.atMin + knob * (other.atMax - other.atMin), ratio.value_or(0.0f), 0.0f, 0.0f }, slice);
+        std::vector<float> partnerGrDb(static_cast<size_t>(numPoints));
+        slice.evaluate(inputDb, partnerGrDb.data(), numPoints);
+        for (int i = 0; i < numPoints; ++i)
+        {
+            float grDb = outputDb[i] + settings.character * (partnerGrDb[static_cast<size_t>(i)] - outputDb[i]);
+            if (fetCharacter.has_value())
+                grDb = emulation::MeasuredCompressor::applyFetCharacter(grDb, inputDb[i] - threshold, *fetCharacter);
+            outputDb[i] = grDb;
+        }
+    }
+    else
+        compressor->staticGainReductionDb(threshold, inputDb, outputDb, numPoints, ratio, fetCharacter);
+    juce::FloatVectorOperations::subtract(outputDb, inputDb, outputDb, numPoints);
+    return true;
+}
+
+void OmbicCompressorProcessor::updateAutoGain(int numSamples)
 {
-    float thresholdDb = -60.0f + (thresholdRaw / 100.0f) * 60.0f;
-    float peakDb = -6.0f;
-    if (peakDb <= thresholdDb) return 0.0f;
-    float over = peakDb - thresholdDb;
-    float grDb = over * (1.0f - 1.0f / juce::jmax(1.5f, ratio));
-    return juce::jlimit(0.0f, 12.0f, grDb);
+    const float inLufs = inputLoudness_.getGatedShortTermLufs();
+    const float outLufs = preMakeupLoudness_.getGatedShortTermLufs();
+    // Hold while either side is below the gate (silence, or the compressor fully closed): no meaningful difference.
+    if (inLufs <= emulation::LoudnessMeter::kFloorLufs || outLufs <= emulation::LoudnessMeter::kFloorLufs)
+        return;
+    const float targetDb = juce::jlimit(-kAutoGainRangeDb, kAutoGainRangeDb, inLufs - outLufs);
+    const float coeff = 1.0f - std::exp(-static_cast<float>(numSamples) / (kAutoGainTimeConstantS * static_cast<float>(sampleRateHz)));
+    autoGainSmoothedDb_ += coeff * (targetDb - autoGainSmoothedDb_);
+    autoGainDb.store(autoGainSmoothedDb_);
 }
 
 void OmbicCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
@@ -393,69 +827,89 @@ void OmbicCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    // Input level: peak (max abs) + RMS (average) + stereo L/R peak
-    float sumSq = 0.0f;
-    float peak = 0.0f;
-    float peakL = 0.0f, peakR = 0.0f;
-    for (int ch = 0; ch < numChannels; ++ch)
+    // Hosts may exceed the block size announced in prepareToPlay; split so scratch buffers never need to grow.
+    // The sub-buffer refers to the host's channel pointers (no allocation for <= 32 channels).
+    for (int start = 0; start < numSamples; start += maxBlockSize_)
     {
-        for (int i = 0; i < numSamples; ++i)
+        juce::AudioBuffer<float> sub(buffer.getArrayOfWritePointers(), numChannels, start,
+                                     juce::jmin(maxBlockSize_, numSamples - start));
+#if OMBIC_STAGE_PROFILING
+        stageTicks_ = {};
         {
-            float s = std::abs(buffer.getSample(ch, i));
-            sumSq += buffer.getSample(ch, i) * buffer.getSample(ch, i);
-            if (s > peak) peak = s;
-            if (ch == 0 && s > peakL) peakL = s;
-            if (ch == 1 && s > peakR) peakR = s;
+            OMBIC_STAGE_SCOPE(stageTicks_, Total);
+            processSubBlock(sub);
         }
+        stageProfiler_.commit(stageTicks_, sub.getNumSamples());
+#else
+        processSubBlock(sub);
+#endif
     }
-    float rms = std::sqrt(sumSq / (numChannels * numSamples));
-    float inRmsDb = rms > 1e-6f ? 20.0f * std::log10(rms) : -60.0f;
-    float inPeakDb = peak > 1e-6f ? 20.0f * std::log10(peak) : -60.0f;
-    inputLevelDb.store(juce::jlimit(-60.0f, 0.0f, inRmsDb));
-    inputPeakDb.store(juce::jlimit(-60.0f, 0.0f, inPeakDb));
-    inputPeakDbL.store(numChannels >= 1 ? juce::jlimit(-60.0f, 0.0f, peakL > 1e-6f ? 20.0f * std::log10(peakL) : -60.0f) : -60.0f);
-    inputPeakDbR.store(numChannels >= 2 ? juce::jlimit(-60.0f, 0.0f, peakR > 1e-6f ? 20.0f * std::log10(peakR) : -60.0f) : -60.0f);
+}
 
-    ensureChains();
+void OmbicCompressorProcessor::processSubBlock(juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    // Input level (peak, RMS, L/R peak) and the sidechain mono sum in one pass over the input
+    std::array<emulation::ChannelLevel, kMaxChannels> levels;
+    const int numAnalysed = juce::jmin(numChannels, kMaxChannels);
+    const bool truePeak = truePeakMetering_.load(std::memory_order_relaxed);
+    if (truePeak && !truePeakWasOn_)
+    {
+        inputTruePeak_.reset();
+        outputTruePeak_.reset();
+    }
+    truePeakWasOn_ = truePeak;
+    const float peakCeilingDb = truePeak ? kTruePeakCeilingDb : 0.0f;
+    // This block's peaks and GR; pushed to the meter bus once at the end
+    auto meters = emulation::MeterBus::silentFrame();
+    const bool spectrum = spectrumAnalyser_.isActive();
+    {
+        OMBIC_STAGE_SCOPE(stageTicks_, Metering);
+        emulation::analyseAndMix(buffer.getArrayOfReadPointers(), numAnalysed, numSamples, levels.data(),
+                                 sidechainMonoBuffer_.getWritePointer(0));
+        if (spectrum)
+            spectrumAnalyser_.push(emulation::SpectrumAnalyser::Input, sidechainMonoBuffer_.getReadPointer(0), numSamples);
+        if (truePeak)
+            applyTruePeak(inputTruePeak_, buffer, levels.data(), numAnalysed);
+        publishLevels(levels.data(), numAnalysed, numSamples, inputLevelDb, meters.data() + emulation::MeterBus::InputPeak, peakCeilingDb);
+        inputLoudness_.process(buffer);
+        inputMomentaryLufs.store(inputLoudness_.getMomentaryLufs());
+        inputShortTermLufs.store(inputLoudness_.getShortTermLufs());
+    }
 
     // Fail visibly: without curve data the plugin does not process. True bypass so host gets unchanged audio.
     if (!curveDataLoaded_.load())
     {
-        gainReductionDb.store(0.0f);
         outputLevelDb.store(inputLevelDb.load());
-        outputPeakDb.store(inputPeakDb.load());
-        outputPeakDbL.store(inputPeakDbL.load());
-        outputPeakDbR.store(inputPeakDbR.load());
+        std::copy_n(meters.data() + emulation::MeterBus::InputPeak, 3, meters.data() + emulation::MeterBus::OutputPeak);
+        meterBus_.push(meters, numSamples);
+        if (spectrum)
+            spectrumAnalyser_.push(emulation::SpectrumAnalyser::Output, sidechainMonoBuffer_.getReadPointer(0), numSamples);
+        outputMomentaryLufs.store(inputMomentaryLufs.load());
+        outputShortTermLufs.store(inputShortTermLufs.load());
         return;
     }
 
-    // Sidechain filter: mono sum of input, optional HPF (bypass at 20 Hz)
+    // Sidechain filter: optional HPF on the mono sum (bypass at 20 Hz)
     // All getRawParameterValue() return normalized 0..1; convert to actual range for processing.
     const float scFreqParam = apvts.getParameterRange(paramScFrequency).convertFrom0to1(apvts.getRawParameterValue(paramScFrequency)->load());
     const bool scListen = apvts.getRawParameterValue(paramScListen)->load() > 0.5f;
     smoothedScFrequency_.setTargetValue(scFreqParam);
-    if (sidechainMonoBuffer_.getNumSamples() < numSamples)
-    {
-        sidechainMonoBuffer_.setSize(1, numSamples);
-        sidechainStereoForListen_.setSize(2, numSamples);
-    }
-    float* mono = sidechainMonoBuffer_.getWritePointer(0);
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float sum = 0.0f;
-        for (int ch = 0; ch < numChannels; ++ch)
-            sum += buffer.getSample(ch, i);
-        mono[i] = sum / static_cast<float>(numChannels);
-    }
     float currentScFreq = smoothedScFrequency_.getNextValue();
-    if (currentScFreq > kScFilterOffHz)
     {
-        updateSidechainFilterCoeffs(currentScFreq);
-        for (int i = 0; i < numSamples; ++i)
-            mono[i] = sidechainHpf_.processSample(mono[i]);
+        OMBIC_STAGE_SCOPE(stageTicks_, Sidechain);
+        if (currentScFreq > kScFilterOffHz)
+        {
+            updateSidechainFilterCoeffs(currentScFreq);
+            float* mono = sidechainMonoBuffer_.getWritePointer(0);
+            for (int i = 0; i < numSamples; ++i)
+                mono[i] = sidechainHpf_.processSample(mono[i]);
+        }
+        if (spectrum)
+            spectrumAnalyser_.push(emulation::SpectrumAnalyser::Sidechain, sidechainMonoBuffer_.getReadPointer(0), numSamples);
     }
-    for (int ch = 0; ch < 2; ++ch)
-        sidechainStereoForListen_.copyFrom(ch, 0, sidechainMonoBuffer_, 0, 0, numSamples);
 
     const bool neonOn = apvts.getRawParameterValue(paramNeonEnable)->load() > 0.5f;
     // Choice param is normalized 0..1 for 4 options (Opto/FET/PWM/VCA) → index 0,1,2,3
@@ -501,14 +955,9 @@ void OmbicCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     }
     // Opto: threshold stays 0..100. PWM: handled below.
 
-    if (mode == 2) // PWM
+    if (mode == 2 && pwmChain_ != nullptr) // PWM
     {
-        ensurePwmChain();
-        float speedNorm = juce::jlimit(0.0f, 100.0f, speedParam) / 100.0f;
-        float attackMs = 80.0f * std::pow(0.0125f, speedNorm);
-        float releaseMs = 800.0f * std::pow(0.0375f, speedNorm);
-        attackMs = juce::jlimit(0.5f, 80.0f, attackMs);
-        releaseMs = juce::jlimit(30.0f, 800.0f, releaseMs);
+        const auto [attackMs, releaseMs] = emulation::PwmCompressor::speedToTimesMs(speedParam);
         float pwmRatio = juce::jlimit(1.5f, 8.0f, ratio);
         pwmChain_->setNeonEnabled(neonOn);
         pwmChain_->setNeonBeforeCompressor(true);
@@ -523,7 +972,7 @@ void OmbicCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
             neonSatAfter);
         const juce::AudioBuffer<float>* detectorBuffer = (currentScFreq > kScFilterOffHz) ? &sidechainMonoBuffer_ : nullptr;
         pwmChain_->process(buffer, thresholdRaw, pwmRatio, attackMs, releaseMs, detectorBuffer);
-        gainReductionDb.store(pwmChain_->getLastGainReductionDb());
+        meters[emulation::MeterBus::GainReduction] = pwmChain_->getLastGainReductionDb();
     }
     else
     {
@@ -545,15 +994,12 @@ void OmbicCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
             const juce::AudioBuffer<float>* detectorBuffer = (currentScFreq > kScFilterOffHz) ? &sidechainMonoBuffer_ : nullptr;
             std::optional<int> fetCharOpt = (mode == 1) ? std::optional<int>(fetCharacterIndex) : std::nullopt;
             chain->process(buffer, threshold, ratioOpt, attackOpt, releaseOpt, 512, optoLimitMode, detectorBuffer, fetCharOpt);
-            gainReductionDb.store(chain->getLastGainReductionDb());
+            meters[emulation::MeterBus::GainReduction] = chain->getLastGainReductionDb();
         }
         else
         {
-            gainReductionDb.store(0.0f);
-            if (neonOn)
+            if (neonOn && standaloneNeon_ != nullptr)
             {
-                if (!standaloneNeon_)
-                    standaloneNeon_ = std::make_unique<emulation::NeonTapeSaturation>(sampleRateHz);
                 standaloneNeon_->setDepth(neonDrive * 1.0f);
                 standaloneNeon_->setModulationBandwidthHz(200.0f + neonTone * 4800.0f);
                 standaloneNeon_->setToneFilterCutoffHz(400.0f + neonTone * 11600.0f);
@@ -562,98 +1008,95 @@ void OmbicCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
                 standaloneNeon_->setDryWet(neonMix);
                 standaloneNeon_->setSaturationIntensity(neonIntensity);
                 standaloneNeon_->setSaturationAfter(neonSatAfter);
+                OMBIC_STAGE_SCOPE(stageTicks_, Neon);
                 standaloneNeon_->process(buffer);
             }
-            else
-                standaloneNeon_.reset();
         }
     }
 
     // Output: Listen replaces with sidechain at unity; otherwise apply makeup.
     if (scListen)
     {
-        for (int ch = 0; ch < numChannels && ch < 2; ++ch)
-            buffer.copyFrom(ch, 0, sidechainStereoForListen_, ch, 0, numSamples);
-        // Copy sidechain for Neon scope (thread-safe for UI)
         {
-            const juce::ScopedLock sl(scopeSidechainLock_);
-            scopeSidechainBuffer_.resize(static_cast<size_t>(numSamples));
-            const float* readPtr = sidechainMonoBuffer_.getReadPointer(0);
-            for (int i = 0; i < numSamples; ++i)
-                scopeSidechainBuffer_[static_cast<size_t>(i)] = readPtr[i];
+            OMBIC_STAGE_SCOPE(stageTicks_, Sidechain);
+            for (int ch = 0; ch < numChannels && ch < 2; ++ch)
+                buffer.copyFrom(ch, 0, sidechainMonoBuffer_, 0, 0, numSamples);
         }
-        { const juce::ScopedLock wfSl(scopeWaveformLock_); scopeWaveformBuffer_.clear(); }
+        OMBIC_STAGE_SCOPE(stageTicks_, Metering);
+        // Sidechain for the Neon scope, reduced to min/max columns (skipped if the UI is reading)
+        scopeSidechain_.capture(sidechainMonoBuffer_.getReadPointer(0), numSamples);
+        if (spectrum)
+            spectrumAnalyser_.push(emulation::SpectrumAnalyser::Output, sidechainMonoBuffer_.getReadPointer(0), numSamples);
+        scopeWaveform_.clear();
+        emulation::analyseAndMix(buffer.getArrayOfReadPointers(), numAnalysed, numSamples, levels.data(), nullptr);
+        // Listen output is unity and Auto Gain holds; the meter restarts when Listen ends so it forgets the sidechain
+        preMakeupLoudness_.process(buffer);
+        listenWasOn_ = true;
+        outputMomentaryLufs.store(preMakeupLoudness_.getMomentaryLufs());
+        outputShortTermLufs.store(preMakeupLoudness_.getShortTermLufs());
+        if (truePeak)
+            applyTruePeak(outputTruePeak_, buffer, levels.data(), numAnalysed);
+        publishLevels(levels.data(), numAnalysed, numSamples, outputLevelDb, meters.data() + emulation::MeterBus::OutputPeak, peakCeilingDb);
+        meterBus_.push(meters, numSamples);
     }
     else
     {
+        scopeSidechain_.clear();
+        if (ironAmount > 0.001f && iron_ != nullptr)
         {
-            const juce::ScopedLock sl(scopeSidechainLock_);
-            scopeSidechainBuffer_.clear();
-        }
-        if (ironAmount > 0.001f)
-        {
-            if (!iron_)
-            {
-                iron_ = std::make_unique<emulation::IronTransformer>();
-                iron_->prepare(sampleRateHz);
-            }
+            OMBIC_STAGE_SCOPE(stageTicks_, Iron);
             iron_->process(buffer, mode, ironAmount);
         }
-        float makeupTotal = makeupDb;
-        if (autoGain)
-            makeupTotal += estimateMakeupDb(mode, thresholdRaw, ratio, attackParam, releaseParam, speedParam);
-        makeupTotal = juce::jlimit(-24.0f, 24.0f, makeupTotal);
-        float makeupGain = std::pow(10.0f, makeupTotal / 20.0f);
-        buffer.applyGain(makeupGain);
-        // Copy main output (mono) for Neon tube scope so it can follow the waveform
-        const juce::ScopedLock wfSl(scopeWaveformLock_);
-        scopeWaveformBuffer_.resize(static_cast<size_t>(numSamples));
-        if (numChannels >= 1)
         {
-            const float* L = buffer.getReadPointer(0);
-            if (numChannels >= 2)
-            {
-                const float* R = buffer.getReadPointer(1);
-                for (int i = 0; i < numSamples; ++i)
-                    scopeWaveformBuffer_[static_cast<size_t>(i)] = 0.5f * (L[i] + R[i]);
-            }
-            else
+            OMBIC_STAGE_SCOPE(stageTicks_, Makeup);
+            if (listenWasOn_)
             {
-                for (int i = 0; i < numSamples; ++i)
-                    scopeWaveformBuffer_[static_cast<size_t>(i)] = L[i];
+                preMakeupLoudness_.reset();
+                listenWasOn_ = false;
             }
+            preMakeupLoudness_.process(buffer);
+            updateAutoGain(numSamples);
+            float makeupTotal = makeupDb;
+            if (autoGain)
+                makeupTotal += autoGainSmoothedDb_;
+            makeupTotal = juce::jlimit(-24.0f, 24.0f, makeupTotal);
+            float makeupGain = std::pow(10.0f, makeupTotal / 20.0f);
+            buffer.applyGain(makeupGain);
+            // Output loudness = pre-makeup loudness + the (block-constant) makeup gain
+            outputMomentaryLufs.store(juce::jmax(emulation::LoudnessMeter::kFloorLufs, preMakeupLoudness_.getMomentaryLufs() + makeupTotal));
+            outputShortTermLufs.store(juce::jmax(emulation::LoudnessMeter::kFloorLufs, preMakeupLoudness_.getShortTermLufs() + makeupTotal));
         }
+        // Output level + main output (mono) for the Neon scopes and spectrum in one pass. The sidechain mono buffer is
+        // free once the compressor has run, so the mono sum lands there and the scope reduces it to min/max columns.
+        OMBIC_STAGE_SCOPE(stageTicks_, Metering);
+        float* mono = sidechainMonoBuffer_.getWritePointer(0);
+        emulation::analyseAndMix(buffer.getArrayOfReadPointers(), numAnalysed, numSamples, levels.data(), mono);
+        scopeWaveform_.capture(mono, numSamples);
+        if (spectrum)
+            spectrumAnalyser_.push(emulation::SpectrumAnalyser::Output, mono, numSamples);
+        if (truePeak)
+            applyTruePeak(outputTruePeak_, buffer, levels.data(), numAnalysed);
+        publishLevels(levels.data(), numAnalysed, numSamples, outputLevelDb, meters.data() + emulation::MeterBus::OutputPeak, peakCeilingDb);
+        meterBus_.push(meters, numSamples);
     }
-
-    sumSq = 0.0f;
-    peak = 0.0f;
-    peakL = 0.0f;
-    peakR = 0.0f;
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float s = std::abs(buffer.getSample(ch, i));
-            sumSq += buffer.getSample(ch, i) * buffer.getSample(ch, i);
-            if (s > peak) peak = s;
-            if (ch == 0 && s > peakL) peakL = s;
-            if (ch == 1 && s > peakR) peakR = s;
-        }
-    }
-    rms = std::sqrt(sumSq / (numChannels * numSamples));
-    float outRmsDb = rms > 1e-6f ? 20.0f * std::log10(rms) : -60.0f;
-    float outPeakDb = peak > 1e-6f ? 20.0f * std::log10(peak) : -60.0f;
-    outputLevelDb.store(juce::jlimit(-60.0f, 0.0f, outRmsDb));
-    outputPeakDb.store(juce::jlimit(-60.0f, 0.0f, outPeakDb));
-    outputPeakDbL.store(numChannels >= 1 ? juce::jlimit(-60.0f, 0.0f, peakL > 1e-6f ? 20.0f * std::log10(peakL) : -60.0f) : -60.0f);
-    outputPeakDbR.store(numChannels >= 2 ? juce::jlimit(-60.0f, 0.0f, peakR > 1e-6f ? 20.0f * std::log10(peakR) : -60.0f) : -60.0f);
 }
 
 //==============================================================================
 void OmbicCompressorProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
+    auto state = apvts.copyState();
+    {
+        const juce::ScopedLock sl(chainsLock_);
+        for (size_t m = 0; m < selectedProfileIds_.size(); ++m)
+        {
+            if (selectedProfileIds_[m].isNotEmpty())
+                state.setProperty(curveProfileStateIds[m], selectedProfileIds_[m], nullptr);
+            if (morphProfileIds_[m].isNotEmpty())
+                state.setProperty(morphProfileStateIds[m], morphProfileIds_[m], nullptr);
+        }
+    }
     juce::MemoryOutputStream stream(destData, true);
-    apvts.state.writeToStream(stream);
+    state.writeToStream(stream);
 }
 
 void OmbicCompressorProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -665,6 +1108,33 @@ void OmbicCompressorProcessor::setStateInformation(const void* data, int sizeInB
         // Safety: never restore with SC Listen on — override to off
         if (auto* p = apvts.getParameter(paramScListen))
             p->setValueNotifyingHost(p->convertTo0to1(false));
+
+        // Curve profiles: switch running chains now, otherwise prepareToPlay picks them up
+        for (size_t m = 0; m < selectedProfileIds_.size(); ++m)
+        {
+            const juce::String id = tree.getProperty(curveProfileStateIds[m]).toString();
+            if (id.isEmpty() || id == getActiveCurveProfile(static_cast<emulation::MVPChain::Mode>(m)))
+                continue;
+            if (!selectCurveProfile(id))
+            {
+                const juce::ScopedLock sl(chainsLock_);
+                selectedProfileIds_[m] = id;
+                ++profileSelectionSerial_;
+            }
+        }
+        for (size_t m = 0; m < morphProfileIds_.size(); ++m)
+        {
+            const auto mode = static_cast<emulation::MVPChain::Mode>(m);
+            const juce::String id = tree.getProperty(morphProfileStateIds[m]).toString();
+            if (id.isEmpty() || id == getMorphProfile(mode))
+                continue;
+            if (!selectMorphProfile(mode, id))
+            {
+                const juce::ScopedLock sl(chainsLock_);
+                morphProfileIds_[m] = id;
+                ++profileSelectionSerial_;
+            }
+        }
     }
 }
 
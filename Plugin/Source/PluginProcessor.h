@@ -1,13 +1,23 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Emulation/StageProfiler.h"
+#include "Emulation/TruePeakDetector.h"
+#include "Emulation/LoudnessMeter.h"
+#include "Emulation/MeterBus.h"
+#include "Emulation/SpectrumAnalyser.h"
+#include "Emulation/ScopeColumns.h"
+#include "Emulation/CurveProfiles.h"
+#include "Emulation/CurveMorph.h"
+#include <array>
 #include <memory>
 #include <vector>
 
-namespace emulation { class MVPChain; class NeonTapeSaturation; class PwmChain; class IronTransformer; }
+namespace emulation { class MVPChain; class NeonTapeSaturation; class PwmChain; class IronTransformer; class CurveReloader; }
 
 //==============================================================================
-class OmbicCompressorProcessor : public juce::AudioProcessor
+class OmbicCompressorProcessor : public juce::AudioProcessor,
+                                 private juce::Timer
 {
 public:
     OmbicCompressorProcessor();
@@ -15,6 +25,10 @@ public:
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    /** Clears DSP history (envelopes, filters, Neon, meters, Auto Gain) without rebuilding anything prepareToPlay
+     *  built, so an offline renderer can start each file from silence at the prepared sample rate. Allocation-free;
+     *  not concurrently with processBlock. */
+    void reset() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
@@ -43,18 +57,78 @@ public:
     // Level: keep RMS as "average" for transfer curve / backward compat
     std::atomic<float> inputLevelDb{ -60.0f };   // input RMS (average)
     std::atomic<float> outputLevelDb{ -60.0f }; // output RMS (average)
-    // Peak and stereo for industry-style monitoring (Dorrough-like)
-    std::atomic<float> inputPeakDb{ -60.0f };
-    std::atomic<float> outputPeakDb{ -60.0f };
-    std::atomic<float> inputPeakDbL{ -60.0f };
-    std::atomic<float> inputPeakDbR{ -60.0f };
-    std::atomic<float> outputPeakDbL{ -60.0f };
-    std::atomic<float> outputPeakDbR{ -60.0f };
-    std::atomic<float> gainReductionDb{ 0.0f };
+    // BS.1770 loudness (LUFS, floor -70), updated every 100 ms. Output includes makeup / Auto Gain.
+    std::atomic<float> inputMomentaryLufs{ -70.0f };
+    std::atomic<float> inputShortTermLufs{ -70.0f };
+    std::atomic<float> outputMomentaryLufs{ -70.0f };
+    std::atomic<float> outputShortTermLufs{ -70.0f };
+    /** Gain Auto Gain applies (or would apply when off), dB. */
+    std::atomic<float> autoGainDb{ 0.0f };
+
+    /** Per-block peaks (overall, L, R for input and output) and gain reduction. The editor's RenderScheduler holds
+     *  the one MeterBus::Reader and hands each frame's maxima to the meters; the history ring has no GUI reader yet. */
+    emulation::MeterBus& getMeterBus() { return meterBus_; }
+
+    /** Meter display choice (not automatable): when on, the meter bus peaks carry BS.1770 true peak (dBTP, up to
+     *  +6 so inter-sample overs show) instead of sample peak. The oversampling detector only runs while this is on. */
+    void setTruePeakMetering(bool shouldUseTruePeak) { truePeakMetering_.store(shouldUseTruePeak); }
+    bool isTruePeakMetering() const { return truePeakMetering_.load(); }
 
     /** True after ensureChains() has successfully loaded at least one curve set (FET or Opto). */
     bool hasCurveDataLoaded() const { return curveDataLoaded_.load(); }
 
+    /** Measured units found in the bundled CurveData, the development data root's output/ and the user profile folder
+     *  (Ombic/CurveProfiles under the user application data directory), sorted by name. Refreshed by prepareToPlay. */
+    std::vector<emulation::CurveProfile> getCurveProfiles() const;
+
+    /** Play a profile through its engine (FET, Opto or VCA): loads it into the shared CurveStore if it is not resident
+     *  and crossfades the running chain over to it. Saved with the plugin state. Message thread. Returns false if the
+     *  id is unknown or has no curve data; an engine without a chain yet picks the profile up at prepareToPlay. */
+    bool selectCurveProfile(const juce::String& profileId);
+
+    /** Id of the profile the engine plays (or will play from the next prepareToPlay); empty if none. */
+    juce::String getActiveCurveProfile(emulation::MVPChain::Mode mode) const;
+
+    /** Changes whenever the profile list, an engine's selected profile or its Character partner may have changed.
+     *  Lock-free, so the editor can poll it every frame and only then read the lists (which take chainsLock_). */
+    int getProfileSelectionSerial() const noexcept { return profileSelectionSerial_.load(); }
+
+    /** Profile the Character control blends the engine towards (defaults: FET <-> dbcomp_vca, VCA <-> fetish_v2, Opto
+     *  none). Resamples it onto the engine's morph lattice; an engine without a morph yet picks it up at prepareToPlay.
+     *  Saved with the plugin state. Message thread. */
+    bool selectMorphProfile(emulation::MVPChain::Mode mode, const juce::String& profileId);
+    juce::String getMorphProfile(emulation::MVPChain::Mode mode) const;
+
+    /** Compressor settings that shape the static transfer curve, converted like processBlock converts them. */
+    struct TransferCurveSettings
+    {
+        int mode = 0;                   // 0 Opto, 1 FET, 2 PWM, 3 VCA
+        float thresholdPercent = 50.0f; // threshold knob, 0–100
+        float ratio = 4.0f;
+        int fetCharacter = 0;           // 0 Off, 1 Rev A, 2 LN (FET only)
+        bool curveDataLoaded = false;
+        int curveProfileSerial = 0;     // changes when a profile switch has completed
+        float character = 0.0f;         // morph towards the engine's partner profile, 0..1
+
+        bool operator==(const TransferCurveSettings& o) const
+        {
+            return mode == o.mode && thresholdPercent == o.thresholdPercent && ratio == o.ratio
+                && fetCharacter == o.fetCharacter && curveDataLoaded == o.curveDataLoaded
+                && curveProfileSerial == o.curveProfileSerial && character == o.character;
+        }
+        bool operator!=(const TransferCurveSettings& o) const { return !(*this == o); }
+    };
+    TransferCurveSettings getTransferCurveSettings() const;
+
+    /** Steady-state output level for each input level (dB), from the gain computer the audio path uses for the mode:
+     *  the measured curve (plus FET character) for Opto/FET/VCA; for PWM its measured curves when an OmbicMeasure
+     *  capture is installed (the feedback detector's real steady state), else the soft-knee computer. Returns false if the
+     *  mode has no curve data. May block briefly while prepareToPlay rebuilds the chains; never call from the audio thread. */
+    bool computeTransferCurve(const TransferCurveSettings& settings, const float* inputDb, float* outputDb, int numPoints) const;
+
+    /** Offline tools: repo-style root containing output/fetish_v2 etc. Tried before env/cwd lookup. Call before prepareToPlay. */
+    void setCurveDataRoot(const juce::File& root) { dataRoot_ = root; }
+
     static const char* paramCompressorMode;
     static const char* paramThreshold;
     static const char* paramRatio;
@@ -77,15 +151,29 @@ public:
     static const char* paramIron;
     static const char* paramAutoGain;
     static const char* paramFetCharacter;
+    static const char* paramCharacter;
 
     /** True when SC Listen is active (for header indicator). */
     bool isScListenActive() const;
 
-    /** Copy of latest sidechain buffer for scope when Listen is on. Returns true if out was filled (Listen active and we have samples). Call from message thread only. */
-    bool getScopeSidechainSamples(std::vector<float>& out) const;
+    /** Latest sidechain block as min/max columns, for the scope while Listen is on (empty otherwise). The scope sets
+     *  the column count to its width. */
+    emulation::ScopeColumns& getScopeSidechain() { return scopeSidechain_; }
+
+    /** Latest main output (mono) block as min/max columns, for the Neon scopes while Listen is off (empty otherwise). */
+    emulation::ScopeColumns& getScopeWaveform() { return scopeWaveform_; }
+
+    /** Input, output and sidechain spectra. Only fed (and only analysing, on its own thread) while a
+     *  SpectrumAnalyser::Consumer exists, i.e. while a spectrum display is open. */
+    emulation::SpectrumAnalyser& getSpectrumAnalyser() { return spectrumAnalyser_; }
 
-    /** Copy of latest main output (mono) for Neon scope when Listen is off. Returns true if out was filled. Call from message thread only. */
-    bool getScopeWaveformSamples(std::vector<float>& out) const;
+    /** Largest block processed in one pass; bigger host blocks are split. All audio-thread scratch is sized to this in prepareToPlay. */
+    int getMaxBlockSize() const { return maxBlockSize_; }
+
+    /** Per-stage DSP timing (sidechain, Neon, compressor, Iron, makeup, metering, total). Only records when built with
+     *  OMBIC_STAGE_PROFILING; otherwise every window stays empty. Readable from any thread. */
+    emulation::StageProfiler& getStageProfiler() { return stageProfiler_; }
+    const emulation::StageProfiler& getStageProfiler() const { return stageProfiler_; }
 
 private:
     std::atomic<bool> curveDataLoaded_{ false };
@@ -94,20 +182,77 @@ private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     double sampleRateHz = 48000.0;
+    int maxBlockSize_ = 512;
+    double chainsSampleRate_ = 0.0;   // sample rate the MVP chains were built for (0 = not built)
     juce::LinearSmoothedValue<float> inputRms;
     juce::LinearSmoothedValue<float> outputRms;
 
     juce::File dataRoot_;
+    mutable juce::CriticalSection chainsLock_;   // held while the MVP chains are rebuilt, and by computeTransferCurve (never the audio thread)
     std::unique_ptr<emulation::MVPChain> fetChain_;
     std::unique_ptr<emulation::MVPChain> optoChain_;
     std::unique_ptr<emulation::MVPChain> vcaChain_;
     std::unique_ptr<emulation::PwmChain> pwmChain_;
     std::unique_ptr<emulation::IronTransformer> iron_;
     std::unique_ptr<emulation::NeonTapeSaturation> standaloneNeon_;
+
+    // Curve profiles: the chains play CurveStore tables shared with every other instance in the process
+    juce::SharedResourcePointer<emulation::CurveStore> curveStore_;
+    std::vector<emulation::CurveProfile> curveProfiles_;        // chainsLock_
+    std::array<juce::String, 3> selectedProfileIds_;            // per MVPChain::Mode, as saved in the state; chainsLock_
+    std::array<emulation::CurveProfile, 3> activeProfiles_;     // what each chain plays; chainsLock_
+    std::atomic<int> curveProfileSerial_{ 0 };
+    std::atomic<int> profileSelectionSerial_{ 0 };
+    emulation::CurveStore::TablesPtr pwmTransferTables_;        // measured PWM curves (findPwmCurveData), if any; chainsLock_
+    static constexpr int kTableReclaimIntervalMs = 250;
+    juce::Array<juce::File> getCurveProfileRoots();
+    const emulation::CurveProfile* findCurveProfile(const juce::String& profileId) const;
+    /** Selected profile for the engine, else its default (fetish_v2, lala_v2, dbcomp_vca), else the first one found. */
+    const emulation::CurveProfile* findProfileForMode(emulation::MVPChain::Mode mode) const;
+    std::unique_ptr<emulation::MVPChain>& getChain(emulation::MVPChain::Mode mode);
+    /** Frees tables the chains have finished fading out of (profile switches), under chainsLock_. Runs only while a
+     *  switch is outstanding: started by selectCurveProfile, stops itself once every swap has been reclaimed. */
+    void timerCallback() override;
+
+    // Character: per engine, a blend towards a partner profile, rebuilt by the worker as the parameter moves
+    std::array<std::unique_ptr<emulation::CurveMorph>, 3> morphs_;
+    std::array<juce::String, 3> morphProfileIds_;                 // as saved in the state; chainsLock_
+    std::array<emulation::CurveProfile, 3> morphPartners_;        // chainsLock_
+    std::array<emulation::CurveStore::TablesPtr, 3> morphPartnerTables_;   // chainsLock_
+    emulation::CurveMorph::Worker morphWorker_;
+    /** Attach a morph to every engine that has a chain and a partner profile. prepareToPlay, under chainsLock_. */
+    void ensureMorphs();
+#if OMBIC_CURVE_HOT_RELOAD
+    /** Watches the directories the chains were loaded from. Declared after the chains so it stops before they go;
+     *  reset before taking chainsLock_ (its thread takes that lock to free outgoing tables). */
+    std::unique_ptr<emulation::CurveReloader> curveReloader_;
+    /** Watches every chain's profile and Character partner. Under chainsLock_, after ensureMorphs. */
+    void startCurveReloader();
+    /** Reload thread, chainsLock_ held: publishes the tables to the chains playing dataDir and re-sources the morphs
+     *  built from it (as their own profile or as the partner). */
+    void applyReloadedTables(const juce::File& dataDir, emulation::CurveStore::TablesPtr tables);
+#endif
+    /** Loads curve data and builds the MVP chains. File I/O and allocation: prepareToPlay only, never the audio thread. */
     void ensureChains();
     void ensurePwmChain();
-    /** Parameter-based estimate of makeup gain (dB) for Auto Gain. Uses nominal threshold/ratio/speed. */
-    float estimateMakeupDb(int mode, float thresholdRaw, float ratio, float attackParam, float releaseParam, float speedParam) const;
+    void processSubBlock(juce::AudioBuffer<float>& buffer);
+    static constexpr int kMaxChannels = 32;   // channels metered / summed per block (the buses are stereo)
+    static constexpr float kTruePeakCeilingDb = 6.0f;
+
+    std::atomic<bool> truePeakMetering_{ false };
+    bool truePeakWasOn_ = false;   // audio thread: reset detector history when metering switches back on
+    emulation::TruePeakDetector inputTruePeak_;
+    emulation::TruePeakDetector outputTruePeak_;
+
+    // Loudness: input, and the processed signal before makeup (Auto Gain compares the two; adding makeup gives the output)
+    emulation::LoudnessMeter inputLoudness_;
+    emulation::LoudnessMeter preMakeupLoudness_;
+    float autoGainSmoothedDb_ = 0.0f;
+    bool listenWasOn_ = false;
+    static constexpr float kAutoGainTimeConstantS = 3.0f;
+    static constexpr float kAutoGainRangeDb = 12.0f;
+    /** Auto Gain: slowly follow the gated short-term loudness difference between input and the pre-makeup output. */
+    void updateAutoGain(int numSamples);
 
     // Sidechain filter module: HPF on mono sum for detector; true bypass at 20 Hz
     static constexpr float kScFilterOffHz = 20.0f;
@@ -115,15 +260,18 @@ private:
     juce::dsp::IIR::Coefficients<float>::Ptr sidechainHpfCoeffs_;
     juce::SmoothedValue<float> smoothedScFrequency_;
     juce::AudioBuffer<float> sidechainMonoBuffer_;
-    juce::AudioBuffer<float> sidechainStereoForListen_;
     void updateSidechainFilterCoeffs(float frequencyHz);
 
-    // Scope: when Listen is on, copy latest sidechain block for Neon scope (audio thread writes, message thread reads)
-    mutable juce::CriticalSection scopeSidechainLock_;
-    std::vector<float> scopeSidechainBuffer_;
-    // Scope: when Listen is off, copy latest main output (mono) so Neon tube can show real waveform
-    mutable juce::CriticalSection scopeWaveformLock_;
-    std::vector<float> scopeWaveformBuffer_;
+    // Scopes: latest sidechain block (Listen on) / main output mono (Listen off), reduced to per-pixel min/max columns
+    emulation::ScopeColumns scopeSidechain_;
+    emulation::ScopeColumns scopeWaveform_;
+
+    emulation::MeterBus meterBus_;
+    emulation::SpectrumAnalyser spectrumAnalyser_;
+    emulation::StageProfiler stageProfiler_;
+#if OMBIC_STAGE_PROFILING
+    emulation::StageProfiler::StageTicks stageTicks_;   // audio thread only; cleared per sub-block
+#endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OmbicCompressorProcessor)
 };
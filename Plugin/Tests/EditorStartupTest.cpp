@@ -0,0 +1,116 @@
+/*
+ * Editor open time: constructs the plugin editor the way a host does (createEditor on the message thread),
+ * renders its first full frame into an image and destroys it, repeatedly. The first open in the process is
+ * reported separately (it resolves the embedded fonts and decodes the logo). Wall-clock timings depend on the
+ * machine, so by default the run only reports them; given a budget it fails if the median of the following opens
+ * exceeds it.
+ *
+ * Usage: OmbicEditorStartupTest [budgetMs]   (or OMBIC_EDITOR_OPEN_BUDGET_MS; no budget = report only)
+ * Run from the repo root, or set OMBIC_COMPRESSOR_DATA_PATH so curve data is found.
+ */
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+constexpr int kWarmOpens = 25;
+
+struct OpenTiming
+{
+    double constructMs = 0.0;
+    double firstPaintMs = 0.0;
+    double destroyMs = 0.0;
+    double openMs() const { return constructMs + firstPaintMs; }
+};
+
+double msSince(juce::int64 startTicks)
+{
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+}
+
+OpenTiming openEditor(OmbicCompressorProcessor& processor)
+{
+    OpenTiming t;
+    auto start = juce::Time::getHighResolutionTicks();
+    std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+    t.constructMs = msSince(start);
+
+    start = juce::Time::getHighResolutionTicks();
+    juce::Image frame(juce::Image::ARGB, juce::jmax(1, editor->getWidth()), juce::jmax(1, editor->getHeight()), true);
+    {
+        juce::Graphics g(frame);
+        editor->paintEntireComponent(g, true);
+    }
+    t.firstPaintMs = msSince(start);
+
+    start = juce::Time::getHighResolutionTicks();
+    editor.reset();
+    t.destroyMs = msSince(start);
+    return t;
+}
+
+/** Budget in ms, or 0 when none was given (report only). */
+double budgetMs(int argc, char** argv)
+{
+    if (argc > 1)
+        return std::atof(argv[1]);
+    const auto env = juce::SystemStats::getEnvironmentVariable("OMBIC_EDITOR_OPEN_BUDGET_MS", {});
+    return env.isNotEmpty() ? env.getDoubleValue() : 0.0;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    const double budget = budgetMs(argc, argv);
+
+    OmbicCompressorProcessor processor;
+    processor.setPlayConfigDetails(2, 2, 48000.0, 512);
+    processor.prepareToPlay(48000.0, 512);
+    if (!processor.hasCurveDataLoaded())
+    {
+        std::fprintf(stderr, "FAIL: curve data not found (run from repo root or set OMBIC_COMPRESSOR_DATA_PATH)\n");
+        return 1;
+    }
+
+    const auto cold = openEditor(processor);
+    std::printf("first open   %7.2f ms (construct %.2f, first paint %.2f, destroy %.2f)\n",
+                cold.openMs(), cold.constructMs, cold.firstPaintMs, cold.destroyMs);
+
+    std::vector<double> opens;
+    double constructSum = 0.0, paintSum = 0.0, destroySum = 0.0;
+    for (int i = 0; i < kWarmOpens; ++i)
+    {
+        const auto t = openEditor(processor);
+        opens.push_back(t.openMs());
+        constructSum += t.constructMs;
+        paintSum += t.firstPaintMs;
+        destroySum += t.destroyMs;
+    }
+    std::sort(opens.begin(), opens.end());
+    const double median = opens[opens.size() / 2];
+    std::printf("later opens  min %.2f / median %.2f / max %.2f ms over %d (avg construct %.2f, first paint %.2f, destroy %.2f)\n",
+                opens.front(), median, opens.back(), kWarmOpens,
+                constructSum / kWarmOpens, paintSum / kWarmOpens, destroySum / kWarmOpens);
+
+    processor.releaseResources();
+
+    if (budget <= 0.0)
+    {
+        std::printf("\nNo budget given: timings reported only.\n");
+        return 0;
+    }
+    if (median > budget)
+    {
+        std::printf("\nFAIL: median editor open %.2f ms exceeds the %.1f ms budget.\n", median, budget);
+        return 1;
+    }
+    std::printf("\nEditor opens within the %.1f ms budget.\n", budget);
+    return 0;
+}
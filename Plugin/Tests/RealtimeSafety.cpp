@@ -0,0 +1,313 @@
+#include "RealtimeSafety.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#if defined(__GLIBC__)
+ #define OMBIC_RT_INTERPOSE_LIBC 1
+ #include <dlfcn.h>
+ #include <errno.h>
+ #include <execinfo.h>
+ #include <fcntl.h>
+ #include <pthread.h>
+ #include <stdarg.h>
+ #include <stdlib.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+#else
+ #define OMBIC_RT_INTERPOSE_LIBC 0
+ #include <cstdlib>
+#endif
+
+namespace rtsafety {
+namespace {
+
+std::atomic<int> violationCount{ 0 };
+
+// Plain TLS (no dynamic initialiser) so reading it from inside malloc is safe.
+thread_local bool realtimeActive = false;
+thread_local bool reporting = false;
+
+void writeStderr(const char* text)
+{
+#if OMBIC_RT_INTERPOSE_LIBC
+    const ssize_t ignored = ::write(2, text, std::strlen(text));
+    (void)ignored;
+#else
+    std::fputs(text, stderr);
+#endif
+}
+
+/** Called from every interposed entry point. Must not allocate. */
+void onCall(const char* what, const char* detail = nullptr)
+{
+    if (!realtimeActive || reporting)
+        return;
+    reporting = true;
+    violationCount.fetch_add(1, std::memory_order_relaxed);
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "[rtsafety] %s%s%s on the audio thread\n",
+                  what, detail != nullptr ? " " : "", detail != nullptr ? detail : "");
+    writeStderr(line);
+#if OMBIC_RT_INTERPOSE_LIBC
+    void* frames[48];
+    const int n = ::backtrace(frames, 48);
+    ::backtrace_symbols_fd(frames, n, 2);
+#endif
+    writeStderr("\n");
+    reporting = false;
+}
+
+} // namespace
+
+int getViolationCount() { return violationCount.load(); }
+void resetViolationCount() { violationCount.store(0); }
+
+ScopedRealtimeGuard::ScopedRealtimeGuard() { realtimeActive = true; }
+ScopedRealtimeGuard::~ScopedRealtimeGuard() { realtimeActive = false; }
+
+ScopedRealtimeExemption::ScopedRealtimeExemption() : wasActive_(realtimeActive) { realtimeActive = false; }
+ScopedRealtimeExemption::~ScopedRealtimeExemption() { realtimeActive = wasActive_; }
+
+} // namespace rtsafety
+
+#if OMBIC_RT_INTERPOSE_LIBC
+//==============================================================================
+// glibc: malloc family forwards to the __libc_* implementations (no dlsym needed, so it works before
+// static init). Locks and file I/O forward to the next definition resolved with dlsym(RTLD_NEXT).
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+}
+
+namespace {
+using MutexLockFn = int (*)(pthread_mutex_t*);
+using OpenFn = int (*)(const char*, int, ...);
+using OpenAtFn = int (*)(int, const char*, int, ...);
+using FopenFn = FILE* (*)(const char*, const char*);
+using StatFn = int (*)(const char*, struct stat*);
+using XStatFn = int (*)(int, const char*, struct stat*);
+
+MutexLockFn realMutexLock = nullptr;
+OpenFn realOpen = nullptr;
+OpenFn realOpen64 = nullptr;
+OpenAtFn realOpenAt = nullptr;
+FopenFn realFopen = nullptr;
+FopenFn realFopen64 = nullptr;
+StatFn realStat = nullptr;
+StatFn realLstat = nullptr;
+StatFn realStat64 = nullptr;
+XStatFn realXStat = nullptr;
+XStatFn realXStat64 = nullptr;
+
+template <typename Fn>
+Fn resolveNext(const char* name)
+{
+    return reinterpret_cast<Fn>(::dlsym(RTLD_NEXT, name));
+}
+
+void resolveAll()
+{
+    if (realMutexLock != nullptr)
+        return;
+    realMutexLock = resolveNext<MutexLockFn>("pthread_mutex_lock");
+    realOpen = resolveNext<OpenFn>("open");
+    realOpen64 = resolveNext<OpenFn>("open64");
+    realOpenAt = resolveNext<OpenAtFn>("openat");
+    realFopen = resolveNext<FopenFn>("fopen");
+    realFopen64 = resolveNext<FopenFn>("fopen64");
+    realStat = resolveNext<StatFn>("stat");
+    realLstat = resolveNext<StatFn>("lstat");
+    realStat64 = resolveNext<StatFn>("stat64");
+    realXStat = resolveNext<XStatFn>("__xstat");
+    realXStat64 = resolveNext<XStatFn>("__xstat64");
+}
+
+// Resolve during static initialisation, before any thread can be marked real-time.
+struct Resolver { Resolver() { resolveAll(); } } resolver;
+
+mode_t modeArg(int flags, va_list args)
+{
+    return (flags & (O_CREAT | O_TMPFILE)) != 0 ? static_cast<mode_t>(va_arg(args, int)) : 0;
+}
+} // namespace
+
+void rtsafety::initialise()
+{
+    resolveAll();
+    // backtrace() loads libgcc lazily on first use (allocates); do that now, off the audio thread.
+    void* frames[4];
+    (void)::backtrace(frames, 4);
+}
+
+extern "C" {
+
+void* malloc(size_t size) __THROW
+{
+    rtsafety::onCall("malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) __THROW
+{
+    rtsafety::onCall("calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) __THROW
+{
+    rtsafety::onCall("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) __THROW
+{
+    if (ptr != nullptr)
+        rtsafety::onCall("free");
+    __libc_free(ptr);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) __THROW
+{
+    rtsafety::onCall("posix_memalign");
+    void* p = __libc_memalign(alignment, size);
+    if (p == nullptr)
+        return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) __THROW
+{
+    rtsafety::onCall("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) __THROW
+{
+    rtsafety::onCall("pthread_mutex_lock");
+    if (realMutexLock == nullptr)
+        resolveAll();
+    return realMutexLock(mutex);
+}
+
+int open(const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = modeArg(flags, args);
+    va_end(args);
+    rtsafety::onCall("open", path);
+    return realOpen(path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = modeArg(flags, args);
+    va_end(args);
+    rtsafety::onCall("open64", path);
+    return realOpen64(path, flags, mode);
+}
+
+int openat(int dirFd, const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = modeArg(flags, args);
+    va_end(args);
+    rtsafety::onCall("openat", path);
+    return realOpenAt(dirFd, path, flags, mode);
+}
+
+FILE* fopen(const char* path, const char* mode)
+{
+    rtsafety::onCall("fopen", path);
+    return realFopen(path, mode);
+}
+
+FILE* fopen64(const char* path, const char* mode)
+{
+    rtsafety::onCall("fopen64", path);
+    return realFopen64(path, mode);
+}
+
+int stat(const char* path, struct stat* buf) __THROW
+{
+    rtsafety::onCall("stat", path);
+    return realStat(path, buf);
+}
+
+int lstat(const char* path, struct stat* buf) __THROW
+{
+    rtsafety::onCall("lstat", path);
+    return realLstat(path, buf);
+}
+
+int stat64(const char* path, struct stat64* buf) __THROW
+{
+    rtsafety::onCall("stat64", path);
+    return realStat64(path, reinterpret_cast<struct stat*>(buf));
+}
+
+// Pre-2.33 glibc routes stat() through these.
+int __xstat(int ver, const char* path, struct stat* buf) __THROW
+{
+    rtsafety::onCall("stat", path);
+    return realXStat(ver, path, buf);
+}
+
+int __xstat64(int ver, const char* path, struct stat64* buf) __THROW
+{
+    rtsafety::onCall("stat64", path);
+    return realXStat64(ver, path, reinterpret_cast<struct stat*>(buf));
+}
+
+} // extern "C"
+
+#else
+//==============================================================================
+// Other platforms: libc cannot be interposed portably, so only C++ allocations are checked.
+void rtsafety::initialise() {}
+
+void* operator new(std::size_t size)
+{
+    rtsafety::onCall("operator new");
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    rtsafety::onCall("operator new[]");
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr != nullptr)
+        rtsafety::onCall("operator delete");
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    if (ptr != nullptr)
+        rtsafety::onCall("operator delete[]");
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { operator delete[](ptr); }
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+/** Real-time safety checks for the audio thread (test builds only).
+ *  Inside a ScopedRealtimeGuard, calls to malloc/calloc/realloc/free, pthread_mutex_lock and
+ *  open/fopen/stat are reported to stderr with a stack trace and counted as violations.
+ *  Full interposition on Linux/glibc; elsewhere only global operator new/delete are checked. */
+namespace rtsafety {
+
+/** Resolve the real libc entry points and prime backtrace() so the first report does not allocate. Call once from main(). */
+void initialise();
+
+/** Number of violations recorded since start (or since resetViolationCount). */
+int getViolationCount();
+void resetViolationCount();
+
+/** Marks the calling thread as the audio thread for the guard's lifetime. Not nestable across threads. */
+class ScopedRealtimeGuard
+{
+public:
+    ScopedRealtimeGuard();
+    ~ScopedRealtimeGuard();
+
+    ScopedRealtimeGuard(const ScopedRealtimeGuard&) = delete;
+    ScopedRealtimeGuard& operator=(const ScopedRealtimeGuard&) = delete;
+};
+
+/** Temporarily allows non-RT calls on a guarded thread (e.g. the harness's own bookkeeping). */
+class ScopedRealtimeExemption
+{
+public:
+    ScopedRealtimeExemption();
+    ~ScopedRealtimeExemption();
+
+    ScopedRealtimeExemption(const ScopedRealtimeExemption&) = delete;
+    ScopedRealtimeExemption& operator=(const ScopedRealtimeExemption&) = delete;
+
+private:
+    bool wasActive_;
+};
+
+} // namespace rtsafety
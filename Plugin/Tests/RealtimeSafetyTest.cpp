@@ -0,0 +1,251 @@
+/*
+ * Real-time safety harness: drives OmbicCompressorProcessor like a host (prepareToPlay on the main
+ * thread, processBlock on a dedicated audio thread) across sample rates, block sizes and parameter
+ * scenarios, some of which move the Character control or switch curve profiles from the main thread while
+ * blocks run (morph hand-off, table swap and crossfade). Any malloc/free, mutex lock or file I/O inside processBlock is reported with a stack
+ * trace (see RealtimeSafety.h) and the run exits non-zero.
+ *
+ * Run from the repo root, or set OMBIC_COMPRESSOR_DATA_PATH so curve data is found.
+ */
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "Emulation/MVPChain.h"
+#include "Emulation/PwmChain.h"
+#include "RealtimeSafety.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int kBlocksPerScenario = 48;
+
+struct Scenario
+{
+    const char* name;
+    std::function<void(juce::AudioProcessorValueTreeState&)> apply;
+    /** Optional: runs on the main thread while the audio thread keeps processing (message-thread changes mid-stream). */
+    std::function<void(OmbicCompressorProcessor&)> whileRunning = {};
+};
+
+void setParam(juce::AudioProcessorValueTreeState& apvts, const char* id, float normalised)
+{
+    if (auto* p = apvts.getParameter(id))
+        p->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, normalised));
+}
+
+void resetParams(juce::AudioProcessorValueTreeState& apvts)
+{
+    for (auto* p : apvts.processor.getParameters())
+        if (auto* rp = dynamic_cast<juce::RangedAudioParameter*>(p))
+            rp->setValueNotifyingHost(rp->getDefaultValue());
+}
+
+/** Every choice value, switch and range extreme the audio path branches on. */
+std::vector<Scenario> makeScenarios()
+{
+    using P = OmbicCompressorProcessor;
+    std::vector<Scenario> s;
+    for (int m = 0; m < 4; ++m)
+    {
+        static const char* names[] = { "mode 0", "mode 1", "mode 2", "mode 3" };
+        s.push_back({ names[m], [m](auto& a) { setParam(a, P::paramCompressorMode, (float)m / 3.0f); } });
+    }
+    s.push_back({ "threshold/ratio min", [](auto& a) { setParam(a, P::paramThreshold, 0.0f); setParam(a, P::paramRatio, 0.0f); } });
+    s.push_back({ "threshold/ratio max", [](auto& a) { setParam(a, P::paramThreshold, 1.0f); setParam(a, P::paramRatio, 1.0f); } });
+    s.push_back({ "attack/release extremes", [](auto& a) { setParam(a, P::paramAttack, 1.0f); setParam(a, P::paramRelease, 0.0f); } });
+    s.push_back({ "fet character", [](auto& a) { setParam(a, P::paramCompressorMode, 1.0f / 3.0f); setParam(a, P::paramFetCharacter, 0.5f); } });
+    s.push_back({ "fet character LN", [](auto& a) { setParam(a, P::paramCompressorMode, 1.0f / 3.0f); setParam(a, P::paramFetCharacter, 1.0f); } });
+    s.push_back({ "opto limit", [](auto& a) { setParam(a, P::paramOptoCompressLimit, 1.0f); } });
+    s.push_back({ "sidechain HPF", [](auto& a) { setParam(a, P::paramScFrequency, 1.0f); } });
+    s.push_back({ "sidechain HPF + listen", [](auto& a) { setParam(a, P::paramScFrequency, 0.6f); setParam(a, P::paramScListen, 1.0f); } });
+    s.push_back({ "neon on", [](auto& a) { setParam(a, P::paramNeonEnable, 1.0f); setParam(a, P::paramNeonDrive, 1.0f); setParam(a, P::paramNeonBurstiness, 1.0f); } });
+    s.push_back({ "neon saturation after", [](auto& a) { setParam(a, P::paramNeonEnable, 1.0f); setParam(a, P::paramNeonSaturationAfter, 1.0f); setParam(a, P::paramNeonIntensity, 1.0f); } });
+    s.push_back({ "iron", [](auto& a) { setParam(a, P::paramIron, 1.0f); } });
+    s.push_back({ "iron + pwm", [](auto& a) { setParam(a, P::paramIron, 0.5f); setParam(a, P::paramCompressorMode, 2.0f / 3.0f); setParam(a, P::paramPwmSpeed, 1.0f); } });
+    s.push_back({ "auto gain + makeup", [](auto& a) { setParam(a, P::paramAutoGain, 1.0f); setParam(a, P::paramMakeupGainDb, 1.0f); } });
+
+    // Character: the morph worker rebuilds the blended lattice while the audio thread acquires it
+    auto characterSweep = [](OmbicCompressorProcessor& p) {
+        for (int i = 0; i <= 40; ++i)
+        {
+            setParam(p.getValueTreeState(), P::paramCharacter, (float)(i % 21) / 20.0f);
+            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        }
+    };
+    s.push_back({ "character sweep FET", [](auto& a) { setParam(a, P::paramCompressorMode, 1.0f / 3.0f); setParam(a, P::paramCharacter, 0.5f); }, characterSweep });
+    s.push_back({ "character sweep VCA", [](auto& a) { setParam(a, P::paramCompressorMode, 1.0f); setParam(a, P::paramCharacter, 0.5f); }, characterSweep });
+    // Profile switch: publishTables hand-off, crossfade and retire on the audio thread, morph sources replaced
+    s.push_back({ "profile switch", [](auto& a) { setParam(a, P::paramCompressorMode, 1.0f / 3.0f); setParam(a, P::paramCharacter, 0.3f); },
+                  [](OmbicCompressorProcessor& p) {
+                      using Mode = emulation::MVPChain::Mode;
+                      for (int i = 0; i < 6; ++i)
+                      {
+                          p.selectCurveProfile(p.getActiveCurveProfile((i & 1) == 0 ? Mode::FET : Mode::VCA));
+                          // Past the table crossfade, so most switches complete and retire the outgoing set
+                          std::this_thread::sleep_for(std::chrono::milliseconds((int)emulation::MeasuredCompressor::kTableCrossfadeMs + 10));
+                      }
+                  } });
+    return s;
+}
+
+void fillInput(juce::AudioBuffer<float>& buffer, double sampleRate, int64_t& phase)
+{
+    juce::Random rng(1234 + phase);
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    {
+        const double t = static_cast<double>(phase + i) / sampleRate;
+        // Bursty programme: 110 Hz + 3 kHz with a 4 Hz amplitude envelope, so compressors attack and release.
+        const float env = 0.1f + 0.9f * (0.5f + 0.5f * (float)std::sin(2.0 * juce::MathConstants<double>::pi * 4.0 * t));
+        const float x = env * (0.6f * (float)std::sin(2.0 * juce::MathConstants<double>::pi * 110.0 * t)
+                             + 0.2f * (float)std::sin(2.0 * juce::MathConstants<double>::pi * 3000.0 * t))
+                      + 0.01f * (rng.nextFloat() * 2.0f - 1.0f);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            buffer.setSample(ch, i, x);
+    }
+    phase += buffer.getNumSamples();
+}
+
+/** Process the pre-filled blocks on a fresh "audio thread" inside a realtime guard. With whileRunning, the blocks
+ *  repeat until it has returned on the calling thread. Returns violations. */
+int runAudioThread(const std::function<void(int)>& processBlockAt, int numBlocks,
+                   const std::function<void()>& whileRunning = {})
+{
+    const int before = rtsafety::getViolationCount();
+    std::atomic<bool> done{ !whileRunning };
+    std::thread audioThread([&] {
+        rtsafety::ScopedRealtimeGuard guard;
+        for (int b = 0; b < numBlocks || !done.load(); ++b)
+            processBlockAt(b % numBlocks);
+    });
+    if (whileRunning)
+        whileRunning();
+    done = true;
+    audioThread.join();
+    return rtsafety::getViolationCount() - before;
+}
+
+int runProcessorScenarios()
+{
+    OmbicCompressorProcessor processor;
+    auto& apvts = processor.getValueTreeState();
+    const auto scenarios = makeScenarios();
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    const int blockSizes[] = { 32, 64, 512, 1024 };
+    int failures = 0;
+
+    for (double sr : sampleRates)
+    {
+        for (int bs : blockSizes)
+        {
+            processor.setPlayConfigDetails(2, 2, sr, bs);
+            processor.prepareToPlay(sr, bs);
+            if (!processor.hasCurveDataLoaded())
+            {
+                std::fprintf(stderr, "FAIL: curve data not found (run from repo root or set OMBIC_COMPRESSOR_DATA_PATH)\n");
+                return 1;
+            }
+
+            // Pre-render input off the audio thread; the last block is oversized (hosts may exceed the announced size).
+            std::vector<juce::AudioBuffer<float>> blocks;
+            int64_t phase = 0;
+            for (int b = 0; b < kBlocksPerScenario; ++b)
+            {
+                blocks.emplace_back(2, b == kBlocksPerScenario - 1 ? bs * 4 + 7 : bs);
+                fillInput(blocks.back(), sr, phase);
+            }
+            juce::MidiBuffer midi;
+
+            for (const auto& scenario : scenarios)
+            {
+                resetParams(apvts);
+                scenario.apply(apvts);
+                const int violations = runAudioThread([&](int b) { processor.processBlock(blocks[(size_t)b], midi); },
+                                                      kBlocksPerScenario,
+                                                      scenario.whileRunning ? std::function<void()>([&] { scenario.whileRunning(processor); })
+                                                                            : std::function<void()>());
+                std::printf("%-8s sr=%-6d block=%-5d %-26s %s\n", violations == 0 ? "ok" : "FAIL",
+                            (int)sr, bs, scenario.name, violations == 0 ? "" : juce::String(violations).toRawUTF8());
+                if (violations != 0)
+                    ++failures;
+            }
+            processor.releaseResources();
+        }
+    }
+    return failures;
+}
+
+/** FET and PWM are driven directly too, so they are covered regardless of how the mode parameter maps. */
+int runEmulationScenarios(const juce::File& dataRoot)
+{
+    const double sr = 48000.0;
+    const int bs = 256;
+    int failures = 0;
+    const auto fetDir = dataRoot.getChildFile("output/fetish_v2");
+    const auto lalaDir = dataRoot.getChildFile("output/lala_v2");
+    const auto vcaDir = dataRoot.getChildFile("output/dbcomp_vca");
+
+    std::vector<juce::AudioBuffer<float>> blocks;
+    int64_t phase = 0;
+    for (int b = 0; b < kBlocksPerScenario; ++b)
+    {
+        blocks.emplace_back(2, bs);
+        fillInput(blocks.back(), sr, phase);
+    }
+    juce::AudioBuffer<float> detector(1, bs);
+    detector.copyFrom(0, 0, blocks[0], 0, 0, bs);
+
+    for (auto mode : { emulation::MVPChain::Mode::FET, emulation::MVPChain::Mode::Opto, emulation::MVPChain::Mode::VCA })
+    {
+        emulation::MVPChain chain(mode, sr, fetDir, lalaDir, vcaDir, false, false, {}, 1.0f, true);
+        chain.prepare(bs, 2);
+        const int violations = runAudioThread([&](int b) {
+            chain.process(blocks[(size_t)b], -24.0f, 8.0f, 200.0f, 400.0f, 512, (b & 1) == 0,
+                          (b % 3) == 0 ? &detector : nullptr, b % 3);
+        }, kBlocksPerScenario);
+        std::printf("%-8s MVPChain mode %d %s\n", violations == 0 ? "ok" : "FAIL", (int)mode,
+                    violations == 0 ? "" : juce::String(violations).toRawUTF8());
+        failures += violations != 0 ? 1 : 0;
+    }
+
+    emulation::PwmChain pwm(sr);
+    pwm.prepare(sr, bs);
+    const int violations = runAudioThread([&](int b) {
+        pwm.process(blocks[(size_t)b], 30.0f, 8.0f, 1.0f, 50.0f, (b & 1) == 0 ? &detector : nullptr);
+    }, kBlocksPerScenario);
+    std::printf("%-8s PwmChain %s\n", violations == 0 ? "ok" : "FAIL", violations == 0 ? "" : juce::String(violations).toRawUTF8());
+    failures += violations != 0 ? 1 : 0;
+    return failures;
+}
+
+juce::File findDataRoot()
+{
+    const auto env = juce::SystemStats::getEnvironmentVariable("OMBIC_COMPRESSOR_DATA_PATH", {});
+    juce::File root = env.isNotEmpty() ? juce::File::getCurrentWorkingDirectory().getChildFile(env)
+                                       : juce::File::getCurrentWorkingDirectory();
+    return root;
+}
+} // namespace
+
+int main()
+{
+    rtsafety::initialise();
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    int failures = runProcessorScenarios();
+    failures += runEmulationScenarios(findDataRoot());
+
+    if (failures != 0)
+    {
+        std::printf("\n%d scenario(s) touched the allocator, a mutex or the filesystem on the audio thread.\n", failures);
+        return 1;
+    }
+    std::printf("\nAll scenarios real-time safe.\n");
+    return 0;
+}
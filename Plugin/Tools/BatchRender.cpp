@@ -0,0 +1,404 @@
+/*
+ * OmbicRender: headless batch renderer. Runs OmbicCompressorProcessor over WAV/AIFF/FLAC files
+ * in parallel (one processor per worker thread), streaming each file block by block so memory
+ * stays flat regardless of length.
+ *
+ *   OmbicRender [--render] --out=<dir> [--state=<plugin state blob>] [--preset=<preset.json>] [--set=<param>=<value> ...]
+ *               [--threads=N] [--format=wav|aiff|flac] [--bits=16|24|32] [--suffix=_ombic] [--block=512]
+ *               [--data=<repo root>] <file or folder> ...
+ *
+ * Parameters are applied in order: state blob (bytes from getStateInformation, e.g. saved by a host),
+ * then the JSON preset, then --set overrides. Preset values are in parameter units (dB, %, ms) or
+ * choice names, e.g. { "params": { "compressor_mode": "FET", "threshold": 40, "neon_enable": true } }.
+ * Mono and stereo inputs are supported; mono is rendered dual-mono and written back as mono.
+ * Files found in a folder argument keep their subfolder under --out; two inputs that would still render to the same
+ * file are an error.
+ */
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct RenderSettings
+{
+    juce::File outDir;
+    juce::File dataRoot;
+    juce::MemoryBlock stateBlob;
+    std::vector<std::pair<juce::String, juce::var>> params;   // preset + --set overrides, in order
+    juce::String format;     // empty = same as input
+    int bits = 0;            // 0 = same as input
+    juce::String suffix;
+    int blockSize = 512;
+};
+
+/** An input and the folder its render goes to: --out, plus the file's path below a folder argument, so equal names in
+ *  different subfolders do not overwrite each other. */
+struct InputFile
+{
+    juce::File file;
+    juce::File outDir;
+
+    bool operator==(const InputFile& o) const { return file == o.file; }
+    bool operator<(const InputFile& o) const { return file < o.file; }
+};
+
+struct FileResult
+{
+    bool ok = false;
+    juce::String message;
+    double seconds = 0.0;
+    double audioSeconds = 0.0;
+};
+
+juce::CriticalSection logLock;
+
+void logLine(const juce::String& text)
+{
+    const juce::ScopedLock sl(logLock);
+    std::fprintf(stderr, "%s\n", text.toRawUTF8());
+}
+
+//==============================================================================
+/** Set a parameter from a preset value: number in parameter units, bool, or choice name. */
+juce::String applyParam(juce::AudioProcessorValueTreeState& apvts, const juce::String& id, const juce::var& value)
+{
+    auto* param = apvts.getParameter(id);
+    if (param == nullptr)
+        return "unknown parameter '" + id + "'";
+
+    float normalised = 0.0f;
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(param); choice != nullptr && value.isString()
+        && !value.toString().containsOnly("0123456789.-"))
+    {
+        const int index = choice->choices.indexOf(value.toString(), true);
+        if (index < 0)
+            return "'" + value.toString() + "' is not a choice of " + id + " (" + choice->choices.joinIntoString(", ") + ")";
+        normalised = choice->convertTo0to1((float)index);
+    }
+    else if (value.isBool())
+        normalised = (bool)value ? 1.0f : 0.0f;
+    else
+    {
+        const auto text = value.toString().trim().toLowerCase();
+        if (text == "true" || text == "on")
+            normalised = 1.0f;
+        else if (text == "false" || text == "off")
+            normalised = 0.0f;
+        else
+            normalised = param->convertTo0to1((float)text.getDoubleValue());
+    }
+    param->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, normalised));
+    return {};
+}
+
+void loadPreset(const juce::File& file, RenderSettings& settings)
+{
+    const auto json = juce::JSON::parse(file);
+    if (!json.isObject())
+        juce::ConsoleApplication::fail("Preset is not a JSON object: " + file.getFullPathName());
+    const auto params = json.hasProperty("params") ? json["params"] : json;
+    if (auto* obj = params.getDynamicObject())
+        for (const auto& p : obj->getProperties())
+            settings.params.emplace_back(p.name.toString(), p.value);
+}
+
+//==============================================================================
+juce::AudioFormat* findOutputFormat(juce::AudioFormatManager& formats, const juce::File& input, const juce::String& requested)
+{
+    const auto ext = requested.isNotEmpty() ? "." + requested.trimCharactersAtStart(".") : input.getFileExtension();
+    if (ext.equalsIgnoreCase(".aif"))
+        return formats.findFormatForFileExtension(".aiff");
+    return formats.findFormatForFileExtension(ext);
+}
+
+int chooseBitDepth(juce::AudioFormat& format, int wanted)
+{
+    const auto depths = format.getPossibleBitDepths();
+    if (depths.contains(wanted))
+        return wanted;
+    int best = depths.isEmpty() ? 16 : depths[0];
+    for (int d : depths)
+        if (d <= wanted && d > best)
+            best = d;
+    return best;
+}
+
+/** Where input renders to; empty if there is no writer for the output format. */
+juce::File outputFileFor(juce::AudioFormatManager& formats, const InputFile& input, const RenderSettings& settings)
+{
+    auto* format = findOutputFormat(formats, input.file, settings.format);
+    if (format == nullptr)
+        return {};
+    return input.outDir.getChildFile(input.file.getFileNameWithoutExtension() + settings.suffix)
+               .withFileExtension(format->getFileExtensions()[0]);
+}
+
+FileResult renderFile(OmbicCompressorProcessor& processor, juce::AudioFormatManager& formats,
+                      const InputFile& inputFile, const RenderSettings& settings)
+{
+    const auto& input = inputFile.file;
+    FileResult result;
+    const auto t0 = juce::Time::getMillisecondCounterHiRes();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+    if (reader == nullptr)
+        return { false, "unreadable or unsupported format" };
+    const int inChannels = (int)reader->numChannels;
+    if (inChannels < 1 || inChannels > 2)
+        return { false, "only mono or stereo files are supported (" + juce::String(inChannels) + " channels)" };
+    const double sampleRate = reader->sampleRate;
+    const juce::int64 length = reader->lengthInSamples;
+
+    auto* format = findOutputFormat(formats, input, settings.format);
+    if (format == nullptr)
+        return { false, "no writer for output format" };
+    const auto outFile = outputFileFor(formats, inputFile, settings);
+    if (outFile == input)
+        return { false, "output would overwrite the input (use --suffix or another --out)" };
+
+    // Prepare (chains, profile scan, morph worker) once per sample rate; between files only the DSP history is
+    // cleared, so results do not depend on which worker rendered the previous one
+    if (processor.getSampleRate() != sampleRate)
+    {
+        processor.setPlayConfigDetails(2, 2, sampleRate, settings.blockSize);
+        processor.prepareToPlay(sampleRate, settings.blockSize);
+    }
+    else
+        processor.reset();
+    if (!processor.hasCurveDataLoaded())
+        return { false, "curve data not found (use --data=<repo root>)" };
+
+    outFile.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(outFile);
+    if (!stream->openedOk())
+        return { false, "cannot write " + outFile.getFullPathName() };
+    const int bits = chooseBitDepth(*format, settings.bits > 0 ? settings.bits : (int)reader->bitsPerSample);
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate, (unsigned int)inChannels,
+                                                                            bits, reader->metadataValues, 0));
+    if (writer == nullptr)
+        return { false, "cannot create " + format->getFormatName() + " writer (" + juce::String(bits) + " bit)" };
+    stream.release(); // owned by the writer now
+
+    juce::AudioBuffer<float> buffer(2, settings.blockSize);
+    juce::MidiBuffer midi;
+    for (juce::int64 pos = 0; pos < length; pos += settings.blockSize)
+    {
+        const int n = (int)juce::jmin((juce::int64)settings.blockSize, length - pos);
+        buffer.setSize(2, n, false, false, true);
+        reader->read(&buffer, 0, n, pos, true, true);
+        if (inChannels == 1)
+            buffer.copyFrom(1, 0, buffer, 0, 0, n);
+        processor.processBlock(buffer, midi);
+        if (!writer->writeFromAudioSampleBuffer(buffer, 0, n))
+            return { false, "write failed: " + outFile.getFullPathName() };
+    }
+    writer.reset();
+
+    result.ok = true;
+    result.message = outFile.getFullPathName();
+    result.seconds = (juce::Time::getMillisecondCounterHiRes() - t0) / 1000.0;
+    result.audioSeconds = sampleRate > 0 ? (double)length / sampleRate : 0.0;
+    return result;
+}
+
+//==============================================================================
+/** One processor per worker, created up front on the message thread and handed out to jobs. */
+class ProcessorPool
+{
+public:
+    ProcessorPool(int count, const RenderSettings& settings)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            auto p = std::make_unique<OmbicCompressorProcessor>();
+            if (settings.dataRoot != juce::File())
+                p->setCurveDataRoot(settings.dataRoot);
+            if (settings.stateBlob.getSize() > 0)
+                p->setStateInformation(settings.stateBlob.getData(), (int)settings.stateBlob.getSize());
+            for (const auto& [id, value] : settings.params)
+            {
+                const auto error = applyParam(p->getValueTreeState(), id, value);
+                if (error.isNotEmpty())
+                    juce::ConsoleApplication::fail(error);
+            }
+            free_.push_back(p.get());
+            all_.push_back(std::move(p));
+        }
+    }
+
+    OmbicCompressorProcessor* acquire()
+    {
+        const juce::ScopedLock sl(lock_);
+        if (free_.empty())
+            return nullptr;
+        auto* p = free_.back();
+        free_.pop_back();
+        return p;
+    }
+
+    void release(OmbicCompressorProcessor* p)
+    {
+        const juce::ScopedLock sl(lock_);
+        free_.push_back(p);
+    }
+
+private:
+    juce::CriticalSection lock_;
+    std::vector<std::unique_ptr<OmbicCompressorProcessor>> all_;
+    std::vector<OmbicCompressorProcessor*> free_;
+};
+
+juce::Array<InputFile> collectInputs(const juce::ArgumentList& args, const RenderSettings& settings)
+{
+    juce::Array<InputFile> files;
+    const juce::String patterns = "*.wav;*.aif;*.aiff;*.flac";
+    for (const auto& arg : args.arguments)
+    {
+        if (arg.isOption())
+            continue;
+        const auto f = arg.resolveAsFile();
+        if (f.isDirectory())
+        {
+            for (const auto& entry : juce::RangedDirectoryIterator(f, true, patterns, juce::File::findFiles))
+            {
+                const auto file = entry.getFile();
+                files.addIfNotAlreadyThere({ file, settings.outDir.getChildFile(file.getParentDirectory().getRelativePathFrom(f)) });
+            }
+        }
+        else if (f.existsAsFile())
+            files.addIfNotAlreadyThere({ f, settings.outDir });
+        else
+            juce::ConsoleApplication::fail("No such file or folder: " + arg.text);
+    }
+    files.sort();
+    return files;
+}
+
+RenderSettings parseSettings(const juce::ArgumentList& args)
+{
+    RenderSettings s;
+    if (!args.containsOption("--out"))
+        juce::ConsoleApplication::fail("Missing --out=<dir>");
+    s.outDir = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+    if (!s.outDir.createDirectory())
+        juce::ConsoleApplication::fail("Cannot create " + s.outDir.getFullPathName());
+
+    if (args.containsOption("--data"))
+        s.dataRoot = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--data"));
+    if (args.containsOption("--state"))
+    {
+        const auto stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--state"));
+        if (!stateFile.loadFileAsData(s.stateBlob))
+            juce::ConsoleApplication::fail("Cannot read state " + stateFile.getFullPathName());
+    }
+    if (args.containsOption("--preset"))
+        loadPreset(juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--preset")), s);
+    for (const auto& arg : args.arguments)
+    {
+        if (!arg.text.startsWith("--set="))
+            continue;
+        const auto assignment = arg.text.fromFirstOccurrenceOf("--set=", false, false);
+        if (!assignment.containsChar('='))
+            juce::ConsoleApplication::fail("--set expects <param>=<value>: " + arg.text);
+        s.params.emplace_back(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                              juce::var(assignment.fromFirstOccurrenceOf("=", false, false).trim()));
+    }
+
+    s.format = args.getValueForOption("--format").toLowerCase();
+    s.bits = args.getValueForOption("--bits").getIntValue();
+    s.suffix = args.getValueForOption("--suffix");
+    if (args.containsOption("--block"))
+        s.blockSize = juce::jlimit(16, 8192, args.getValueForOption("--block").getIntValue());
+    return s;
+}
+
+void runRender(const juce::ArgumentList& args)
+{
+    const auto settings = parseSettings(args);
+    const auto inputs = collectInputs(args, settings);
+    if (inputs.isEmpty())
+        juce::ConsoleApplication::fail("No input files (WAV/AIFF/FLAC)");
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    // Jobs run in parallel, so two of them must never write the same file; subfolders are created here, not racing
+    std::map<juce::File, juce::File> outputs;   // output -> input
+    for (const auto& input : inputs)
+    {
+        const auto outFile = outputFileFor(formats, input, settings);
+        if (outFile == juce::File())
+            continue;   // renderFile reports it
+        if (const auto [it, added] = outputs.emplace(outFile, input.file); !added)
+            juce::ConsoleApplication::fail("Both " + it->second.getFullPathName() + " and " + input.file.getFullPathName()
+                                           + " would render to " + outFile.getFullPathName());
+        if (!outFile.getParentDirectory().createDirectory())
+            juce::ConsoleApplication::fail("Cannot create " + outFile.getParentDirectory().getFullPathName());
+    }
+
+    int numThreads = args.containsOption("--threads") ? args.getValueForOption("--threads").getIntValue()
+                                                      : juce::SystemStats::getNumCpus();
+    numThreads = juce::jlimit(1, juce::jmax(1, inputs.size()), numThreads);
+
+    ProcessorPool processors(numThreads, settings);
+    std::vector<FileResult> results((size_t)inputs.size());
+    std::atomic<int> remaining{ inputs.size() };
+
+    logLine("Rendering " + juce::String(inputs.size()) + " file(s) on " + juce::String(numThreads) + " thread(s)");
+    const auto t0 = juce::Time::getMillisecondCounterHiRes();
+    {
+        juce::ThreadPool pool(numThreads);
+        for (int i = 0; i < inputs.size(); ++i)
+        {
+            pool.addJob([&, i] {
+                auto* processor = processors.acquire();
+                jassert(processor != nullptr); // one processor per pool thread
+                auto& r = results[(size_t)i];
+                r = renderFile(*processor, formats, inputs[i], settings);
+                processors.release(processor);
+                if (r.ok)
+                    logLine(juce::String::formatted("ok    %s  (%.1fx realtime)", inputs[i].file.getFileName().toRawUTF8(),
+                                                    r.seconds > 0 ? r.audioSeconds / r.seconds : 0.0));
+                else
+                    logLine("FAIL  " + inputs[i].file.getFullPathName() + ": " + r.message);
+                --remaining;
+                return juce::ThreadPoolJob::jobHasFinished;
+            });
+        }
+        while (remaining.load() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    int failed = 0;
+    double audioSeconds = 0.0;
+    for (const auto& r : results)
+    {
+        failed += r.ok ? 0 : 1;
+        audioSeconds += r.audioSeconds;
+    }
+    const double wall = (juce::Time::getMillisecondCounterHiRes() - t0) / 1000.0;
+    logLine(juce::String::formatted("Done: %d ok, %d failed, %.1f s audio in %.1f s", inputs.size() - failed, failed, audioSeconds, wall));
+    if (failed > 0)
+        juce::ConsoleApplication::fail(juce::String(failed) + " file(s) failed", 1);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;  // processors own APVTS timers; create them with a MessageManager present
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "OmbicRender: batch-process audio files through Ombic Compressor", false);
+    app.addDefaultCommand({ "--render",
+                     "--render --out=<dir> [--state=<blob>] [--preset=<json>] [--set=<param>=<value>] [--threads=N] "
+                     "[--format=wav|aiff|flac] [--bits=N] [--suffix=S] [--block=N] [--data=<repo root>] <files/folders...>",
+                     "Render files through the Ombic processor",
+                     "Parameters: state blob, then preset, then --set overrides. Preset values use parameter units or choice names.",
+                     runRender });
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,465 @@
+/*
+ * OmbicBenchmarks: ns/sample for every emulation class, swept over sample rate, block size,
+ * channel count and parameter extremes. Emits JSON so runs from different builds can be diffed.
+ *
+ *   OmbicBenchmarks [--data <repo root>] [--out results.json] [--quick] [--filter <class substring>]
+ *
+ * --data defaults to OMBIC_COMPRESSOR_DATA_PATH, then the working directory (needs output/fetish_v2 etc.).
+ * Curve-backed classes are skipped (and listed under "skipped") when data is missing.
+ * Built with OMBIC_STAGE_PROFILING, chain results also carry per-stage "stages" timing (StageProfiler).
+ * "memory" lists curve data bytes per data set and what one MeasuredCompressor keeps resident.
+ */
+
+#include <JuceHeader.h>
+#include "DataLoader.h"
+#include "MeasuredCompressor.h"
+#include "PwmCompressor.h"
+#include "NeonTapeSaturation.h"
+#include "IronTransformer.h"
+#include "FRCharacter.h"
+#include "THDCharacter.h"
+#include "MVPChain.h"
+#include "PwmChain.h"
+#include "StageProfiler.h"
+#include "BlockAnalysis.h"
+#include "TruePeakDetector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace
+{
+using ProcessFn = std::function<void(juce::AudioBuffer<float>&)>;
+
+struct Config
+{
+    double sampleRate;
+    int blockSize;
+    int numChannels;
+    emulation::StageProfiler* profiler = nullptr;   // chains record per-stage time here (profiling builds)
+};
+
+/** One benchmarked subject: a class + parameter variant. make() builds and prepares a fresh instance for a config. */
+struct Subject
+{
+    juce::String className;
+    juce::String variant;
+    std::function<ProcessFn(const Config&)> make;
+};
+
+struct CurveData
+{
+    juce::File fetDir, lalaDir, vcaDir;
+    std::shared_ptr<emulation::AnalyzerOutput> fet, lala, vca;
+    bool ok() const { return fet != nullptr && lala != nullptr && !fet->compression.isEmpty() && !lala->compression.isEmpty(); }
+};
+
+CurveData loadCurveData(const juce::File& root)
+{
+    CurveData d;
+    d.fetDir = root.getChildFile("output/fetish_v2");
+    d.lalaDir = root.getChildFile("output/lala_v2");
+    d.vcaDir = root.getChildFile("output/dbcomp_vca");
+    if (d.fetDir.getChildFile("compression_curve.csv").existsAsFile())
+        d.fet = std::make_shared<emulation::AnalyzerOutput>(emulation::loadAnalyzerOutput(d.fetDir));
+    if (d.lalaDir.getChildFile("compression_curve.csv").existsAsFile())
+        d.lala = std::make_shared<emulation::AnalyzerOutput>(emulation::loadAnalyzerOutput(d.lalaDir));
+    if (d.vcaDir.getChildFile("compression_curve.csv").existsAsFile())
+        d.vca = std::make_shared<emulation::AnalyzerOutput>(emulation::loadAnalyzerOutput(d.vcaDir));
+    return d;
+}
+
+//==============================================================================
+std::vector<Subject> makeSubjects(const CurveData& data)
+{
+    std::vector<Subject> s;
+
+    if (data.ok())
+    {
+        // FET grid: threshold -30..0 dB, ratio 4..20; timing params 20..800 / 50..1100
+        struct FetCase { const char* name; float threshold, ratio, attack, release; int character; };
+        for (auto c : { FetCase{ "FET min", -30.0f, 4.0f, 20.0f, 50.0f, 0 }, FetCase{ "FET max", 0.0f, 20.0f, 800.0f, 1100.0f, 1 } })
+        {
+            s.push_back({ "MeasuredCompressor", c.name, [data, c](const Config& cfg) -> ProcessFn {
+                auto comp = std::make_shared<emulation::MeasuredCompressor>(*data.fet);
+                comp->prepare(cfg.blockSize, cfg.numChannels);
+                return [comp, c, sr = cfg.sampleRate](juce::AudioBuffer<float>& b) {
+                    comp->process(b, sr, c.threshold, c.ratio, c.attack, c.release, 512, nullptr, c.character);
+                };
+            } });
+        }
+        for (bool limit : { false, true })
+        {
+            s.push_back({ "MeasuredCompressor", limit ? "Opto limit (SC shelf)" : "Opto compress (SC LPF)", [data, limit](const Config& cfg) -> ProcessFn {
+                auto comp = std::make_shared<emulation::MeasuredCompressor>(*data.lala);
+                comp->prepare(cfg.blockSize, cfg.numChannels);
+                comp->setSidechainOptoOptions(true, limit, cfg.sampleRate);
+                return [comp, sr = cfg.sampleRate](juce::AudioBuffer<float>& b) {
+                    comp->process(b, sr, 100.0f, {}, {}, {}, 512, nullptr, {});
+                };
+            } });
+        }
+
+        if (!data.fet->fr.isEmpty())
+        {
+            for (int irLength : { 64, 256, 1024 })
+            {
+                s.push_back({ "FRCharacter", "IR " + juce::String(irLength), [data, irLength](const Config& cfg) -> ProcessFn {
+                    auto fr = std::make_shared<emulation::FRCharacter>(data.fet->fr, cfg.sampleRate, std::optional<float>{}, irLength);
+                    return [fr](juce::AudioBuffer<float>& b) { fr->process(b); };
+                } });
+            }
+        }
+        if (!data.fet->thd.isEmpty())
+        {
+            for (float mix : { 0.0f, 1.0f })
+            {
+                s.push_back({ "THDCharacter", "mix " + juce::String(mix, 1), [data, mix](const Config&) -> ProcessFn {
+                    auto thd = std::make_shared<emulation::THDCharacter>(data.fet->thd, -4.0f, mix);
+                    return [thd](juce::AudioBuffer<float>& b) { thd->process(b); };
+                } });
+            }
+        }
+
+        using Mode = emulation::MVPChain::Mode;
+        struct ChainCase { const char* name; Mode mode; bool neon; float threshold; };
+        std::vector<ChainCase> chainCases{ { "FET", Mode::FET, false, -30.0f }, { "FET + neon", Mode::FET, true, -30.0f },
+                                           { "Opto", Mode::Opto, false, 100.0f }, { "Opto + neon", Mode::Opto, true, 100.0f } };
+        if (data.vca != nullptr)
+            chainCases.push_back({ "VCA", Mode::VCA, false, 3.0f });
+        for (auto c : chainCases)
+        {
+            s.push_back({ "MVPChain", c.name, [data, c](const Config& cfg) -> ProcessFn {
+                auto chain = std::make_shared<emulation::MVPChain>(c.mode, cfg.sampleRate, data.fetDir, data.lalaDir, data.vcaDir,
+                                                                   false, false, std::optional<float>{}, 1.0f, c.neon);
+                chain->prepare(cfg.blockSize, cfg.numChannels);
+                chain->setStageProfiler(cfg.profiler);
+                chain->setNeonParams(1.0f, 5000.0f, 12000.0f, 10.0f, 0.85f, 1.0f, 1.0f, false);
+                return [chain, c](juce::AudioBuffer<float>& b) {
+                    chain->process(b, c.threshold, 20.0f, 20.0f, 50.0f, 512, false, nullptr, 1);
+                };
+            } });
+        }
+    }
+
+    // PWM: threshold 0..100 %, ratio 1.5..8, speed-mapped attack 0.5..80 ms / release 30..800 ms
+    struct PwmCase { const char* name; float thresholdPct, ratio, attackMs, releaseMs; bool externalDetector; };
+    for (auto c : { PwmCase{ "min (internal HPF)", 0.0f, 1.5f, 80.0f, 800.0f, false },
+                    PwmCase{ "max (internal HPF)", 100.0f, 8.0f, 0.5f, 30.0f, false },
+                    PwmCase{ "max (external SC)", 100.0f, 8.0f, 0.5f, 30.0f, true } })
+    {
+        s.push_back({ "PwmCompressor", c.name, [c](const Config& cfg) -> ProcessFn {
+            auto pwm = std::make_shared<emulation::PwmCompressor>();
+            pwm->prepare(cfg.sampleRate, cfg.blockSize);
+            auto detector = std::make_shared<juce::AudioBuffer<float>>(1, cfg.blockSize);
+            detector->clear();
+            return [pwm, detector, c](juce::AudioBuffer<float>& b) {
+                pwm->process(b, c.thresholdPct, c.ratio, c.attackMs, c.releaseMs, c.externalDetector ? detector.get() : nullptr);
+            };
+        } });
+    }
+    for (bool neon : { false, true })
+    {
+        s.push_back({ "PwmChain", neon ? "neon on" : "neon off", [neon](const Config& cfg) -> ProcessFn {
+            auto chain = std::make_shared<emulation::PwmChain>(cfg.sampleRate, neon);
+            chain->prepare(cfg.sampleRate, cfg.blockSize);
+            chain->setStageProfiler(cfg.profiler);
+            return [chain](juce::AudioBuffer<float>& b) { chain->process(b, 100.0f, 8.0f, 0.5f, 30.0f, nullptr); };
+        } });
+    }
+
+    struct NeonCase { const char* name; float depth, burstiness, intensity; bool satAfter; };
+    for (auto c : { NeonCase{ "min", 0.0f, 0.0f, 0.0f, false }, NeonCase{ "max (bursty, sat after)", 1.0f, 10.0f, 1.0f, true } })
+    {
+        s.push_back({ "NeonTapeSaturation", c.name, [c](const Config& cfg) -> ProcessFn {
+            auto neon = std::make_shared<emulation::NeonTapeSaturation>(cfg.sampleRate);
+            neon->setDepth(c.depth);
+            neon->setBurstiness(c.burstiness);
+            neon->setSaturationIntensity(c.intensity);
+            neon->setSaturationAfter(c.satAfter);
+            return [neon](juce::AudioBuffer<float>& b) { neon->process(b); };
+        } });
+    }
+
+    // Processor metering: input level + sidechain mono sum (and output level + scope capture) in one pass
+    s.push_back({ "BlockAnalysis", "analyse + mix", [](const Config& cfg) -> ProcessFn {
+        auto mix = std::make_shared<std::vector<float>>(static_cast<size_t>(cfg.blockSize));
+        auto levels = std::make_shared<std::vector<emulation::ChannelLevel>>(static_cast<size_t>(cfg.numChannels));
+        return [mix, levels](juce::AudioBuffer<float>& b) { emulation::analyseAndMix(b, levels->data(), mix->data()); };
+    } });
+
+    s.push_back({ "TruePeakDetector", "4x BS.1770", [](const Config& cfg) -> ProcessFn {
+        auto tp = std::make_shared<emulation::TruePeakDetector>();
+        tp->prepare(cfg.blockSize, cfg.numChannels);
+        return [tp](juce::AudioBuffer<float>& b) {
+            for (int ch = 0; ch < b.getNumChannels(); ++ch)
+                tp->processChannel(ch, b.getReadPointer(ch), b.getNumSamples());
+        };
+    } });
+
+    struct IronCase { const char* name; int mode; float amount; };
+    for (auto c : { IronCase{ "Opto 5%", 0, 0.05f }, IronCase{ "FET 100%", 1, 1.0f }, IronCase{ "PWM 100%", 2, 1.0f } })
+    {
+        s.push_back({ "IronTransformer", c.name, [c](const Config& cfg) -> ProcessFn {
+            auto iron = std::make_shared<emulation::IronTransformer>();
+            iron->prepare(cfg.sampleRate);
+            return [iron, c](juce::AudioBuffer<float>& b) { iron->process(b, c.mode, c.amount); };
+        } });
+    }
+    return s;
+}
+
+//==============================================================================
+/** Programme-like input (tones + noise with a level envelope) rendered once per config. */
+juce::AudioBuffer<float> makeSource(const Config& cfg, int numSamples)
+{
+    juce::AudioBuffer<float> src(cfg.numChannels, numSamples);
+    juce::Random rng(42);
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double t = i / cfg.sampleRate;
+        const float env = 0.05f + 0.95f * (float)(0.5 + 0.5 * std::sin(twoPi * 3.0 * t));
+        for (int ch = 0; ch < cfg.numChannels; ++ch)
+        {
+            const float x = 0.5f * (float)std::sin(twoPi * (110.0 + 30.0 * ch) * t) + 0.2f * (float)std::sin(twoPi * 2500.0 * t)
+                          + 0.05f * (rng.nextFloat() * 2.0f - 1.0f);
+            src.setSample(ch, i, env * x);
+        }
+    }
+    return src;
+}
+
+struct Timing
+{
+    double minNsPerSample = 0.0;
+    double medianNsPerSample = 0.0;
+};
+
+/** Runs `process` over the whole source block by block (refilling each block from the source), `repeats` times after one warm-up pass. */
+Timing timeRuns(const ProcessFn& process, const juce::AudioBuffer<float>& source, int blockSize, int repeats)
+{
+    juce::ScopedNoDenormals noDenormals;
+    const int numChannels = source.getNumChannels();
+    const int total = source.getNumSamples();
+    juce::AudioBuffer<float> work(numChannels, blockSize);
+    std::vector<double> nsPerSample;
+
+    for (int r = 0; r <= repeats; ++r)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int start = 0; start + blockSize <= total; start += blockSize)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                work.copyFrom(ch, 0, source, ch, start, blockSize);
+            if (process)
+                process(work);
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        if (r == 0)
+            continue; // warm-up
+        const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        nsPerSample.push_back(ns / (double)((total / blockSize) * blockSize));
+    }
+    std::sort(nsPerSample.begin(), nsPerSample.end());
+    return { nsPerSample.front(), nsPerSample[nsPerSample.size() / 2] };
+}
+
+/** Per-stage block times (ns) from the profiler, or void when nothing was recorded. */
+juce::var makeStageStats(const emulation::StageProfiler& profiler)
+{
+    auto* o = new juce::DynamicObject();
+    bool any = false;
+    for (int s = 0; s < emulation::StageProfiler::kNumStages; ++s)
+    {
+        const auto stage = static_cast<emulation::StageProfiler::Stage>(s);
+        const auto st = profiler.getStats(stage);
+        if (st.blocks == 0)
+            continue;
+        auto* so = new juce::DynamicObject();
+        so->setProperty("blocks", st.blocks);
+        so->setProperty("min_ns", st.minNs);
+        so->setProperty("avg_ns", st.avgNs);
+        so->setProperty("p99_ns", st.p99Ns);
+        so->setProperty("max_ns", st.maxNs);
+        so->setProperty("ns_per_sample", st.avgNsPerSample);
+        o->setProperty(emulation::StageProfiler::getStageName(stage), juce::var(so));
+        any = true;
+    }
+    return any ? juce::var(o) : juce::var();
+}
+
+juce::var makeResult(const Subject& subject, const Config& cfg, const Timing& t, double baselineNs,
+                     const emulation::StageProfiler& profiler)
+{
+    auto* o = new juce::DynamicObject();
+    o->setProperty("class", subject.className);
+    o->setProperty("variant", subject.variant);
+    o->setProperty("sample_rate", cfg.sampleRate);
+    o->setProperty("block_size", cfg.blockSize);
+    o->setProperty("channels", cfg.numChannels);
+    o->setProperty("ns_per_sample", t.minNsPerSample);
+    o->setProperty("ns_per_sample_median", t.medianNsPerSample);
+    o->setProperty("ns_per_channel_sample", t.minNsPerSample / cfg.numChannels);
+    // Cost of the per-block refill from the source buffer at this config (included in ns_per_sample)
+    o->setProperty("baseline_copy_ns_per_sample", baselineNs);
+    // How many instances fit in real time on one core
+    o->setProperty("realtime_factor", t.minNsPerSample > 0.0 ? (1.0e9 / cfg.sampleRate) / t.minNsPerSample : 0.0);
+    const auto stages = makeStageStats(profiler);
+    if (!stages.isVoid())
+        o->setProperty("stages", stages);
+    return juce::var(o);
+}
+
+juce::var makeBuildInfo()
+{
+    auto* o = new juce::DynamicObject();
+#if defined(NDEBUG)
+    o->setProperty("config", "Release");
+#else
+    o->setProperty("config", "Debug");
+#endif
+#if defined(__clang__)
+    o->setProperty("compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+    o->setProperty("compiler", "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+    o->setProperty("compiler", "msvc " + juce::String(_MSC_VER));
+#endif
+    o->setProperty("juce", juce::SystemStats::getJUCEVersion());
+    o->setProperty("cpu", juce::SystemStats::getCpuModel());
+    o->setProperty("cpu_cores", juce::SystemStats::getNumPhysicalCpus());
+    o->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    return juce::var(o);
+}
+
+/** Curve data memory per data set: the loaded tables (one arena, freed once consumers are built), the same rows as
+ *  structs of std::optional<float> fields (the layout before the column store; each MeasuredCompressor used to keep
+ *  a copy), and what a prepared MeasuredCompressor keeps resident. */
+juce::var makeMemoryStats(const CurveData& data)
+{
+    auto* o = new juce::DynamicObject();
+    auto add = [o](const char* name, const std::shared_ptr<emulation::AnalyzerOutput>& set) {
+        if (set == nullptr)
+            return;
+        size_t rowLayoutBytes = 0;
+        for (const auto* t : { &set->compression, &set->timing, &set->fr, &set->thd })
+            rowLayoutBytes += static_cast<size_t>(t->numRows) * static_cast<size_t>(t->numColumns) * sizeof(std::optional<float>);
+        emulation::MeasuredCompressor comp(*set);
+        comp.prepare(512, 2);
+
+        auto* so = new juce::DynamicObject();
+        so->setProperty("compression_rows", set->compression.numRows);
+        so->setProperty("timing_rows", set->timing.numRows);
+        so->setProperty("data_set_bytes", (juce::int64)set->getMemoryBytes());
+        so->setProperty("row_layout_bytes", (juce::int64)rowLayoutBytes);
+        so->setProperty("compressor_instance_bytes", (juce::int64)comp.getMemoryBytes());
+        o->setProperty(name, juce::var(so));
+        std::fprintf(stderr, "%-12s data set %8zu B (as optional rows %8zu B), MeasuredCompressor resident %8zu B\n",
+                     name, set->getMemoryBytes(), rowLayoutBytes, comp.getMemoryBytes());
+    };
+    add("fetish_v2", data.fet);
+    add("lala_v2", data.lala);
+    add("dbcomp_vca", data.vca);
+    return juce::var(o);
+}
+
+juce::File resolveDataRoot(const juce::ArgumentList& args)
+{
+    if (args.containsOption("--data"))
+        return args.getExistingFolderForOption("--data");
+    const auto env = juce::SystemStats::getEnvironmentVariable("OMBIC_COMPRESSOR_DATA_PATH", {});
+    return env.isNotEmpty() ? juce::File::getCurrentWorkingDirectory().getChildFile(env)
+                            : juce::File::getCurrentWorkingDirectory();
+}
+
+void runBenchmarks(const juce::ArgumentList& args)
+{
+    const bool quick = args.containsOption("--quick");
+    const auto filter = args.getValueForOption("--filter");
+
+    std::vector<double> sampleRates{ 44100.0, 48000.0, 96000.0, 192000.0 };
+    std::vector<int> blockSizes{ 16, 64, 256, 1024, 4096 };
+    std::vector<int> channelCounts{ 1, 2 };
+    int repeats = 5;
+    double secondsPerRun = 0.25;
+    if (quick)
+    {
+        sampleRates = { 48000.0 };
+        blockSizes = { 64, 512 };
+        channelCounts = { 2 };
+        repeats = 3;
+        secondsPerRun = 0.1;
+    }
+
+    const auto data = loadCurveData(resolveDataRoot(args));
+    juce::Array<juce::var> results, skipped;
+    if (!data.ok())
+        skipped.add("MeasuredCompressor, FRCharacter, THDCharacter, MVPChain: curve data not found (use --data <repo root>)");
+
+    auto subjects = makeSubjects(data);
+    if (filter.isNotEmpty())
+        subjects.erase(std::remove_if(subjects.begin(), subjects.end(),
+                                      [&](const Subject& s) { return !s.className.containsIgnoreCase(filter); }),
+                       subjects.end());
+
+    emulation::StageProfiler profiler;
+    for (double sr : sampleRates)
+        for (int ch : channelCounts)
+            for (int bs : blockSizes)
+            {
+                const Config cfg{ sr, bs, ch, &profiler };
+                const int numSamples = juce::jmax(bs * 8, (int)(sr * secondsPerRun));
+                const auto source = makeSource(cfg, numSamples);
+                const double baselineNs = timeRuns(nullptr, source, bs, repeats).minNsPerSample;
+                for (const auto& subject : subjects)
+                {
+                    const auto process = subject.make(cfg);
+                    profiler.reset();
+                    const auto t = timeRuns(process, source, bs, repeats);
+                    results.add(makeResult(subject, cfg, t, baselineNs, profiler));
+                    std::fprintf(stderr, "%-20s %-26s sr=%-6d block=%-5d ch=%d  %8.2f ns/sample\n",
+                                 subject.className.toRawUTF8(), subject.variant.toRawUTF8(), (int)sr, bs, ch, t.minNsPerSample);
+                }
+            }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("tool", "OmbicBenchmarks");
+    root->setProperty("schema_version", 2);   // 2: copy baseline per result instead of one 48 kHz / 512 figure
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("build", makeBuildInfo());
+    root->setProperty("quick", quick);
+    root->setProperty("stage_profiling", emulation::StageProfiler::isEnabled());
+    root->setProperty("skipped", skipped);
+    root->setProperty("memory", makeMemoryStats(data));
+    root->setProperty("results", results);
+    const auto json = juce::JSON::toString(juce::var(root));
+
+    if (args.containsOption("--out"))
+    {
+        const auto outFile = args.getFileForOption("--out");
+        if (!outFile.replaceWithText(json))
+            juce::ConsoleApplication::fail("Could not write " + outFile.getFullPathName());
+        std::fprintf(stderr, "Wrote %s\n", outFile.getFullPathName().toRawUTF8());
+    }
+    else
+        std::printf("%s\n", json.toRawUTF8());
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addDefaultCommand({ "",
+                            "[--data <repo root>] [--out results.json] [--quick] [--filter <class>]",
+                            "Benchmark every emulation class and print JSON results",
+                            {},
+                            runBenchmarks });
+    app.addHelpCommand("--help|-h", "Usage:", false);
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,512 @@
+/*
+ * OmbicCurveCompiler: turns an analyzer output directory (sparse, irregular captures) into a dense, uniform one the
+ * plugin can interpolate directly.
+ *
+ *   OmbicCurveCompiler <analyzer output dir> --out <dir> [--param-scale N] [--input-step dB]
+ *
+ * compression_curve.csv: curves are grouped per (threshold, ratio, attack_ms, release_ms) and placed on the measured
+ * lattice (holes take the nearest measured curve, as at runtime). The surface is then fitted with a separable
+ * monotone cubic (PCHIP) along every measured axis and resampled onto uniform axes: N times as many intervals on each
+ * parameter axis (default 2) and --input-step dB on the input axis (default 1).
+ * timing.csv: rows flagged measurement_ok False or missing a value are dropped, grid holes filled from the nearest
+ * usable row, and the grid resampled the same way. Without usable rows no timing.csv is written (the plugin then
+ * uses the knob values, as it does for the raw data).
+ * frequency_response.csv and thd_vs_level.json are copied; manifest.json gains a "compiled" entry.
+ *
+ * The output has the analyzer schema, so OMBIC_COMPRESSOR_DATA_PATH (or the packaged output/ folders) can point at it
+ * unchanged. compile_report.json records what was filled and dropped, validation warnings, and the error of the
+ * compiled table at every measured point, interpolated exactly as the plugin does. Exits 1 if there is no curve data.
+ */
+
+#include <JuceHeader.h>
+#include "DataLoader.h"
+#include "CurveLattice.h"
+#include "TimingTable.h"
+#include "MonotoneCubic.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+using emulation::CurveLattice;
+
+const char* const kAxisNames[] = { "threshold", "ratio", "attack_ms", "release_ms", "input_db" };
+constexpr size_t kNumLatticeAxes = CurveLattice::NumParamAxes + 1;
+
+/** Values on a rectangular grid, last axis fastest. */
+struct Grid
+{
+    std::vector<std::vector<float>> axes;
+    std::vector<float> values;
+
+    size_t stride(size_t axis) const
+    {
+        size_t s = 1;
+        for (size_t a = axis + 1; a < axes.size(); ++a)
+            s *= axes[a].size();
+        return s;
+    }
+};
+
+/** n - 1 intervals become (n - 1) * scale, evenly spaced over the same range. Single values stay as they are. */
+std::vector<float> uniformAxis(const std::vector<float>& measured, int numPoints)
+{
+    if (measured.size() < 2 || numPoints < 2)
+        return measured;
+    std::vector<float> axis(static_cast<size_t>(numPoints));
+    const float lo = measured.front(), hi = measured.back();
+    for (int i = 0; i < numPoints; ++i)
+        axis[static_cast<size_t>(i)] = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(numPoints - 1);
+    return axis;
+}
+
+/** Refit every line of the grid along one axis with a monotone cubic and sample it at newAxis. */
+Grid resampleAxis(const Grid& grid, size_t axis, const std::vector<float>& newAxis)
+{
+    const size_t n = grid.axes[axis].size(), inner = grid.stride(axis);
+    const size_t outer = grid.values.size() / (n * inner);
+    Grid out;
+    out.axes = grid.axes;
+    out.axes[axis] = newAxis;
+    out.values.resize(outer * newAxis.size() * inner);
+
+    std::vector<float> line(n);
+    emulation::MonotoneCubic fit;
+    for (size_t o = 0; o < outer; ++o)
+        for (size_t i = 0; i < inner; ++i)
+        {
+            for (size_t k = 0; k < n; ++k)
+                line[k] = grid.values[(o * n + k) * inner + i];
+            fit.fit(grid.axes[axis], line);
+            for (size_t k = 0; k < newAxis.size(); ++k)
+                out.values[(o * newAxis.size() + k) * inner + i] = fit(newAxis[k]);
+        }
+    return out;
+}
+
+/** Largest second derivative along an axis (divided differences), for the linear interpolation error bound
+ *  M2 / 8 * spacing^2 (docs/CURVE_GRID_SAMPLING_THEORY.md, section 3). */
+float maxSecondDerivative(const Grid& grid, size_t axis)
+{
+    const auto& x = grid.axes[axis];
+    const size_t n = x.size(), inner = grid.stride(axis);
+    if (n < 3)
+        return 0.0f;
+    const size_t outer = grid.values.size() / (n * inner);
+    float m2 = 0.0f;
+    for (size_t o = 0; o < outer; ++o)
+        for (size_t i = 0; i < inner; ++i)
+            for (size_t k = 1; k + 1 < n; ++k)
+            {
+                auto y = [&](size_t j) { return grid.values[(o * n + j) * inner + i]; };
+                const float d0 = (y(k) - y(k - 1)) / (x[k] - x[k - 1]);
+                const float d1 = (y(k + 1) - y(k)) / (x[k + 1] - x[k]);
+                m2 = juce::jmax(m2, std::abs(2.0f * (d1 - d0) / (x[k + 1] - x[k - 1])));
+            }
+    return m2;
+}
+
+float maxSpacing(const std::vector<float>& axis)
+{
+    float d = 0.0f;
+    for (size_t i = 1; i < axis.size(); ++i)
+        d = juce::jmax(d, axis[i] - axis[i - 1]);
+    return d;
+}
+
+/** Multi-index of flat grid position `index`. */
+std::vector<size_t> unflatten(const Grid& grid, size_t index)
+{
+    std::vector<size_t> at(grid.axes.size());
+    for (size_t a = grid.axes.size(); a-- > 0;)
+    {
+        at[a] = index % grid.axes[a].size();
+        index /= grid.axes[a].size();
+    }
+    return at;
+}
+
+/** The lattice exactly as the runtime builds it (nearest-curve hole fill, uniform input grid), as a grid. */
+Grid latticeGrid(const CurveLattice& lattice)
+{
+    Grid grid;
+    size_t total = 1;
+    for (size_t a = 0; a < kNumLatticeAxes; ++a)
+    {
+        grid.axes.push_back(lattice.getAxisValues(static_cast<int>(a)));
+        total *= grid.axes.back().size();
+    }
+    grid.values.resize(total);
+    for (size_t i = 0; i < total; ++i)
+    {
+        const auto at = unflatten(grid, i);
+        CurveLattice::Key key{};
+        for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+            key[a] = grid.axes[a][at[a]];
+        grid.values[i] = lattice.evaluate(key, grid.axes[CurveLattice::NumParamAxes][at[CurveLattice::NumParamAxes]]);
+    }
+    return grid;
+}
+
+/** Curves keyed by parameters, for CurveLattice::build (so the compiled table is evaluated by the runtime code). */
+std::map<CurveLattice::Key, CurveLattice::Curve> gridCurves(const Grid& grid)
+{
+    std::map<CurveLattice::Key, CurveLattice::Curve> curves;
+    const auto& inputAxis = grid.axes[CurveLattice::NumParamAxes];
+    for (size_t start = 0; start < grid.values.size(); start += inputAxis.size())
+    {
+        const auto at = unflatten(grid, start);
+        CurveLattice::Key key{};
+        for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+            key[a] = grid.axes[a][at[a]];
+        curves[key] = { inputAxis, std::vector<float>(grid.values.begin() + (std::ptrdiff_t)start,
+                                                       grid.values.begin() + (std::ptrdiff_t)(start + inputAxis.size())) };
+    }
+    return curves;
+}
+
+struct ErrorStats
+{
+    double maxAbs = 0.0, sumSq = 0.0;
+    int count = 0;
+    CurveLattice::Key worstKey{};
+    float worstInput = 0.0f;
+
+    void add(double error, const CurveLattice::Key& key, float input)
+    {
+        if (std::abs(error) > maxAbs) { maxAbs = std::abs(error); worstKey = key; worstInput = input; }
+        sumSq += error * error;
+        ++count;
+    }
+
+    juce::var toVar() const
+    {
+        auto* o = new juce::DynamicObject();
+        o->setProperty("points", count);
+        o->setProperty("max_abs_db", maxAbs);
+        o->setProperty("rms_db", count > 0 ? std::sqrt(sumSq / count) : 0.0);
+        auto* at = new juce::DynamicObject();
+        for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+            at->setProperty(kAxisNames[a], worstKey[a]);
+        at->setProperty("input_db", worstInput);
+        o->setProperty("worst_at", juce::var(at));
+        return juce::var(o);
+    }
+};
+
+juce::var axisInfo(const std::vector<float>& axis)
+{
+    auto* o = new juce::DynamicObject();
+    o->setProperty("points", (int)axis.size());
+    o->setProperty("min", axis.empty() ? 0.0f : axis.front());
+    o->setProperty("max", axis.empty() ? 0.0f : axis.back());
+    o->setProperty("max_spacing", maxSpacing(axis));
+    return juce::var(o);
+}
+
+std::string formatValue(float v)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", (double)v);
+    return buf;
+}
+
+//==============================================================================
+struct Options
+{
+    juce::File source, out;
+    int paramScale = 2;
+    float inputStepDb = 1.0f;
+};
+
+/** Ends the run after a failed write, removing the compiled compression_curve.csv so profile discovery does not pick
+ *  up a half-written output directory. */
+void failWrite(const Options& opt, const juce::File& file)
+{
+    opt.out.getChildFile("compression_curve.csv").deleteFile();
+    juce::ConsoleApplication::fail("Could not write " + file.getFullPathName());
+}
+
+/** Compile compression_curve.csv; fills the "compression" report object. Returns false if there is no curve data. */
+bool compileCompression(const emulation::ColumnTable& table, const Options& opt, juce::DynamicObject& report,
+                        juce::StringArray& warnings)
+{
+    using namespace emulation::CompressionColumn;
+    const auto measured = CurveLattice::groupCurves(table);
+    if (measured.empty())
+        return false;
+
+    // Validation: non-finite values, curves whose gain reduction falls as the input rises
+    int nonFinite = 0, nonMonotoneCurves = 0;
+    for (int c = 0; c < table.numColumns; ++c)
+        for (int r = 0; r < table.numRows; ++r)
+            if (table.has(c, r) && !std::isfinite(table.column(c)[r]))
+                ++nonFinite;
+    for (const auto& [key, curve] : measured)
+        for (size_t i = 1; i < curve.second.size(); ++i)
+            if (curve.second[i] < curve.second[i - 1] - 0.05f) { ++nonMonotoneCurves; break; }
+    if (nonFinite > 0)
+        warnings.add(juce::String(nonFinite) + " non-finite values in compression_curve.csv");
+    if (nonMonotoneCurves > 0)
+        warnings.add(juce::String(nonMonotoneCurves) + " curves lose more than 0.05 dB of gain reduction as the input rises");
+
+    CurveLattice raw;
+    raw.build(measured);
+    Grid grid = latticeGrid(raw);
+    size_t paramNodes = 1;
+    for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+        paramNodes *= grid.axes[a].size();
+
+    // Smooth fit + uniform resample, one axis at a time
+    Grid dense = grid;
+    for (size_t a = 0; a < kNumLatticeAxes; ++a)
+    {
+        const auto& axis = grid.axes[a];
+        if (axis.size() < 2)
+            continue;
+        const int points = a < CurveLattice::NumParamAxes
+            ? (int)(axis.size() - 1) * opt.paramScale + 1
+            : juce::jmax(2, (int)std::lround((axis.back() - axis.front()) / opt.inputStepDb) + 1);
+        dense = resampleAxis(dense, a, uniformAxis(axis, points));
+    }
+
+    CurveLattice compiled;
+    compiled.build(gridCurves(dense));
+
+    // Error at every measured row, with the runtime's own lookup on the raw and on the compiled lattice
+    ErrorStats rawError, compiledError;
+    for (int r = 0; r < table.numRows; ++r)
+    {
+        const CurveLattice::Key key{ table.column(Threshold)[r], table.column(Ratio)[r],
+                                     table.column(AttackMs)[r], table.column(ReleaseMs)[r] };
+        const float input = table.column(InputDb)[r], measuredGr = table.column(GainReductionDb)[r];
+        rawError.add((double)raw.evaluate(key, input) - measuredGr, key, input);
+        compiledError.add((double)compiled.evaluate(key, input) - measuredGr, key, input);
+    }
+    // How far the smooth fit moves from linear interpolation of the measured lattice
+    double departure = 0.0;
+    for (size_t i = 0; i < dense.values.size(); ++i)
+    {
+        const auto at = unflatten(dense, i);
+        CurveLattice::Key key{};
+        for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+            key[a] = dense.axes[a][at[a]];
+        departure = juce::jmax(departure, std::abs((double)dense.values[i]
+                               - raw.evaluate(key, dense.axes[CurveLattice::NumParamAxes][at[CurveLattice::NumParamAxes]])));
+    }
+
+    // Write the table: parameter columns only where the source had them
+    std::array<bool, CurveLattice::NumParamAxes> hasColumn{};
+    const int columnOf[] = { Threshold, Ratio, AttackMs, ReleaseMs };
+    for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+        for (int r = 0; r < table.numRows && !hasColumn[a]; ++r)
+            hasColumn[a] = table.has(columnOf[a], r);
+    std::string csv = "input_db,output_db,gain_reduction_db";
+    for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+        if (hasColumn[a])
+            csv += std::string(",") + kAxisNames[a];
+    csv += "\n";
+    for (size_t i = 0; i < dense.values.size(); ++i)
+    {
+        const auto at = unflatten(dense, i);
+        const float input = dense.axes[CurveLattice::NumParamAxes][at[CurveLattice::NumParamAxes]];
+        csv += formatValue(input) + "," + formatValue(input - dense.values[i]) + "," + formatValue(dense.values[i]);
+        for (size_t a = 0; a < CurveLattice::NumParamAxes; ++a)
+            if (hasColumn[a])
+                csv += "," + formatValue(dense.axes[a][at[a]]);
+        csv += "\n";
+    }
+    if (const auto outFile = opt.out.getChildFile("compression_curve.csv"); !outFile.replaceWithData(csv.data(), csv.size()))
+        failWrite(opt, outFile);
+
+    auto* rawAxes = new juce::DynamicObject();
+    auto* compiledAxes = new juce::DynamicObject();
+    auto* bounds = new juce::DynamicObject();
+    for (size_t a = 0; a < kNumLatticeAxes; ++a)
+    {
+        rawAxes->setProperty(kAxisNames[a], axisInfo(grid.axes[a]));
+        compiledAxes->setProperty(kAxisNames[a], axisInfo(dense.axes[a]));
+        const float m2 = maxSecondDerivative(grid, a);
+        if (m2 <= 0.0f)
+            continue;
+        auto* b = new juce::DynamicObject();
+        b->setProperty("raw_db", m2 / 8.0f * std::pow(maxSpacing(grid.axes[a]), 2.0f));
+        b->setProperty("compiled_db", m2 / 8.0f * std::pow(maxSpacing(dense.axes[a]), 2.0f));
+        bounds->setProperty(kAxisNames[a], juce::var(b));
+    }
+    report.setProperty("rows", table.numRows);
+    report.setProperty("measured_curves", (int)measured.size());
+    report.setProperty("lattice_curves", (int)paramNodes);
+    report.setProperty("holes_filled", (int)(paramNodes - measured.size()));
+    report.setProperty("non_finite_values", nonFinite);
+    report.setProperty("non_monotone_curves", nonMonotoneCurves);
+    report.setProperty("raw_axes", juce::var(rawAxes));
+    report.setProperty("compiled_axes", juce::var(compiledAxes));
+    report.setProperty("compiled_rows", (int)dense.values.size());
+    report.setProperty("error_raw_lattice", rawError.toVar());
+    report.setProperty("error_compiled", compiledError.toVar());
+    report.setProperty("max_departure_from_linear_db", departure);
+    report.setProperty("linear_error_bound", juce::var(bounds));
+    return true;
+}
+
+/** Compile timing.csv; fills the "timing" report object. */
+void compileTiming(const emulation::ColumnTable& table, const Options& opt, juce::DynamicObject& report,
+                   juce::StringArray& warnings)
+{
+    using namespace emulation::TimingColumn;
+    int failed = 0, incomplete = 0;
+    std::set<std::pair<float, float>> usablePositions;
+    for (int r = 0; r < table.numRows; ++r)
+    {
+        if (table.get(MeasurementOk, r).value_or(1.0f) == 0.0f) { ++failed; continue; }
+        if (!table.has(AttackParam, r) || !table.has(ReleaseParam, r) || !table.has(AttackTimeMs, r) || !table.has(ReleaseTimeMs, r))
+        {
+            ++incomplete;
+            continue;
+        }
+        usablePositions.insert({ table.column(AttackParam)[r], table.column(ReleaseParam)[r] });
+    }
+    report.setProperty("rows", table.numRows);
+    report.setProperty("dropped_failed", failed);
+    report.setProperty("dropped_incomplete", incomplete);
+    report.setProperty("usable", (int)usablePositions.size());
+
+    const auto outFile = opt.out.getChildFile("timing.csv");
+    emulation::TimingTable timing;
+    timing.build(table);
+    if (timing.isEmpty())
+    {
+        outFile.deleteFile();
+        report.setProperty("written", false);
+        if (table.numRows > 0)
+            warnings.add("timing.csv: no usable rows (all failed or incomplete); knob values will be used as times");
+        return;
+    }
+
+    // Two grids (attack ms, release ms) on the knob axes, filled as the runtime fills them, then resampled
+    std::array<Grid, 2> grids;
+    for (auto& g : grids)
+        g.axes = { timing.getAttackParams(), timing.getReleaseParams() };
+    for (float a : timing.getAttackParams())
+        for (float r : timing.getReleaseParams())
+        {
+            const auto [attackMs, releaseMs] = timing.lookup(a, r);
+            grids[0].values.push_back(attackMs);
+            grids[1].values.push_back(releaseMs);
+        }
+    const auto rawAxes = grids[0].axes;
+    for (size_t axis = 0; axis < 2; ++axis)
+    {
+        const auto& values = rawAxes[axis];
+        const auto dense = uniformAxis(values, (int)(values.size() - 1) * opt.paramScale + 1);
+        for (auto& g : grids)
+            if (values.size() > 1)
+                g = resampleAxis(g, axis, dense);
+    }
+
+    std::string csv = "attack_param,release_param,attack_time_ms,release_time_ms,measurement_ok\n";
+    const auto& attackAxis = grids[0].axes[0];
+    const auto& releaseAxis = grids[0].axes[1];
+    for (size_t i = 0; i < attackAxis.size(); ++i)
+        for (size_t j = 0; j < releaseAxis.size(); ++j)
+        {
+            const size_t k = i * releaseAxis.size() + j;
+            csv += formatValue(attackAxis[i]) + "," + formatValue(releaseAxis[j]) + "," + formatValue(grids[0].values[k])
+                 + "," + formatValue(grids[1].values[k]) + ",True\n";
+        }
+    if (!outFile.replaceWithData(csv.data(), csv.size()))
+        failWrite(opt, outFile);
+
+    const size_t nodes = rawAxes[0].size() * rawAxes[1].size();
+    report.setProperty("written", true);
+    report.setProperty("grid", juce::String((int)rawAxes[0].size()) + "x" + juce::String((int)rawAxes[1].size()));
+    report.setProperty("holes_filled", (int)(nodes - usablePositions.size()));
+    report.setProperty("compiled_grid", juce::String((int)attackAxis.size()) + "x" + juce::String((int)releaseAxis.size()));
+}
+
+void runCompiler(const juce::ArgumentList& args)
+{
+    Options opt;
+    if (args.size() < 1 || args[0].isOption())
+        juce::ConsoleApplication::fail("Usage: OmbicCurveCompiler <analyzer output dir> --out <dir> [--param-scale N] [--input-step dB]");
+    opt.source = args[0].resolveAsExistingFolder();
+    opt.out = args.getFileForOption("--out");
+    if (args.containsOption("--param-scale"))
+        opt.paramScale = juce::jlimit(1, 64, args.getValueForOption("--param-scale").getIntValue());
+    if (args.containsOption("--input-step"))
+        opt.inputStepDb = juce::jmax(0.01f, args.getValueForOption("--input-step").getFloatValue());
+    if (opt.out == opt.source)
+        juce::ConsoleApplication::fail("--out must differ from the source directory");
+    if (!opt.out.createDirectory())
+        juce::ConsoleApplication::fail("Could not create " + opt.out.getFullPathName());
+
+    const auto data = emulation::loadAnalyzerOutput(opt.source);
+    juce::StringArray warnings;
+    auto* compression = new juce::DynamicObject();
+    auto* timing = new juce::DynamicObject();
+    juce::var compressionVar(compression), timingVar(timing);
+    if (!compileCompression(data.compression, opt, *compression, warnings))
+        juce::ConsoleApplication::fail("No compression curves in " + opt.source.getFullPathName());
+    compileTiming(data.timing, opt, *timing, warnings);
+
+    for (const char* name : { "frequency_response.csv", "thd_vs_level.json" })
+        if (opt.source.getChildFile(name).existsAsFile())
+            opt.source.getChildFile(name).copyFileTo(opt.out.getChildFile(name));
+
+    auto manifest = juce::JSON::parse(opt.source.getChildFile("manifest.json"));
+    if (!manifest.isObject())
+        manifest = juce::var(new juce::DynamicObject());
+    auto* compiled = new juce::DynamicObject();
+    compiled->setProperty("tool", "OmbicCurveCompiler");
+    compiled->setProperty("source", opt.source.getFullPathName());
+    compiled->setProperty("param_scale", opt.paramScale);
+    compiled->setProperty("input_step_db", opt.inputStepDb);
+    manifest.getDynamicObject()->setProperty("compiled", juce::var(compiled));
+    if (const auto manifestFile = opt.out.getChildFile("manifest.json"); !manifestFile.replaceWithText(juce::JSON::toString(manifest)))
+        failWrite(opt, manifestFile);
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("tool", "OmbicCurveCompiler");
+    root->setProperty("schema_version", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("source", opt.source.getFullPathName());
+    root->setProperty("param_scale", opt.paramScale);
+    root->setProperty("input_step_db", opt.inputStepDb);
+    root->setProperty("compression", compressionVar);
+    root->setProperty("timing", timingVar);
+    juce::Array<juce::var> warningList;
+    for (const auto& w : warnings)
+        warningList.add(w);
+    root->setProperty("warnings", warningList);
+    if (const auto reportFile = opt.out.getChildFile("compile_report.json"); !reportFile.replaceWithText(juce::JSON::toString(juce::var(root))))
+        failWrite(opt, reportFile);
+
+    std::fprintf(stderr, "%s -> %s: %d curves (%d holes filled) -> %d rows; max error at measured points %.3f dB (raw lattice %.3f dB)\n",
+                 opt.source.getFileName().toRawUTF8(), opt.out.getFullPathName().toRawUTF8(),
+                 (int)compression->getProperty("measured_curves"), (int)compression->getProperty("holes_filled"),
+                 (int)compression->getProperty("compiled_rows"),
+                 (double)compression->getProperty("error_compiled")["max_abs_db"],
+                 (double)compression->getProperty("error_raw_lattice")["max_abs_db"]);
+    for (const auto& w : warnings)
+        std::fprintf(stderr, "warning: %s\n", w.toRawUTF8());
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addDefaultCommand({ "",
+                            "<analyzer output dir> --out <dir> [--param-scale N] [--input-step dB]",
+                            "Fit, densify and validate measured curves into a uniform table with an error report",
+                            {},
+                            runCompiler });
+    app.addHelpCommand("--help|-h", "Usage:", false);
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,324 @@
+/*
+ * OmbicLoaderBenchmark: curve data load time, the single-pass loader (memory-mapped file, std::from_chars,
+ * streaming JSON; Emulation/DataLoader.cpp) against the previous juce::String based loader (kept below as the
+ * reference). Both load the same analyzer directory; every cell is compared, so the run also checks parity.
+ *
+ *   OmbicLoaderBenchmark [--rows N] [--data <analyzer output dir>] [--runs N] [--out results.json]
+ *
+ * Without --data, a synthetic directory with an N-row compression_curve.csv (default 200000, the size of a
+ * full studio capture) plus timing / frequency response / THD files is written to the temp folder.
+ * Exits 1 if the two loaders disagree on any row or value.
+ */
+
+#include <JuceHeader.h>
+#include "DataLoader.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+//==============================================================================
+/** The loader as it was before the single-pass parser: whole file into a juce::String, split into lines, a
+ *  juce::String per field and getFloatValue. Rows keep one optional per column, like the old row structs. */
+namespace reference
+{
+    constexpr int kMaxColumns = 8;
+    using Row = std::array<std::optional<float>, kMaxColumns>;
+    using Table = std::vector<Row>;
+
+    std::optional<float> parseOptionalFloat(const juce::String& s)
+    {
+        auto t = s.trim();
+        if (t.isEmpty()) return {};
+        float v = t.getFloatValue();
+        if (std::isnan(v) && t != "nan") return {};
+        return v;
+    }
+
+    std::vector<juce::String> tokenizeCsvLine(const juce::String& line)
+    {
+        std::vector<juce::String> out;
+        juce::String current;
+        bool inQuotes = false;
+        for (int i = 0; i < line.length(); ++i)
+        {
+            juce::juce_wchar c = line[i];
+            if (c == '"') inQuotes = !inQuotes;
+            else if ((c == ',' && !inQuotes) || c == '\r')
+            {
+                out.push_back(current.trim());
+                current = juce::String();
+            }
+            else if (c != '\n')
+                current += c;
+        }
+        if (current.isNotEmpty())
+            out.push_back(current.trim());
+        return out;
+    }
+
+    Table loadCsv(const juce::File& path, const juce::StringArray& columns, const juce::String& flagColumn = {})
+    {
+        Table rows;
+        if (!path.existsAsFile()) return rows;
+        juce::StringArray lines;
+        lines.addLines(path.loadFileAsString());
+        if (lines.size() < 2) return rows;
+        juce::StringArray headers;
+        headers.addTokens(lines[0], ",", "");
+        std::array<int, kMaxColumns> idx;
+        idx.fill(-1);
+        for (int i = 0; i < headers.size(); ++i)
+        {
+            const int c = columns.indexOf(headers[i].toLowerCase().trim());
+            if (c >= 0) idx[(size_t)c] = i;
+        }
+        for (int L = 1; L < lines.size(); ++L)
+        {
+            auto tokens = tokenizeCsvLine(lines[L]);
+            if (tokens.empty()) continue;
+            Row r;
+            for (int c = 0; c < columns.size(); ++c)
+            {
+                const int i = idx[(size_t)c];
+                if (i < 0 || i >= (int)tokens.size()) continue;
+                if (columns[c] == flagColumn)
+                {
+                    const auto ok = tokens[(size_t)i].trim().toLowerCase();
+                    r[(size_t)c] = (ok == "false" || ok == "0") ? 0.0f : 1.0f;
+                }
+                else
+                    r[(size_t)c] = parseOptionalFloat(tokens[(size_t)i]);
+            }
+            rows.push_back(r);
+        }
+        return rows;
+    }
+
+    Table loadThdJson(const juce::File& path)
+    {
+        Table rows;
+        if (!path.existsAsFile()) return rows;
+        juce::var json;
+        if (!juce::JSON::parse(path.loadFileAsString(), json).wasOk() || !json.isArray()) return rows;
+        for (const auto& item : *json.getArray())
+        {
+            auto* obj = item.getDynamicObject();
+            if (obj == nullptr) continue;
+            Row r;
+            if (obj->hasProperty("level_db")) r[0] = (float)obj->getProperty("level_db");
+            if (obj->hasProperty("thd_percent")) r[1] = (float)obj->getProperty("thd_percent");
+            rows.push_back(r);
+        }
+        return rows;
+    }
+
+    /** Same tables, same column order as emulation::loadAnalyzerOutput. */
+    std::array<Table, 4> load(const juce::File& dir)
+    {
+        return { loadCsv(dir.getChildFile("compression_curve.csv"),
+                         { "input_db", "output_db", "gain_reduction_db", "threshold", "ratio", "attack_ms", "release_ms" }),
+                 loadCsv(dir.getChildFile("timing.csv"),
+                         { "attack_param", "release_param", "threshold", "ratio", "attack_time_ms", "release_time_ms", "measurement_ok" },
+                         "measurement_ok"),
+                 loadCsv(dir.getChildFile("frequency_response.csv"), { "frequency_hz", "magnitude_db", "drive_level_db" }),
+                 loadThdJson(dir.getChildFile("thd_vs_level.json")) };
+    }
+} // namespace reference
+
+//==============================================================================
+/** Synthetic analyzer output shaped like fetish_v2 (threshold x ratio x input grid), with compressionRows rows. */
+juce::File writeSyntheticData(int compressionRows)
+{
+    auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("ombic_loader_benchmark");
+    dir.createDirectory();
+    char line[256];
+
+    std::string csv = "input_db,output_db,gain_reduction_db,threshold,ratio,knee,attack_ms,release_ms\n";
+    csv.reserve(static_cast<size_t>(compressionRows) * 64);
+    for (int i = 0; i < compressionRows; ++i)
+    {
+        const float inputDb = -60.0f + 2.5f * static_cast<float>(i % 25);
+        const float threshold = -30.0f + 1.5f * static_cast<float>((i / 25) % 20);
+        const float ratio = 4.0f + static_cast<float>((i / 500) % 17);
+        const float gr = inputDb > threshold ? (inputDb - threshold) * (1.0f - 1.0f / ratio) : 0.0f;
+        std::snprintf(line, sizeof(line), "%.4f,%.4f,%.4f,%.2f,%.1f,,0.5,400\n", inputDb, inputDb - gr, gr, threshold, ratio);
+        csv += line;
+    }
+    dir.getChildFile("compression_curve.csv").replaceWithData(csv.data(), csv.size());
+
+    std::string timing = "attack_param,release_param,threshold,ratio,attack_time_ms,release_time_ms,measurement_ok\n";
+    for (int a = 0; a < 20; ++a)
+        for (int r = 0; r < 20; ++r)
+        {
+            std::snprintf(line, sizeof(line), "%d,%d,-20,4,%.3f,%.3f,%s\n", 20 + 40 * a, 50 + 55 * r,
+                          0.02 + 0.04 * a, 50.0 + 55.0 * r, (a + r) % 7 == 0 ? "False" : "True");
+            timing += line;
+        }
+    dir.getChildFile("timing.csv").replaceWithData(timing.data(), timing.size());
+
+    std::string fr = "frequency_hz,magnitude_db,phase_deg,drive_level_db\n";
+    for (int d = 0; d < 4; ++d)
+        for (int i = 0; i < 500; ++i)
+        {
+            std::snprintf(line, sizeof(line), "%.3f,%.4f,0.0,%d\n", 20.0 * std::pow(1000.0, i / 499.0),
+                          -0.5 * std::sin(i * 0.01), -20 + 6 * d);
+            fr += line;
+        }
+    dir.getChildFile("frequency_response.csv").replaceWithData(fr.data(), fr.size());
+
+    std::string thd = "[\n";
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::snprintf(line, sizeof(line),
+                      "%s  {\n    \"level_db\": %.2f,\n    \"thd_percent\": %.4f,\n    \"harmonics\": { \"H2\": -120.5, \"H3\": -110.25 }\n  }",
+                      i == 0 ? "" : ",\n", -40.0 + 0.02 * i, 0.03 + 0.0001 * i);
+        thd += line;
+    }
+    thd += "\n]\n";
+    dir.getChildFile("thd_vs_level.json").replaceWithData(thd.data(), thd.size());
+    return dir;
+}
+
+juce::int64 directoryBytes(const juce::File& dir)
+{
+    juce::int64 bytes = 0;
+    for (const char* name : { "compression_curve.csv", "timing.csv", "frequency_response.csv", "thd_vs_level.json" })
+        bytes += dir.getChildFile(name).getSize();
+    return bytes;
+}
+
+struct Timing
+{
+    double minMs = 0.0;
+    double medianMs = 0.0;
+};
+
+Timing timeRuns(int runs, const std::function<void()>& load)
+{
+    std::vector<double> ms;
+    for (int r = 0; r <= runs; ++r)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        load();
+        const auto t1 = std::chrono::steady_clock::now();
+        if (r > 0)   // first pass warms the file cache
+            ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    std::sort(ms.begin(), ms.end());
+    return { ms.front(), ms[ms.size() / 2] };
+}
+
+/** Cells where the loaders disagree (row counts, presence, or values beyond float parse rounding). */
+int countMismatches(const emulation::AnalyzerOutput& fast, const std::array<reference::Table, 4>& ref)
+{
+    int mismatches = 0;
+    const std::array<const emulation::ColumnTable*, 4> tables { &fast.compression, &fast.timing, &fast.fr, &fast.thd };
+    for (size_t t = 0; t < tables.size(); ++t)
+    {
+        const auto& table = *tables[t];
+        if (table.numRows != (int)ref[t].size())
+        {
+            std::fprintf(stderr, "table %zu: %d rows vs %zu in the reference\n", t, table.numRows, ref[t].size());
+            ++mismatches;
+            continue;
+        }
+        for (int r = 0; r < table.numRows; ++r)
+            for (int c = 0; c < table.numColumns; ++c)
+            {
+                const auto a = table.get(c, r);
+                const auto b = ref[t][(size_t)r][(size_t)c];
+                const bool same = a.has_value() == b.has_value()
+                               && (!a || (std::isnan(*a) && std::isnan(*b))
+                                   || std::abs(*a - *b) <= 1e-6f * juce::jmax(1.0f, std::abs(*b)));
+                if (!same && ++mismatches <= 10)
+                    std::fprintf(stderr, "table %zu row %d column %d: %g vs %g\n", t, r, c,
+                                 a ? (double)*a : -0.0, b ? (double)*b : -0.0);
+            }
+    }
+    return mismatches;
+}
+
+juce::var makeTimingResult(const char* loader, const Timing& t, juce::int64 bytes, int rows)
+{
+    auto* o = new juce::DynamicObject();
+    o->setProperty("loader", loader);
+    o->setProperty("ms", t.minMs);
+    o->setProperty("ms_median", t.medianMs);
+    o->setProperty("mb_per_s", t.minMs > 0.0 ? (double)bytes / (1024.0 * 1024.0) / (t.minMs / 1000.0) : 0.0);
+    o->setProperty("rows", rows);
+    return juce::var(o);
+}
+
+void runLoaderBenchmark(const juce::ArgumentList& args)
+{
+    const int runs = juce::jmax(1, args.containsOption("--runs") ? args.getValueForOption("--runs").getIntValue() : 5);
+    const int rows = juce::jmax(1, args.containsOption("--rows") ? args.getValueForOption("--rows").getIntValue() : 200000);
+    const bool synthetic = !args.containsOption("--data");
+    const auto dir = synthetic ? writeSyntheticData(rows) : args.getExistingFolderForOption("--data");
+    const auto bytes = directoryBytes(dir);
+
+    int totalRows = 0;
+    const auto fastTiming = timeRuns(runs, [&] {
+        const auto data = emulation::loadAnalyzerOutput(dir);
+        totalRows = data.compression.numRows + data.timing.numRows + data.fr.numRows + data.thd.numRows;
+    });
+    const auto referenceTiming = timeRuns(runs, [&] { reference::load(dir); });
+    const int mismatches = countMismatches(emulation::loadAnalyzerOutput(dir), reference::load(dir));
+
+    std::fprintf(stderr, "%s: %.2f MB, %d rows\n", dir.getFullPathName().toRawUTF8(), (double)bytes / (1024.0 * 1024.0), totalRows);
+    std::fprintf(stderr, "single-pass  %9.2f ms (median %.2f)\n", fastTiming.minMs, fastTiming.medianMs);
+    std::fprintf(stderr, "reference    %9.2f ms (median %.2f)\n", referenceTiming.minMs, referenceTiming.medianMs);
+    std::fprintf(stderr, "speed-up     %9.1fx, %d mismatching cells\n",
+                 fastTiming.minMs > 0.0 ? referenceTiming.minMs / fastTiming.minMs : 0.0, mismatches);
+
+    juce::Array<juce::var> results;
+    results.add(makeTimingResult("single_pass", fastTiming, bytes, totalRows));
+    results.add(makeTimingResult("reference", referenceTiming, bytes, totalRows));
+    auto* root = new juce::DynamicObject();
+    root->setProperty("tool", "OmbicLoaderBenchmark");
+    root->setProperty("schema_version", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("data", synthetic ? juce::String("synthetic") : dir.getFullPathName());
+    root->setProperty("bytes", bytes);
+    root->setProperty("runs", runs);
+    root->setProperty("speedup", fastTiming.minMs > 0.0 ? referenceTiming.minMs / fastTiming.minMs : 0.0);
+    root->setProperty("mismatches", mismatches);
+    root->setProperty("results", results);
+    const auto json = juce::JSON::toString(juce::var(root));
+
+    if (args.containsOption("--out"))
+    {
+        const auto outFile = args.getFileForOption("--out");
+        if (!outFile.replaceWithText(json))
+            juce::ConsoleApplication::fail("Could not write " + outFile.getFullPathName());
+    }
+    else
+        std::printf("%s\n", json.toRawUTF8());
+
+    if (synthetic)
+        dir.deleteRecursively();
+    if (mismatches > 0)
+        juce::ConsoleApplication::fail("Loaders disagree on " + juce::String(mismatches) + " cells");
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addDefaultCommand({ "",
+                            "[--rows N] [--data <analyzer output dir>] [--runs N] [--out results.json]",
+                            "Time the curve data loader against the previous one and check they agree",
+                            {},
+                            runLoaderBenchmark });
+    app.addHelpCommand("--help|-h", "Usage:", false);
+    return app.findAndRunCommand(argc, argv);
+}
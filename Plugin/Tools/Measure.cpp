@@ -0,0 +1,892 @@
+/*
+ * OmbicMeasure: native measurement engine. Renders test signals through one of the plugin's chains and writes the
+ * analyzer schema, so curve data can be regenerated from the DSP itself (e.g. after an engine change) and the PWM
+ * engine, which has no captures, gets measured curves for its transfer display.
+ *
+ *   OmbicMeasure --mode=fet|opto|vca|pwm|iron --out=<dir> [--data=<analyzer output dir>] [--threads=N]
+ *                [--sample-rate=48000] [--grid=N] [--speed=0..100] [--iron=0..100] [--voicing=opto|fet|pwm|vca]
+ *                [--character] [--tail-ms=4000] [--only=compression,timing,fr,thd]
+ *
+ * Chains: fet/opto/vca play the --data capture through MVPChain as the plugin builds it (--character adds the FR and
+ * THD character stages), pwm is PwmChain, iron is IronTransformer alone (--iron defaults to 50 %, voiced as FET).
+ * --iron=P adds Iron at P % after any other chain, voiced like the processor does. Neon is off. Every grid point
+ * renders on a fresh chain and the points are spread over a juce::ThreadPool (one thread per core by default), so the
+ * results do not depend on the thread count or the order the points run in.
+ *
+ * Signals and extraction (the tone is ~1 kHz with a whole number of samples per cycle, so reads do not leak):
+ *  - compression_curve.csv: the tone stepped up through the input levels (-60..0 dB RMS in 2.5 dB steps), one curve
+ *    per (threshold, ratio); each 300 ms step settles, then output RMS is read over its last 100 ms.
+ *  - timing.csv: per (attack, release) knob pair, a burst from 20 dB below the step level up to it and back down.
+ *    Attack and release are the time to 63 % of the gain-reduction change (one time constant), from the gain of every
+ *    tone cycle; measurement_ok is False when the change is under 1 dB, is not reached, or the tail does not settle.
+ *  - frequency_response.csv: stepped sine sweep, 30 log-spaced frequencies 20 Hz..20 kHz at drive levels -18, -12,
+ *    -6, 0 and +3 dB; magnitude_db is the gain of the fundamental (quadrature demodulation over whole cycles).
+ *  - thd_vs_level.json: the tone at 13 levels -40..0 dB; harmonics H2..H10 in dB RMS (like level_db) and THD in %.
+ * Grids: fet/opto/vca reuse the capture's threshold and ratio axes and its timing knob grid (--grid=N resamples each
+ * axis to N points over the same range); pwm has N thresholds over the knob (0..100 %, the units its transfer display
+ * reads) x N ratios 1.5..8 at --speed (default 50), and N x N attack 0.5..80 ms x release 30..800 ms (N default 20).
+ * Opto, VCA and Iron have no attack/release controls, so no timing.csv. FR, THD and timing run at one reference
+ * setting per engine, recorded in manifest.json.
+ *
+ * manifest.json declares the mode, so fet/opto/vca output is a curve profile like any capture, and a pwm capture in a
+ * profile folder draws the PWM transfer curve. validation_report.json has the analyzer's checks. Exits 1 on bad
+ * arguments or a capture without curves.
+ */
+
+#include <JuceHeader.h>
+#include "DataLoader.h"
+#include "CurveLattice.h"
+#include "MeasuredCompressor.h"
+#include "MVPChain.h"
+#include "PwmChain.h"
+#include "PwmCompressor.h"
+#include "IronTransformer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+enum class Engine { FET, Opto, VCA, PWM, Iron };
+
+const char* const kEngineNames[] = { "fet", "opto", "vca", "pwm", "iron" };   // by Engine, as --mode and manifest "mode"
+
+bool isMvpEngine(Engine e) { return e == Engine::FET || e == Engine::Opto || e == Engine::VCA; }
+
+/** The processor's compressor_mode index (Opto 0, FET 1, PWM 2, VCA 3), which IronTransformer is voiced by. */
+int processorModeIndex(Engine e)
+{
+    switch (e)
+    {
+        case Engine::Opto: return 0;
+        case Engine::PWM:  return 2;
+        case Engine::VCA:  return 3;
+        default:           return 1;
+    }
+}
+
+constexpr int kBlockSize = 512;             // as the processor renders
+constexpr double kToneHz = 1000.0;
+constexpr double kStepMs = 300.0;           // compression: one input level
+constexpr double kSettleMs = 500.0;         // FR / THD: before the read
+constexpr double kWindowMs = 100.0;         // read window
+constexpr double kBurstPreMs = 500.0, kBurstHoldMs = 1000.0;
+constexpr double kAverageMs = 50.0;         // settled gain reduction before each burst edge
+constexpr float kBurstGapDb = 20.0f;
+constexpr float kMinTimingChangeDb = 1.0f;
+constexpr float kTailSettledDb = 0.5f;
+constexpr float kThdReferenceLevelDb = -4.0f;   // THDCharacter's reference level
+const float kFrDriveLevelsDb[] = { -18.0f, -12.0f, -6.0f, 0.0f, 3.0f };
+constexpr int kNumFrFrequencies = 30;
+constexpr int kNumThdLevels = 13;
+constexpr int kNumHarmonics = 10;
+constexpr int kDefaultGrid = 20;
+
+struct Options
+{
+    Engine engine = Engine::FET;
+    juce::File source, out;
+    double sampleRate = 48000.0;
+    int threads = 0;
+    int grid = 0;                 // 0 = the capture's own axes (pwm: kDefaultGrid)
+    float speed = 50.0f;          // pwm
+    float ironPercent = 0.0f;
+    int ironVoicing = -1;         // processor mode index; -1 = follow the engine
+    bool character = false;
+    double tailMs = 4000.0;
+    juce::StringArray only;       // empty = everything
+
+    bool wants(const char* measurement) const { return only.isEmpty() || only.contains(measurement); }
+};
+
+/** What the chain is set to for a render: the arguments the processor would pass for the engine. */
+struct ChainSetting
+{
+    float threshold = 0.0f;   // FET dB, Opto 0..100, VCA reference units, PWM knob %
+    std::optional<float> ratio, attackParam, releaseParam;   // PWM: attack / release in ms
+};
+
+/** Axes of one measurement run and the setting FR, THD and timing use. */
+struct Plan
+{
+    std::vector<float> thresholds{ 0.0f }, ratios{ 0.0f };
+    bool hasThreshold = false, hasRatio = false;   // false: the column stays empty (the axis is not measured)
+    std::vector<float> inputsDb;
+    ChainSetting curveSetting;                     // attack / release while the compression curves step
+    std::optional<float> curveAttackMs, curveReleaseMs;   // attack_ms / release_ms columns (PWM)
+    std::vector<float> attackParams, releaseParams;       // empty: no timing
+    ChainSetting reference;
+    float timingStepDb = 0.0f;
+};
+
+std::vector<float> linspace(float lo, float hi, int n)
+{
+    std::vector<float> v(static_cast<size_t>(juce::jmax(1, n)), lo);
+    for (int i = 1; i < n; ++i)
+        v[static_cast<size_t>(i)] = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(n - 1);
+    return v;
+}
+
+/** The axis as measured, or n points evenly over its range when n > 0. */
+std::vector<float> regrid(const std::vector<float>& axis, int n)
+{
+    if (n <= 0 || axis.size() < 2)
+        return axis;
+    return linspace(axis.front(), axis.back(), n);
+}
+
+std::string formatValue(float v)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", (double)v);
+    return buf;
+}
+
+std::string formatOptional(std::optional<float> v)
+{
+    return v.has_value() ? formatValue(*v) : std::string();
+}
+
+double roundTo(double v, int decimals)
+{
+    const double scale = std::pow(10.0, decimals);
+    return std::round(v * scale) / scale;
+}
+
+void logLine(const juce::String& text)
+{
+    std::fprintf(stderr, "%s\n", text.toRawUTF8());
+}
+
+//==============================================================================
+/** One instance of the chain under test, from a clean state. MVP chains share the capture's tables (and, with
+ *  --character, its loaded data set), so this is cheap. */
+class Device
+{
+public:
+    Device(const Options& opt, const std::shared_ptr<const emulation::MeasuredCompressor::Tables>& tables,
+           const emulation::AnalyzerOutput& data)
+    {
+        using Mode = emulation::MVPChain::Mode;
+        if (isMvpEngine(opt.engine))
+        {
+            const auto mode = opt.engine == Engine::FET ? Mode::FET : (opt.engine == Engine::Opto ? Mode::Opto : Mode::VCA);
+            mvp_ = std::make_unique<emulation::MVPChain>(mode, opt.sampleRate, tables);
+            if (opt.character)
+                mvp_->addCharacter(data, true, true);
+            mvp_->prepare(kBlockSize, 1);
+        }
+        else if (opt.engine == Engine::PWM)
+        {
+            pwm_ = std::make_unique<emulation::PwmChain>(opt.sampleRate, false);
+            pwm_->prepare(opt.sampleRate, kBlockSize);
+        }
+        if (opt.ironPercent > 0.0f)
+        {
+            iron_ = std::make_unique<emulation::IronTransformer>();
+            iron_->prepare(opt.sampleRate);
+            ironAmount_ = juce::jlimit(0.0f, 1.0f, opt.ironPercent / 100.0f);
+            ironVoicing_ = opt.ironVoicing >= 0 ? opt.ironVoicing : processorModeIndex(opt.engine);
+        }
+    }
+
+    /** Input through the chain in processor-sized blocks (mono). */
+    std::vector<float> render(const ChainSetting& s, const std::vector<float>& input)
+    {
+        std::vector<float> output(input.size());
+        juce::AudioBuffer<float> buffer(1, kBlockSize);
+        for (size_t pos = 0; pos < input.size(); pos += kBlockSize)
+        {
+            const int n = static_cast<int>(std::min(input.size() - pos, static_cast<size_t>(kBlockSize)));
+            buffer.setSize(1, n, false, false, true);
+            buffer.copyFrom(0, 0, input.data() + pos, n);
+            if (mvp_ != nullptr)
+                mvp_->process(buffer, s.threshold, s.ratio, s.attackParam, s.releaseParam, kBlockSize, false);
+            else if (pwm_ != nullptr)
+                pwm_->process(buffer, s.threshold, s.ratio.value_or(4.0f), s.attackParam.value_or(10.0f),
+                              s.releaseParam.value_or(100.0f), nullptr);
+            if (iron_ != nullptr)
+                iron_->process(buffer, ironVoicing_, ironAmount_);
+            std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + n, output.begin() + (std::ptrdiff_t)pos);
+        }
+        return output;
+    }
+
+private:
+    std::unique_ptr<emulation::MVPChain> mvp_;
+    std::unique_ptr<emulation::PwmChain> pwm_;
+    std::unique_ptr<emulation::IronTransformer> iron_;
+    float ironAmount_ = 0.0f;
+    int ironVoicing_ = 1;
+};
+
+//==============================================================================
+/** The ~1 kHz test tone: a whole number of samples per cycle, so per-cycle and whole-window reads do not leak. */
+struct Tone
+{
+    explicit Tone(double rate)
+        : sampleRate(rate), period(juce::jmax(2, juce::roundToInt(rate / kToneHz))), hz(rate / period)
+    {
+    }
+
+    /** ms rounded to whole cycles, in samples. */
+    int samples(double ms) const { return juce::jmax(1, juce::roundToInt(ms * 0.001 * hz)) * period; }
+    double cycleMs() const { return 1000.0 / hz; }
+
+    double sampleRate;
+    int period;
+    double hz;
+};
+
+struct Segment
+{
+    float levelDb;   // RMS
+    int numSamples;
+};
+
+/** A sine whose RMS level steps through the segments; the phase runs on across steps. */
+std::vector<float> steppedTone(double freqHz, double sampleRate, const std::vector<Segment>& segments)
+{
+    size_t total = 0;
+    for (const auto& seg : segments)
+        total += static_cast<size_t>(seg.numSamples);
+    std::vector<float> x;
+    x.reserve(total);
+    const double w = juce::MathConstants<double>::twoPi * freqHz / sampleRate;
+    size_t i = 0;
+    for (const auto& seg : segments)
+    {
+        const double amplitude = juce::MathConstants<double>::sqrt2 * std::pow(10.0, seg.levelDb / 20.0);
+        for (int k = 0; k < seg.numSamples; ++k, ++i)
+            x.push_back(static_cast<float>(amplitude * std::sin(w * static_cast<double>(i))));
+    }
+    return x;
+}
+
+double rmsDb(const float* x, int n)
+{
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+        sum += (double)x[i] * x[i];
+    return 10.0 * std::log10(juce::jmax(sum / juce::jmax(1, n), 1.0e-20));
+}
+
+/** Peak amplitude of the component at freqHz over n samples (exact over whole cycles). */
+double componentAmplitude(const float* x, int n, double freqHz, double sampleRate)
+{
+    const double w = juce::MathConstants<double>::twoPi * freqHz / sampleRate;
+    double re = 0.0, im = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        re += x[i] * std::cos(w * i);
+        im += x[i] * std::sin(w * i);
+    }
+    return 2.0 * std::sqrt(re * re + im * im) / juce::jmax(1, n);
+}
+
+//==============================================================================
+/** Output level (dB RMS) at each input level, stepping up through the levels on one chain. */
+std::vector<float> measureCurve(Device& device, const ChainSetting& s, const std::vector<float>& inputsDb, const Tone& tone)
+{
+    const int step = tone.samples(kStepMs), window = tone.samples(kWindowMs);
+    std::vector<Segment> segments;
+    for (float level : inputsDb)
+        segments.push_back({ level, step });
+    const auto input = steppedTone(tone.hz, tone.sampleRate, segments);
+    const auto output = device.render(s, input);
+
+    std::vector<float> outputDb;
+    for (size_t k = 0; k < inputsDb.size(); ++k)
+        outputDb.push_back(static_cast<float>(rmsDb(output.data() + (k + 1) * (size_t)step - (size_t)window, window)));
+    return outputDb;
+}
+
+struct TimingResult
+{
+    std::optional<float> attackMs, releaseMs;
+};
+
+/** Gain reduction (dB) of each tone cycle: input over output RMS. */
+std::vector<float> cycleGainReduction(const std::vector<float>& input, const std::vector<float>& output, int period)
+{
+    std::vector<float> gr(input.size() / (size_t)period);
+    for (size_t c = 0; c < gr.size(); ++c)
+        gr[c] = static_cast<float>(rmsDb(input.data() + c * (size_t)period, period) - rmsDb(output.data() + c * (size_t)period, period));
+    return gr;
+}
+
+float meanOf(const std::vector<float>& v, size_t begin, size_t end)
+{
+    double sum = 0.0;
+    for (size_t i = begin; i < end; ++i)
+        sum += v[i];
+    return end > begin ? static_cast<float>(sum / static_cast<double>(end - begin)) : 0.0f;
+}
+
+/** Time from the edge at cycle `edge` until the per-cycle gain reduction has covered 63 % (1 - 1/e) of the way from
+ *  `from` to `to`, interpolated between cycle centres and searched up to cycle `limit`. nullopt if the change is under
+ *  kMinTimingChangeDb or is not reached. */
+std::optional<float> timeConstantMs(const std::vector<float>& gr, size_t edge, size_t limit, float from, float to, double cycleMs)
+{
+    const float change = to - from;
+    if (std::abs(change) < kMinTimingChangeDb)
+        return {};
+    const float target = 1.0f - std::exp(-1.0f);
+    auto progress = [&](size_t c) { return (gr[c] - from) / change; };
+    for (size_t c = edge; c < juce::jmin(limit, gr.size()); ++c)
+    {
+        const float p = progress(c);
+        if (p < target)
+            continue;
+        // Previous point: the last cycle's centre, or the edge itself (no progress yet)
+        const double prevTime = c > edge ? (double)c - 0.5 : (double)edge;
+        const float prevProgress = c > edge ? juce::jmin(progress(c - 1), target) : 0.0f;
+        const double t = prevTime + (double)(target - prevProgress) / juce::jmax(1.0e-6f, p - prevProgress) * ((double)c + 0.5 - prevTime);
+        return static_cast<float>((t - (double)edge) * cycleMs);
+    }
+    return {};
+}
+
+/** Burst below, at and below the step level again; attack and release time constants from per-cycle gain. */
+TimingResult measureTiming(Device& device, const ChainSetting& s, float stepLevelDb, double tailMs, const Tone& tone)
+{
+    const int pre = tone.samples(kBurstPreMs), hold = tone.samples(kBurstHoldMs), tail = tone.samples(tailMs);
+    const float low = stepLevelDb - kBurstGapDb;
+    const auto input = steppedTone(tone.hz, tone.sampleRate, { { low, pre }, { stepLevelDb, hold }, { low, tail } });
+    const auto gr = cycleGainReduction(input, device.render(s, input), tone.period);
+
+    const size_t attackEdge = (size_t)(pre / tone.period), releaseEdge = attackEdge + (size_t)(hold / tone.period);
+    const size_t average = (size_t)(tone.samples(kAverageMs) / tone.period), end = gr.size();
+    const float grBefore = meanOf(gr, attackEdge - average, attackEdge);
+    const float grHeld = meanOf(gr, releaseEdge - average, releaseEdge);
+    const float grAfter = meanOf(gr, end - average, end);
+
+    TimingResult r;
+    r.attackMs = timeConstantMs(gr, attackEdge, releaseEdge, grBefore, grHeld, tone.cycleMs());
+    if (std::abs(grAfter - grBefore) <= kTailSettledDb)   // otherwise the tail is too short to know where release ends
+        r.releaseMs = timeConstantMs(gr, releaseEdge, end, grHeld, grAfter, tone.cycleMs());
+    return r;
+}
+
+/** Gain (dB) of the fundamental at freqHz and the given drive level, after settling. */
+float measureFrequency(Device& device, const ChainSetting& s, double freqHz, float driveDb, const Tone& tone)
+{
+    const int settle = tone.samples(kSettleMs);
+    const int cycles = juce::jmax(1, (int)std::ceil(kWindowMs * 0.001 * freqHz));
+    const int window = juce::jmax(1, juce::roundToInt(cycles * tone.sampleRate / freqHz));
+    const auto input = steppedTone(freqHz, tone.sampleRate, { { driveDb, settle + window } });
+    const auto output = device.render(s, input);
+    const double in = componentAmplitude(input.data() + settle, window, freqHz, tone.sampleRate);
+    const double out = componentAmplitude(output.data() + settle, window, freqHz, tone.sampleRate);
+    return static_cast<float>(20.0 * std::log10(juce::jmax(out, 1.0e-12) / juce::jmax(in, 1.0e-12)));
+}
+
+struct ThdResult
+{
+    float thdPercent = 0.0f;
+    std::vector<float> harmonicsDb;   // H2.. (dB RMS); only harmonics below Nyquist
+};
+
+ThdResult measureThd(Device& device, const ChainSetting& s, float levelDb, const Tone& tone)
+{
+    const int settle = tone.samples(kSettleMs), window = tone.samples(kWindowMs);
+    const auto input = steppedTone(tone.hz, tone.sampleRate, { { levelDb, settle + window } });
+    const auto output = device.render(s, input);
+
+    ThdResult r;
+    const double fundamental = componentAmplitude(output.data() + settle, window, tone.hz, tone.sampleRate);
+    double harmonicPower = 0.0;
+    for (int k = 2; k <= kNumHarmonics && k * tone.hz < 0.5 * tone.sampleRate; ++k)
+    {
+        const double a = componentAmplitude(output.data() + settle, window, k * tone.hz, tone.sampleRate);
+        harmonicPower += a * a;
+        r.harmonicsDb.push_back(static_cast<float>(20.0 * std::log10(juce::jmax(a / juce::MathConstants<double>::sqrt2, 1.0e-12))));
+    }
+    r.thdPercent = fundamental > 0.0 ? static_cast<float>(100.0 * std::sqrt(harmonicPower) / fundamental) : 0.0f;
+    return r;
+}
+
+//==============================================================================
+/** Every job once on numThreads pool threads, logging progress. */
+void runParallel(const std::vector<std::function<void()>>& jobs, int numThreads)
+{
+    const int total = static_cast<int>(jobs.size());
+    std::atomic<int> remaining{ total };
+    juce::ThreadPool pool(numThreads);
+    for (const auto& job : jobs)
+    {
+        pool.addJob([&job, &remaining] {
+            job();
+            --remaining;
+            return juce::ThreadPoolJob::jobHasFinished;
+        });
+    }
+    int reported = 0;
+    while (remaining.load() > 0)
+    {
+        juce::Thread::sleep(20);
+        const int tenths = (total - remaining.load()) * 10 / juce::jmax(1, total);
+        if (tenths > reported && tenths < 10)
+            logLine(juce::String(tenths * 10) + " %");
+        reported = juce::jmax(reported, tenths);
+    }
+}
+
+//==============================================================================
+bool columnPresent(const emulation::ColumnTable& table, int column)
+{
+    for (int r = 0; r < table.numRows; ++r)
+        if (table.has(column, r))
+            return true;
+    return false;
+}
+
+std::vector<float> distinctValues(const emulation::ColumnTable& table, int column)
+{
+    std::set<float> values;
+    for (int r = 0; r < table.numRows; ++r)
+        if (table.has(column, r))
+            values.insert(table.column(column)[r]);
+    return { values.begin(), values.end() };
+}
+
+/** fet / opto / vca: the capture's own axes and timing knob grid, and the setting its timing rows were taken at. */
+Plan planFromCapture(const Options& opt, const emulation::AnalyzerOutput& data,
+                     const emulation::MeasuredCompressor::Tables& tables, const juce::var& manifest)
+{
+    using emulation::CurveLattice;
+    namespace Cmp = emulation::CompressionColumn;
+    namespace Tim = emulation::TimingColumn;
+    Plan plan;
+    plan.hasThreshold = columnPresent(data.compression, Cmp::Threshold);
+    plan.hasRatio = opt.engine != Engine::Opto && columnPresent(data.compression, Cmp::Ratio);
+    if (plan.hasThreshold)
+        plan.thresholds = regrid(tables.curves.getAxisValues(CurveLattice::Threshold), opt.grid);
+    if (plan.hasRatio)
+        plan.ratios = regrid(tables.curves.getAxisValues(CurveLattice::Ratio), opt.grid);
+    plan.inputsDb = linspace(-60.0f, 0.0f, 25);
+    plan.timingStepDb = static_cast<float>((double)manifest.getProperty("timing_step_level_db", 0.0));
+
+    if (opt.engine == Engine::FET)
+    {
+        plan.attackParams = regrid(distinctValues(data.timing, Tim::AttackParam), opt.grid);
+        plan.releaseParams = regrid(distinctValues(data.timing, Tim::ReleaseParam), opt.grid);
+        const int n = opt.grid > 0 ? opt.grid : kDefaultGrid;
+        if (plan.attackParams.size() < 2 || plan.releaseParams.size() < 2)
+        {
+            plan.attackParams = linspace(20.0f, 800.0f, n);     // FET knob ranges of the standard grid
+            plan.releaseParams = linspace(50.0f, 1100.0f, n);
+        }
+        plan.reference.threshold = -18.0f;
+        plan.reference.ratio = 4.0f;
+        for (int r = 0; r < data.timing.numRows; ++r)
+            if (data.timing.has(Tim::Threshold, r))
+            {
+                plan.reference.threshold = data.timing.column(Tim::Threshold)[r];
+                if (const auto ratio = data.timing.get(Tim::Ratio, r))
+                    plan.reference.ratio = *ratio;
+                break;
+            }
+        // Fastest knobs: each step settles soonest
+        plan.reference.attackParam = plan.curveSetting.attackParam = plan.attackParams.front();
+        plan.reference.releaseParam = plan.curveSetting.releaseParam = plan.releaseParams.front();
+    }
+    else if (opt.engine == Engine::Opto)
+        plan.reference.threshold = 50.0f;   // mid knob
+    else
+    {
+        plan.reference.threshold = 1.0f;    // mid knob (-1..3)
+        plan.reference.ratio = 4.0f;
+    }
+    return plan;
+}
+
+/** pwm: the knob's threshold range (the transfer display's units) x ratios, and the attack / release ranges. */
+Plan planForPwm(const Options& opt)
+{
+    const int n = opt.grid > 0 ? opt.grid : kDefaultGrid;
+    Plan plan;
+    plan.hasThreshold = plan.hasRatio = true;
+    plan.thresholds = linspace(0.0f, 100.0f, n);
+    plan.ratios = linspace(1.5f, 8.0f, n);
+    plan.inputsDb = linspace(-60.0f, 0.0f, 25);
+    const auto [attackMs, releaseMs] = emulation::PwmCompressor::speedToTimesMs(opt.speed);
+    plan.curveSetting.attackParam = plan.curveAttackMs = attackMs;
+    plan.curveSetting.releaseParam = plan.curveReleaseMs = releaseMs;
+    plan.attackParams = linspace(0.5f, 80.0f, n);
+    plan.releaseParams = linspace(30.0f, 800.0f, n);
+    plan.reference = { 70.0f, 4.0f, attackMs, releaseMs };   // 70 % = -18 dB, the FET timing reference
+    return plan;
+}
+
+Plan planForIron()
+{
+    Plan plan;
+    plan.inputsDb = linspace(-60.0f, 0.0f, 25);
+    return plan;
+}
+
+juce::var settingToVar(const ChainSetting& s)
+{
+    auto* o = new juce::DynamicObject();
+    o->setProperty("threshold", s.threshold);
+    if (s.ratio) o->setProperty("ratio", *s.ratio);
+    if (s.attackParam) o->setProperty("attack_param", *s.attackParam);
+    if (s.releaseParam) o->setProperty("release_param", *s.releaseParam);
+    return juce::var(o);
+}
+
+juce::var check(const juce::String& name, bool pass, const juce::String& message)
+{
+    auto* o = new juce::DynamicObject();
+    o->setProperty("check_name", name);
+    o->setProperty("status", pass ? "pass" : "warn");
+    o->setProperty("message", message);
+    return juce::var(o);
+}
+
+/** Ends the run after a failed write. Profile discovery picks up any folder holding a compression_curve.csv, so that
+ *  file is removed too and a half-written capture never shows up as a profile. */
+void failWrite(const juce::File& outDir, const juce::File& file)
+{
+    outDir.getChildFile("compression_curve.csv").deleteFile();
+    juce::ConsoleApplication::fail("Could not write " + file.getFullPathName());
+}
+
+void writeOutput(const juce::File& outDir, const juce::String& name, const void* data, size_t size)
+{
+    const auto file = outDir.getChildFile(name);
+    if (!file.replaceWithData(data, size))
+        failWrite(outDir, file);
+}
+
+void writeOutput(const juce::File& outDir, const juce::String& name, const juce::String& text)
+{
+    const auto file = outDir.getChildFile(name);
+    if (!file.replaceWithText(text))
+        failWrite(outDir, file);
+}
+
+juce::var range(const std::vector<float>& axis)
+{
+    return juce::Array<juce::var>{ axis.front(), axis.back() };
+}
+
+//==============================================================================
+Options parseOptions(const juce::ArgumentList& args)
+{
+    Options opt;
+    const auto mode = args.getValueForOption("--mode").toLowerCase();
+    const auto* name = std::find_if(std::begin(kEngineNames), std::end(kEngineNames), [&](const char* n) { return mode == n; });
+    if (name == std::end(kEngineNames))
+        juce::ConsoleApplication::fail("--mode must be one of fet, opto, vca, pwm, iron");
+    opt.engine = static_cast<Engine>(name - std::begin(kEngineNames));
+
+    if (!args.containsOption("--out"))
+        juce::ConsoleApplication::fail("Missing --out=<dir>");
+    opt.out = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+    if (isMvpEngine(opt.engine))
+    {
+        if (!args.containsOption("--data"))
+            juce::ConsoleApplication::fail("--mode=" + mode + " measures a capture: --data=<analyzer output dir>");
+        opt.source = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--data"));
+        if (!opt.source.isDirectory())
+            juce::ConsoleApplication::fail("No such directory: " + opt.source.getFullPathName());
+        if (opt.out == opt.source)
+            juce::ConsoleApplication::fail("--out must differ from the --data directory");
+    }
+    if (!opt.out.createDirectory())
+        juce::ConsoleApplication::fail("Could not create " + opt.out.getFullPathName());
+
+    if (args.containsOption("--sample-rate"))
+        opt.sampleRate = juce::jlimit(8000.0, 384000.0, args.getValueForOption("--sample-rate").getDoubleValue());
+    opt.threads = args.containsOption("--threads") ? args.getValueForOption("--threads").getIntValue()
+                                                   : juce::SystemStats::getNumCpus();
+    if (args.containsOption("--grid"))
+        opt.grid = juce::jlimit(2, 200, args.getValueForOption("--grid").getIntValue());
+    if (args.containsOption("--speed"))
+        opt.speed = juce::jlimit(0.0f, 100.0f, args.getValueForOption("--speed").getFloatValue());
+    opt.ironPercent = args.containsOption("--iron") ? juce::jlimit(0.0f, 100.0f, args.getValueForOption("--iron").getFloatValue())
+                                                    : (opt.engine == Engine::Iron ? 50.0f : 0.0f);
+    if (opt.engine == Engine::Iron && opt.ironPercent <= 0.0f)
+        juce::ConsoleApplication::fail("--mode=iron needs --iron above 0");
+    if (args.containsOption("--voicing"))
+    {
+        const auto voicing = args.getValueForOption("--voicing").toLowerCase();
+        const juce::StringArray voicings{ "opto", "fet", "pwm", "vca" };   // processor mode index order
+        opt.ironVoicing = voicings.indexOf(voicing);
+        if (opt.ironVoicing < 0)
+            juce::ConsoleApplication::fail("--voicing must be one of opto, fet, pwm, vca");
+    }
+    else if (opt.engine == Engine::Iron)
+        opt.ironVoicing = processorModeIndex(Engine::FET);
+    opt.character = args.containsOption("--character");
+    if (args.containsOption("--tail-ms"))
+        opt.tailMs = juce::jlimit(500.0, 60000.0, args.getValueForOption("--tail-ms").getDoubleValue());
+    if (args.containsOption("--only"))
+        opt.only = juce::StringArray::fromTokens(args.getValueForOption("--only").toLowerCase(), ",", {});
+    return opt;
+}
+
+void runMeasure(const juce::ArgumentList& args)
+{
+    const Options opt = parseOptions(args);
+    const auto t0 = juce::Time::getMillisecondCounterHiRes();
+
+    std::shared_ptr<const emulation::MeasuredCompressor::Tables> tables;
+    emulation::AnalyzerOutput data;   // parsed once; every job's chain reads it
+    juce::var sourceManifest;
+    Plan plan;
+    if (isMvpEngine(opt.engine))
+    {
+        data = emulation::loadAnalyzerOutput(opt.source);
+        if (data.compression.isEmpty())
+            juce::ConsoleApplication::fail("No compression curves in " + opt.source.getFullPathName());
+        tables = std::make_shared<const emulation::MeasuredCompressor::Tables>(data);
+        sourceManifest = juce::JSON::parse(opt.source.getChildFile("manifest.json"));
+        plan = planFromCapture(opt, data, *tables, sourceManifest);
+    }
+    else
+        plan = opt.engine == Engine::PWM ? planForPwm(opt) : planForIron();
+
+    const Tone tone(opt.sampleRate);
+    const bool wantTiming = opt.wants("timing") && !plan.attackParams.empty();
+    std::vector<float> frequencies;
+    for (int i = 0; i < kNumFrFrequencies; ++i)
+    {
+        const double f = 20.0 * std::pow(1000.0, (double)i / (kNumFrFrequencies - 1));
+        if (f < 0.45 * opt.sampleRate)
+            frequencies.push_back(static_cast<float>(f));
+    }
+    const auto thdLevels = linspace(-40.0f, 0.0f, kNumThdLevels);
+
+    // Result slots, one per grid point; each job writes only its own
+    std::vector<std::vector<float>> curves;
+    std::vector<TimingResult> timings;
+    std::vector<float> frMagnitudes;
+    std::vector<ThdResult> thds;
+    std::vector<std::function<void()>> jobs;
+    auto device = [&opt, &tables, &data] { return Device(opt, tables, data); };
+
+    if (opt.wants("compression"))
+    {
+        curves.resize(plan.thresholds.size() * plan.ratios.size());
+        for (size_t t = 0; t < plan.thresholds.size(); ++t)
+            for (size_t r = 0; r < plan.ratios.size(); ++r)
+            {
+                ChainSetting s = plan.curveSetting;
+                s.threshold = plan.thresholds[t];
+                if (plan.hasRatio)
+                    s.ratio = plan.ratios[r];
+                jobs.push_back([&, s, i = t * plan.ratios.size() + r] {
+                    auto d = device();
+                    curves[i] = measureCurve(d, s, plan.inputsDb, tone);
+                });
+            }
+    }
+    if (wantTiming)
+    {
+        timings.resize(plan.attackParams.size() * plan.releaseParams.size());
+        for (size_t a = 0; a < plan.attackParams.size(); ++a)
+            for (size_t r = 0; r < plan.releaseParams.size(); ++r)
+            {
+                ChainSetting s = plan.reference;
+                s.attackParam = plan.attackParams[a];
+                s.releaseParam = plan.releaseParams[r];
+                jobs.push_back([&, s, i = a * plan.releaseParams.size() + r] {
+                    auto d = device();
+                    timings[i] = measureTiming(d, s, plan.timingStepDb, opt.tailMs, tone);
+                });
+            }
+    }
+    if (opt.wants("fr"))
+    {
+        frMagnitudes.resize(std::size(kFrDriveLevelsDb) * frequencies.size());
+        for (size_t k = 0; k < std::size(kFrDriveLevelsDb); ++k)
+            for (size_t f = 0; f < frequencies.size(); ++f)
+                jobs.push_back([&, k, f] {
+                    auto d = device();
+                    frMagnitudes[k * frequencies.size() + f] = measureFrequency(d, plan.reference, frequencies[f], kFrDriveLevelsDb[k], tone);
+                });
+    }
+    if (opt.wants("thd"))
+    {
+        thds.resize(thdLevels.size());
+        for (size_t l = 0; l < thdLevels.size(); ++l)
+            jobs.push_back([&, l] {
+                auto d = device();
+                thds[l] = measureThd(d, plan.reference, thdLevels[l], tone);
+            });
+    }
+    if (jobs.empty())
+        juce::ConsoleApplication::fail("Nothing to measure (--only=compression,timing,fr,thd)");
+
+    const int numThreads = juce::jlimit(1, static_cast<int>(jobs.size()), opt.threads > 0 ? opt.threads : juce::SystemStats::getNumCpus());
+    logLine(juce::String("Measuring ") + kEngineNames[(int)opt.engine] + ": " + juce::String(curves.size()) + " curves, "
+            + juce::String(timings.size()) + " bursts, " + juce::String(frMagnitudes.size()) + " FR points, "
+            + juce::String(thds.size()) + " THD levels on " + juce::String(numThreads) + " thread(s)");
+    runParallel(jobs, numThreads);
+
+    juce::Array<juce::var> report;
+    bool finite = true;
+
+    // compression_curve.csv
+    if (!curves.empty())
+    {
+        std::string csv = "input_db,output_db,gain_reduction_db,threshold,ratio,knee,attack_ms,release_ms\n";
+        int falling = 0;
+        for (size_t c = 0; c < curves.size(); ++c)
+        {
+            const auto threshold = plan.hasThreshold ? std::optional<float>(plan.thresholds[c / plan.ratios.size()]) : std::nullopt;
+            const auto ratio = plan.hasRatio ? std::optional<float>(plan.ratios[c % plan.ratios.size()]) : std::nullopt;
+            for (size_t k = 0; k < plan.inputsDb.size(); ++k)
+            {
+                const float in = plan.inputsDb[k], out = curves[c][k];
+                finite = finite && std::isfinite(out);
+                csv += formatValue(in) + "," + formatValue(out) + "," + formatValue(in - out) + "," + formatOptional(threshold) + ","
+                     + formatOptional(ratio) + ",," + formatOptional(plan.curveAttackMs) + "," + formatOptional(plan.curveReleaseMs) + "\n";
+            }
+            for (size_t k = 1; k < curves[c].size(); ++k)
+                if (curves[c][k] < curves[c][k - 1] - 0.05f) { ++falling; break; }
+        }
+        writeOutput(opt.out, "compression_curve.csv", csv.data(), csv.size());
+        report.add(check("compression_curve", true, juce::String((int)(curves.size() * plan.inputsDb.size())) + " rows"));
+        report.add(check("compression_monotonic", falling == 0, falling == 0 ? juce::String("Output rises with input on every curve")
+                                                                              : juce::String(falling) + " curves lose output level as the input rises"));
+    }
+
+    // timing.csv
+    if (!timings.empty())
+    {
+        std::string csv = "attack_param,release_param,threshold,ratio,attack_time_ms,release_time_ms,measurement_ok\n";
+        int failed = 0;
+        for (size_t i = 0; i < timings.size(); ++i)
+        {
+            const auto& r = timings[i];
+            const bool ok = r.attackMs.has_value() && r.releaseMs.has_value();
+            failed += ok ? 0 : 1;
+            csv += formatValue(plan.attackParams[i / plan.releaseParams.size()]) + "," + formatValue(plan.releaseParams[i % plan.releaseParams.size()])
+                 + "," + formatValue(plan.reference.threshold) + "," + formatOptional(plan.reference.ratio) + "," + formatOptional(r.attackMs)
+                 + "," + formatOptional(r.releaseMs) + "," + (ok ? "True" : "False") + "\n";
+        }
+        writeOutput(opt.out, "timing.csv", csv.data(), csv.size());
+        if (failed > 0)
+            report.add(check("timing", false, juce::String(failed) + "/" + juce::String((int)timings.size())
+                                                  + " timing rows not resolved (measurement_ok=false)"));
+        else
+            report.add(check("timing", true, juce::String((int)timings.size()) + " rows"));
+    }
+    else
+        report.add(check("timing", true, plan.attackParams.empty() ? "Skipped (no timing)" : "Skipped (not measured)"));
+
+    // frequency_response.csv
+    if (!frMagnitudes.empty())
+    {
+        std::string csv = "frequency_hz,magnitude_db,drive_level_db\n";
+        for (size_t i = 0; i < frMagnitudes.size(); ++i)
+        {
+            finite = finite && std::isfinite(frMagnitudes[i]);
+            csv += formatValue(frequencies[i % frequencies.size()]) + "," + formatValue(frMagnitudes[i]) + ","
+                 + formatValue(kFrDriveLevelsDb[i / frequencies.size()]) + "\n";
+        }
+        writeOutput(opt.out, "frequency_response.csv", csv.data(), csv.size());
+        report.add(check("frequency_response", true, juce::String((int)frMagnitudes.size()) + " rows"));
+    }
+
+    // thd_vs_level.json
+    if (!thds.empty())
+    {
+        juce::Array<juce::var> levels;
+        for (size_t l = 0; l < thds.size(); ++l)
+        {
+            auto* level = new juce::DynamicObject();
+            level->setProperty("level_db", roundTo(thdLevels[l], 1));
+            level->setProperty("thd_percent", roundTo(thds[l].thdPercent, 4));
+            auto* harmonics = new juce::DynamicObject();
+            for (size_t h = 0; h < thds[l].harmonicsDb.size(); ++h)
+                harmonics->setProperty("H" + juce::String((int)h + 2), roundTo(thds[l].harmonicsDb[h], 2));
+            level->setProperty("harmonics", juce::var(harmonics));
+            levels.add(juce::var(level));
+            finite = finite && std::isfinite(thds[l].thdPercent);
+        }
+        writeOutput(opt.out, "thd_vs_level.json", juce::JSON::toString(levels));
+        report.add(check("thd_vs_level", true, juce::String((int)thds.size()) + " levels"));
+    }
+    if (!finite)
+        report.add(check("finite_values", false, "Non-finite measurements (the chain produced NaN or silence)"));
+    writeOutput(opt.out, "validation_report.json", juce::JSON::toString(report));
+
+    // manifest.json: the analyzer's fields, the mode (so profile discovery files it correctly) and how it was made
+    const double seconds = (juce::Time::getMillisecondCounterHiRes() - t0) / 1000.0;
+    const juce::String modeName = kEngineNames[(int)opt.engine];
+    auto* manifest = new juce::DynamicObject();
+    juce::var manifestVar(manifest);
+    const auto sourceName = sourceManifest.getProperty("name", sourceManifest.getProperty("source", opt.source.getFileName())).toString();
+    manifest->setProperty("name", (isMvpEngine(opt.engine) ? sourceName : modeName.toUpperCase()) + " (measured)");
+    manifest->setProperty("mode", modeName);
+    manifest->setProperty("source", "OmbicMeasure: " + modeName.toUpperCase() + " chain"
+                                        + (opt.ironPercent > 0.0f && opt.engine != Engine::Iron ? " + Iron" : ""));
+    manifest->setProperty("capture", "Stepped tones, bursts and stepped sine sweeps rendered through the plugin DSP");
+    manifest->setProperty("sample_rate", juce::roundToInt(opt.sampleRate));
+    manifest->setProperty("grid_version", "measured_" + juce::String((int)plan.thresholds.size()) + "x" + juce::String((int)plan.ratios.size()));
+    manifest->setProperty("level_definition", "RMS dB of a " + juce::String(tone.hz, 1) + " Hz tone; output RMS over the last "
+                                                  + juce::String((int)kWindowMs) + " ms of each " + juce::String((int)kStepMs) + " ms step");
+    manifest->setProperty("timing_step_level_db", plan.timingStepDb);
+    manifest->setProperty("thd_reference_level_db", kThdReferenceLevelDb);
+    auto* ranges = new juce::DynamicObject();
+    if (plan.hasThreshold)
+        ranges->setProperty("threshold_db", range(plan.thresholds));   // the analyzer's key; engine units (Opto, PWM: 0..100)
+    if (plan.hasRatio)
+        ranges->setProperty("ratio", range(plan.ratios));
+    manifest->setProperty("param_ranges", juce::var(ranges));
+    auto* measured = new juce::DynamicObject();
+    measured->setProperty("tool", "OmbicMeasure");
+    measured->setProperty("schema_version", 1);
+    measured->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    if (isMvpEngine(opt.engine))
+    {
+        measured->setProperty("data", opt.source.getFullPathName());
+        measured->setProperty("character", opt.character);
+    }
+    if (opt.engine == Engine::PWM)
+        measured->setProperty("speed", opt.speed);
+    if (opt.ironPercent > 0.0f)
+    {
+        measured->setProperty("iron_percent", opt.ironPercent);
+        measured->setProperty("iron_voicing", opt.ironVoicing >= 0 ? opt.ironVoicing : processorModeIndex(opt.engine));
+    }
+    measured->setProperty("reference_setting", settingToVar(plan.reference));
+    measured->setProperty("threads", numThreads);
+    measured->setProperty("seconds", roundTo(seconds, 2));
+    manifest->setProperty("measured", juce::var(measured));
+    writeOutput(opt.out, "manifest.json", juce::JSON::toString(manifestVar));
+
+    logLine(juce::String::formatted("Done: %d points in %.1f s -> %s", (int)jobs.size(), seconds, opt.out.getFullPathName().toRawUTF8()));
+    for (const auto& c : report)
+        if (c["status"].toString() != "pass")
+            logLine("warning: " + c["message"].toString());
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addDefaultCommand({ "",
+                            "--mode=fet|opto|vca|pwm|iron --out=<dir> [--data=<analyzer output dir>] [--threads=N] [--sample-rate=Hz] "
+                            "[--grid=N] [--speed=0..100] [--iron=0..100] [--voicing=opto|fet|pwm|vca] [--character] [--tail-ms=ms] "
+                            "[--only=compression,timing,fr,thd]",
+                            "Measure a chain and write curve data in the analyzer schema",
+                            "Renders stepped tones, bursts and stepped sine sweeps through the chain, one fresh chain per grid point, on every core.",
+                            runMeasure });
+    app.addHelpCommand("--help|-h", "Usage:", false);
+    return app.findAndRunCommand(argc, argv);
+}